@@ -0,0 +1,269 @@
+/*************************************************************************
+                           Awale -- AI
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Déclarations des moteurs de recherche Awalé
+                           construits sur le plateau compact de game/ :
+                           - table de transposition partagée
+                           - négamax alpha-bêta à approfondissement itératif
+                             (Lazy SMP sur plusieurs threads)
+*************************************************************************/
+
+#ifndef AI_H
+#define AI_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "../game/game.h"
+
+/* ================================================================
+ *  Table de transposition
+ * ================================================================ */
+
+#define TT_BUCKET_ENTRIES  4     /* 4 x 16 octets = une ligne de cache */
+#define TT_NO_MOVE         15
+
+/* Nature de la valeur stockée */
+enum {
+    TT_NONE  = 0,
+    TT_EXACT = 1,
+    TT_LOWER = 2,   /* score >= valeur (coupure beta) */
+    TT_UPPER = 3    /* score <= valeur (aucun coup n'a dépassé alpha) */
+};
+
+/*
+ * Entrée sans verrou : check = clé ^ data.
+ * Une écriture concurrente déchirée ne vérifie plus check ^ data == clé
+ * et est simplement vue comme un défaut de cache.
+ */
+typedef struct {
+    _Atomic uint64_t check;
+    _Atomic uint64_t data;
+} TTEntry;
+
+typedef struct {
+    _Alignas(64) TTEntry entry[TT_BUCKET_ENTRIES];
+} TTBucket;
+
+/*
+ * Table de taille fixe :
+ *  buckets    : tableau de mask + 1 seaux (puissance de 2)
+ *  bytes      : taille allouée
+ *  huge_pages : 1 si la mémoire est adossée à des huge pages
+ *  generation : numéro de recherche, pour vieillir les entrées
+ */
+typedef struct {
+    TTBucket       *buckets;
+    size_t          mask;
+    size_t          bytes;
+    int             huge_pages;
+    _Atomic uint8_t generation;
+} TransTable;
+
+/* Résultat d'une sonde réussie */
+typedef struct {
+    int move;       /* case, ou TT_NO_MOVE */
+    int depth;
+    int score;
+    int bound;      /* TT_EXACT / TT_LOWER / TT_UPPER */
+} TTHit;
+
+/*
+ * Alloue une table d'environ megabytes Mo (arrondi à la puissance de 2
+ * inférieure). Si use_huge_pages, tente MAP_HUGETLB puis
+ * MADV_HUGEPAGE avant de revenir à des pages normales.
+ * Retourne 0 en cas de succès, -1 sinon.
+ */
+int  tt_init(TransTable *tt, size_t megabytes, int use_huge_pages);
+void tt_free(TransTable *tt);
+void tt_clear(TransTable *tt);
+
+/* À appeler au début de chaque recherche (vieillit les entrées) */
+void tt_new_search(TransTable *tt);
+
+/* Sûrs depuis plusieurs threads en même temps, sans verrou */
+int  tt_probe(const TransTable *tt, uint64_t key, TTHit *hit);
+void tt_store(TransTable *tt, uint64_t key,
+              int move, int depth, int score, int bound);
+
+/* ================================================================
+ *  Recherche alpha-bêta
+ * ================================================================ */
+
+#define AI_MAX_DEPTH    64
+#define AI_MAX_THREADS  256
+#define AI_WIN        30000     /* partie gagnée (moins la distance en ply) */
+#define AI_INF        32000
+
+/*
+ * Limites d'une recherche :
+ *  max_depth : profondeur maximale (0 = AI_MAX_DEPTH)
+ *  time_ms   : budget dur pour le coup, en millisecondes
+ *  threads   : threads de recherche (1 = séquentiel, 0 = un par cœur)
+ */
+typedef struct {
+    int max_depth;
+    int time_ms;
+    int threads;
+} AiLimits;
+
+/*
+ * Résultat d'une recherche :
+ *  move       : case choisie (-1 si aucun coup légal)
+ *  score      : évaluation pour le joueur au trait
+ *  depth      : dernière profondeur entièrement explorée
+ *  nodes      : nœuds visités
+ *  elapsed_ns : durée de la recherche
+ *  nps        : nœuds par seconde (tous threads confondus)
+ *  threads    : threads effectivement utilisés
+ */
+typedef struct {
+    int      move;
+    int      score;
+    int      depth;
+    int      threads;
+    uint64_t nodes;
+    uint64_t elapsed_ns;
+    double   nps;
+} AiResult;
+
+/* Horloge monotone en nanosecondes */
+uint64_t ai_now_ns(void);
+
+/* Nombre de cœurs en ligne (threads = 0) */
+int ai_default_threads(void);
+
+/*
+ * Cherche le meilleur coup de root->toMove dans la limite de lim.
+ * Avec lim->threads > 1, des threads auxiliaires explorent la même
+ * racine et partagent tt (Lazy SMP) ; le thread principal décide dans
+ * le même budget de temps. Ne modifie pas root. Retourne res->move.
+ */
+int ai_search(const PackedBoard *root, TransTable *tt,
+              const AiLimits *lim, AiResult *res);
+
+/* ================================================================
+ *  Recherche arborescente Monte-Carlo (UCT)
+ * ================================================================ */
+
+/* Moteur opaque : arène de nœuds, arbre courant et pool de threads */
+typedef struct Mcts Mcts;
+
+/*
+ * Résultat d'une recherche MCTS :
+ *  move        : case choisie (enfant de la racine le plus visité)
+ *  playouts    : playouts joués pendant cet appel
+ *  root_visits : visites de la racine (inclut l'arbre réutilisé)
+ *  win_rate    : taux de gain estimé du coup choisi (nul = 1/2)
+ *  nodes       : nœuds présents dans l'arène
+ *  reused      : 1 si l'arbre du coup précédent a été repris
+ *  pps         : playouts par seconde (tous threads confondus)
+ */
+typedef struct {
+    int      move;
+    int      threads;
+    int      reused;
+    uint64_t playouts;
+    uint64_t root_visits;
+    size_t   nodes;
+    double   win_rate;
+    uint64_t elapsed_ns;
+    double   pps;
+} MctsResult;
+
+/*
+ * Crée un moteur avec threads threads (0 = un par cœur) et une arène de
+ * arena_mb Mo. Les threads auxiliaires restent en attente entre les
+ * recherches. Retourne NULL en cas d'échec.
+ */
+Mcts *mcts_create(int threads, size_t arena_mb);
+void  mcts_destroy(Mcts *m);
+
+/* Oublie l'arbre courant (libération O(1) de l'arène) */
+void  mcts_reset(Mcts *m);
+
+/*
+ * Cherche le meilleur coup de root->toMove pendant lim->time_ms ms, ou
+ * jusqu'à max_playouts playouts si non nul. Si root est la racine
+ * précédente, un de ses enfants ou petits-enfants, le sous-arbre est
+ * conservé. lim->max_depth et lim->threads sont ignorés.
+ * Retourne res->move (-1 si aucun coup légal).
+ */
+int   mcts_search(Mcts *m, const PackedBoard *root, const AiLimits *lim,
+                  uint64_t max_playouts, MctsResult *res);
+
+/* ================================================================
+ *  Table de finales (analyse rétrograde)
+ * ================================================================ */
+
+#define TB_MAX_SEEDS   48
+#define TB_DIST_CYCLE  255      /* position résolue par la règle des cycles */
+
+/*
+ * Entrée du fichier, pour le joueur au trait :
+ *  value : graines restantes qu'il gagne en net (ses prises moins
+ *          celles de l'adversaire) avec un jeu parfait, dans [-n, n]
+ *  dist  : demi-coups jusqu'à la fin sur une ligne qui garde value
+ */
+typedef struct {
+    int8_t  value;
+    uint8_t dist;
+} TbEntry;
+
+/*
+ * En-tête du fichier (64 octets, puis les entrées) :
+ *  magic     : "AWALETB1"
+ *  max_seeds : positions avec au plus max_seeds graines sur le plateau
+ *  entries   : 2 × nombre de plateaux (un par joueur au trait)
+ */
+typedef struct {
+    char     magic[8];
+    uint32_t max_seeds;
+    uint32_t entry_bytes;
+    uint64_t entries;
+    uint64_t gen_ns;
+    uint8_t  reserved[32];
+} TbHeader;
+
+#define TB_MAGIC  "AWALETB1"
+
+/*
+ * Résultat d'une consultation :
+ *  value : comme TbEntry.value
+ *  dist  : comme TbEntry.dist
+ *  wdl   : +1 / 0 / -1 pour le joueur au trait, scores actuels compris
+ */
+typedef struct {
+    int value;
+    int dist;
+    int wdl;
+} TbHit;
+
+/* Tables de rang (appelé par tb_open, et par le générateur) */
+void     tb_index_init(void);
+
+/* Nombre de plateaux ayant exactement / strictement moins de n graines */
+uint64_t tb_level_size(int n);
+uint64_t tb_level_offset(int n);
+
+/* Rang d'un plateau de n graines dans son niveau, et l'inverse */
+uint64_t tb_rank(const PackedBoard *pb, int n);
+void     tb_unrank(uint64_t rank, int n, int board[12]);
+
+/*
+ * Projette le fichier en mémoire (partagé par tous les moteurs du
+ * processus). Retourne 0 en cas de succès, -1 sinon.
+ */
+int  tb_open(const char *path);
+void tb_close(void);
+
+/* Graines maximales couvertes (0 sans table chargée) */
+int  tb_max_seeds(void);
+
+/* 1 et *hit rempli si la position est dans la table, 0 sinon */
+int  tb_probe(const PackedBoard *pb, TbHit *hit);
+
+#endif /* AI_H */
@@ -0,0 +1,527 @@
+/*************************************************************************
+                           Awale -- AI (MCTS)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Recherche arborescente Monte-Carlo (UCT) :
+                           réutilisation de l'arbre entre les coups,
+                           playouts parallèles sur un pool de threads,
+                           perte virtuelle atomique, nœuds en arène
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "ai.h"
+
+#define MCTS_UCT_C        1.2      /* constante d'exploration */
+#define MCTS_MAX_PLAYOUT  400      /* demi-coups max d'un playout */
+#define MCTS_RESET_FILL   0.75     /* arène trop pleine : on repart de zéro */
+
+/*
+ * Nœud de l'arbre. wins2 et visits sont comptés du point de vue du
+ * joueur qui a joué move pour arriver ici (2 par victoire, 1 par nul).
+ *  state : 0 feuille, 1 expansion en cours, 2 enfants publiés
+ */
+typedef struct MctsNode {
+    uint64_t          key;
+    struct MctsNode  *children;
+    _Atomic uint32_t  visits;
+    _Atomic uint32_t  wins2;
+    _Atomic uint32_t  vloss;
+    _Atomic int       state;
+    int8_t            move;
+    int8_t            child_count;
+} MctsNode;
+
+/*
+ * Moteur MCTS persistant d'un coup à l'autre :
+ *  arena / cap / used : mémoire des nœuds, libérée en O(1) (used = 0)
+ *  root               : racine courante (conservée pour la réutilisation)
+ *  workers            : threads du pool (le thread appelant travaille aussi)
+ *  job_*              : description de la recherche en cours
+ */
+struct Mcts {
+    char            *arena;
+    size_t           cap;
+    _Atomic size_t   used;
+
+    MctsNode        *root;
+    PackedBoard      root_pos;
+
+    int              threads;
+    pthread_t       *workers;
+    pthread_mutex_t  lock;
+    pthread_cond_t   wake;
+    pthread_cond_t   idle;
+    unsigned         job_seq;
+    int              busy;
+    int              quit;
+
+    uint64_t         job_deadline;
+    uint64_t         job_max_playouts;
+    _Atomic uint64_t job_playouts;
+};
+
+/* =====================================================
+ *                 Générateur par thread
+ * ===================================================== */
+static inline uint64_t rng_next(uint64_t *s)
+{
+    uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Case aléatoire parmi les bits de mask (mask non nul) */
+static inline int rng_pick(uint64_t *s, int mask)
+{
+    int n = __builtin_popcount((unsigned)mask);
+    int k = (int)((rng_next(s) >> 32) % (uint64_t)n);
+    while (k--)
+        mask &= mask - 1;
+    return __builtin_ctz((unsigned)mask);
+}
+
+/* =====================================================
+ *                        Arène
+ * ===================================================== */
+static MctsNode *arena_alloc(Mcts *m, int count)
+{
+    size_t bytes = (size_t)count * sizeof(MctsNode);
+    size_t off   = atomic_fetch_add_explicit(&m->used, bytes, memory_order_relaxed);
+
+    if (off + bytes > m->cap)
+        return NULL;
+    return (MctsNode *)(m->arena + off);
+}
+
+static void node_init(MctsNode *n, uint64_t key, int move)
+{
+    n->key         = key;
+    n->children    = NULL;
+    n->move        = (int8_t)move;
+    n->child_count = 0;
+    atomic_init(&n->visits, 0);
+    atomic_init(&n->wins2, 0);
+    atomic_init(&n->vloss, 0);
+    atomic_init(&n->state, 0);
+}
+
+/* =====================================================
+ *                    Fin de partie
+ * ===================================================== */
+
+/*
+ * Si pb est terminal, renvoie 1 et le vainqueur dans *winner
+ * (0, 1, ou -1 pour un nul). pb est modifié (graines ramassées).
+ */
+static int settle(PackedBoard *pb, int *winner)
+{
+    int mask = pbLegalMoves(pb, pb->toMove);
+
+    if (pbIsGameOver(pb) || !mask) {
+        /* Aucun coup ne nourrit l'adversaire : le joueur garde son camp */
+        if (pb->seeds[0] + pb->seeds[1] > 0)
+            pb->score[pb->toMove] += pb->seeds[0] + pb->seeds[1];
+
+        int d = pb->score[0] - pb->score[1];
+        *winner = (d > 0) ? 0 : (d < 0) ? 1 : -1;
+        return 1;
+    }
+    return 0;
+}
+
+/* Partie aléatoire jusqu'au bout avec les noyaux compacts */
+static int playout(PackedBoard pb, uint64_t *rng)
+{
+    int winner;
+
+    for (int ply = 0; ply < MCTS_MAX_PLAYOUT; ply++) {
+        if (settle(&pb, &winner))
+            return winner;
+
+        /* Finale connue : inutile de la jouer au hasard */
+        TbHit hit;
+        if (tb_probe(&pb, &hit))
+            return (hit.wdl > 0) ? pb.toMove : (hit.wdl < 0) ? 1 - pb.toMove : -1;
+
+        MoveUndo u;
+        makeMove(&pb, rng_pick(rng, pbLegalMoves(&pb, pb.toMove)), &u);
+    }
+
+    /* Partie trop longue : on départage au score */
+    int d = pb.score[0] - pb.score[1];
+    return (d > 0) ? 0 : (d < 0) ? 1 : -1;
+}
+
+/* =====================================================
+ *                  Sélection / expansion
+ * ===================================================== */
+static MctsNode *select_child(MctsNode *n)
+{
+    MctsNode *best = NULL;
+    double    best_v = -1.0;
+
+    uint32_t parent = atomic_load_explicit(&n->visits, memory_order_relaxed)
+                    + atomic_load_explicit(&n->vloss,  memory_order_relaxed);
+    double   log_n  = log((double)(parent + 1));
+
+    for (int k = 0; k < n->child_count; k++) {
+        MctsNode *c = &n->children[k];
+        uint32_t v  = atomic_load_explicit(&c->visits, memory_order_relaxed);
+        uint32_t vl = atomic_load_explicit(&c->vloss,  memory_order_relaxed);
+        uint32_t w  = atomic_load_explicit(&c->wins2,  memory_order_relaxed);
+        uint32_t ne = v + vl;
+
+        /* Perte virtuelle : les descentes en cours comptent comme des défaites */
+        double val = (ne == 0)
+                   ? 1e9 - (double)k
+                   : (double)w / (2.0 * ne) + MCTS_UCT_C * sqrt(log_n / ne);
+
+        if (val > best_v) {
+            best_v = val;
+            best   = c;
+        }
+    }
+    return best;
+}
+
+/* Développe n (position pb) si personne ne l'a fait ; 1 si enfants publiés */
+static int expand(Mcts *m, MctsNode *n, const PackedBoard *pb)
+{
+    int expected = 0;
+    if (!atomic_compare_exchange_strong(&n->state, &expected, 1))
+        return atomic_load_explicit(&n->state, memory_order_acquire) == 2;
+
+    int mask  = pbLegalMoves(pb, pb->toMove);
+    int count = __builtin_popcount((unsigned)mask);
+
+    MctsNode *kids = count ? arena_alloc(m, count) : NULL;
+    if (!kids) {
+        /* Arène pleine (ou terminal) : la feuille reste une feuille */
+        atomic_store_explicit(&n->state, 0, memory_order_release);
+        return 0;
+    }
+
+    for (int k = 0; mask; k++) {
+        int pit = __builtin_ctz((unsigned)mask);
+        mask &= mask - 1;
+
+        PackedBoard next = *pb;
+        MoveUndo u;
+        makeMove(&next, pit, &u);
+        node_init(&kids[k], next.key, pit);
+    }
+
+    n->children    = kids;
+    n->child_count = (int8_t)count;
+    atomic_store_explicit(&n->state, 2, memory_order_release);
+    return 1;
+}
+
+/* =====================================================
+ *                 Une itération complète
+ * ===================================================== */
+static void iterate_once(Mcts *m, uint64_t *rng)
+{
+    MctsNode   *path[AI_MAX_DEPTH * 4];
+    int         movers[AI_MAX_DEPTH * 4];
+    int         depth = 0;
+    PackedBoard pb    = m->root_pos;
+    MctsNode   *n     = m->root;
+
+    path[depth++] = n;
+    atomic_fetch_add_explicit(&n->vloss, 1, memory_order_relaxed);
+
+    /* Descente tant que les enfants sont publiés */
+    int winner;
+    int terminal = 0;
+
+    while (depth < (int)(sizeof(path) / sizeof(path[0]))) {
+        PackedBoard probe = pb;
+        if (settle(&probe, &winner)) {
+            terminal = 1;
+            break;
+        }
+
+        if (atomic_load_explicit(&n->state, memory_order_acquire) != 2) {
+            if (atomic_load_explicit(&n->visits, memory_order_relaxed) == 0 ||
+                !expand(m, n, &pb))
+                break;
+        }
+
+        MctsNode *c = select_child(n);
+        movers[depth] = pb.toMove;
+
+        MoveUndo u;
+        makeMove(&pb, c->move, &u);
+
+        n = c;
+        path[depth++] = n;
+        atomic_fetch_add_explicit(&n->vloss, 1, memory_order_relaxed);
+    }
+
+    if (!terminal)
+        winner = playout(pb, rng);
+
+    /* Rétropropagation : chaque nœud est noté pour le joueur qui y a mené */
+    for (int k = depth - 1; k >= 0; k--) {
+        MctsNode *p = path[k];
+        int mover   = (k == 0) ? 1 - m->root_pos.toMove : movers[k];
+        uint32_t r  = (winner < 0) ? 1 : (winner == mover) ? 2 : 0;
+
+        atomic_fetch_add_explicit(&p->wins2,  r, memory_order_relaxed);
+        atomic_fetch_add_explicit(&p->visits, 1, memory_order_relaxed);
+        atomic_fetch_sub_explicit(&p->vloss,  1, memory_order_relaxed);
+    }
+}
+
+static void run_job(Mcts *m, uint64_t seed)
+{
+    uint64_t rng = seed;
+
+    for (;;) {
+        uint64_t done = atomic_fetch_add_explicit(&m->job_playouts, 1,
+                                                  memory_order_relaxed);
+        if (m->job_max_playouts && done >= m->job_max_playouts)
+            break;
+
+        iterate_once(m, &rng);
+
+        if ((done & 63) == 0 && ai_now_ns() >= m->job_deadline)
+            break;
+    }
+}
+
+/* =====================================================
+ *                    Pool de threads
+ * ===================================================== */
+typedef struct {
+    Mcts *m;
+    int   id;
+} WorkerArg;
+
+static void *worker_main(void *arg)
+{
+    WorkerArg *wa = arg;
+    Mcts *m = wa->m;
+    int   id = wa->id;
+    free(wa);
+
+    unsigned seen = 0;
+
+    pthread_mutex_lock(&m->lock);
+    for (;;) {
+        while (!m->quit && m->job_seq == seen)
+            pthread_cond_wait(&m->wake, &m->lock);
+        if (m->quit)
+            break;
+
+        seen = m->job_seq;
+        pthread_mutex_unlock(&m->lock);
+
+        run_job(m, 0xA5A5A5A5ULL * (uint64_t)(id + 1) ^ (uint64_t)seen << 32);
+
+        pthread_mutex_lock(&m->lock);
+        if (--m->busy == 0)
+            pthread_cond_signal(&m->idle);
+    }
+    pthread_mutex_unlock(&m->lock);
+    return NULL;
+}
+
+/* =====================================================
+ *                   Création / libération
+ * ===================================================== */
+Mcts *mcts_create(int threads, size_t arena_mb)
+{
+    if (threads <= 0)
+        threads = ai_default_threads();
+    if (threads > AI_MAX_THREADS)
+        threads = AI_MAX_THREADS;
+
+    Mcts *m = calloc(1, sizeof(*m));
+    if (!m)
+        return NULL;
+
+    m->cap   = (arena_mb ? arena_mb : 1) * 1024 * 1024;
+    m->arena = mmap(NULL, m->cap, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (m->arena == MAP_FAILED) {
+        free(m);
+        return NULL;
+    }
+    atomic_init(&m->used, 0);
+    atomic_init(&m->job_playouts, 0);
+
+    pthread_mutex_init(&m->lock, NULL);
+    pthread_cond_init(&m->wake, NULL);
+    pthread_cond_init(&m->idle, NULL);
+
+    m->workers = calloc((size_t)threads, sizeof(pthread_t));
+    m->threads = 1;
+
+    for (int k = 1; m->workers && k < threads; k++) {
+        WorkerArg *wa = malloc(sizeof(*wa));
+        if (!wa)
+            break;
+        wa->m  = m;
+        wa->id = k;
+        if (pthread_create(&m->workers[k], NULL, worker_main, wa) != 0) {
+            free(wa);
+            break;
+        }
+        m->threads++;
+    }
+
+    return m;
+}
+
+void mcts_destroy(Mcts *m)
+{
+    if (!m)
+        return;
+
+    pthread_mutex_lock(&m->lock);
+    m->quit = 1;
+    pthread_cond_broadcast(&m->wake);
+    pthread_mutex_unlock(&m->lock);
+
+    for (int k = 1; k < m->threads; k++)
+        pthread_join(m->workers[k], NULL);
+
+    pthread_cond_destroy(&m->idle);
+    pthread_cond_destroy(&m->wake);
+    pthread_mutex_destroy(&m->lock);
+
+    munmap(m->arena, m->cap);
+    free(m->workers);
+    free(m);
+}
+
+/* =====================================================
+ *                Réutilisation de l'arbre
+ * ===================================================== */
+
+/* Cherche la position parmi les enfants et petits-enfants de la racine */
+static MctsNode *find_subtree(MctsNode *root, uint64_t key)
+{
+    if (!root)
+        return NULL;
+    if (root->key == key)
+        return root;
+    if (atomic_load_explicit(&root->state, memory_order_acquire) != 2)
+        return NULL;
+
+    for (int i = 0; i < root->child_count; i++) {
+        MctsNode *c = &root->children[i];
+        if (c->key == key)
+            return c;
+        if (atomic_load_explicit(&c->state, memory_order_acquire) != 2)
+            continue;
+        for (int j = 0; j < c->child_count; j++)
+            if (c->children[j].key == key)
+                return &c->children[j];
+    }
+    return NULL;
+}
+
+static int set_root(Mcts *m, const PackedBoard *pb)
+{
+    size_t used = atomic_load_explicit(&m->used, memory_order_relaxed);
+    MctsNode *sub = (used < (size_t)(m->cap * MCTS_RESET_FILL))
+                  ? find_subtree(m->root, pb->key) : NULL;
+
+    m->root_pos = *pb;
+
+    if (sub) {
+        m->root = sub;
+        return 1;
+    }
+
+    /* Libération O(1) de tout l'arbre précédent */
+    atomic_store_explicit(&m->used, 0, memory_order_relaxed);
+    m->root = arena_alloc(m, 1);
+    node_init(m->root, pb->key, -1);
+    return 0;
+}
+
+void mcts_reset(Mcts *m)
+{
+    atomic_store_explicit(&m->used, 0, memory_order_relaxed);
+    m->root = NULL;
+}
+
+/* =====================================================
+ *                    Point d'entrée
+ * ===================================================== */
+int mcts_search(Mcts *m, const PackedBoard *root, const AiLimits *lim,
+                uint64_t max_playouts, MctsResult *res)
+{
+    memset(res, 0, sizeof(*res));
+    res->move = -1;
+
+    int mask = pbLegalMoves(root, root->toMove);
+    if (!mask)
+        return -1;
+
+    uint64_t start = ai_now_ns();
+    uint64_t budget = (uint64_t)(lim->time_ms > 0 ? lim->time_ms : 1) * 1000000ULL;
+
+    res->reused      = set_root(m, root);
+    uint32_t before  = atomic_load(&m->root->visits);
+
+    m->job_deadline     = start + budget;
+    m->job_max_playouts = max_playouts;
+    atomic_store(&m->job_playouts, 0);
+
+    /* Réveil du pool, puis le thread appelant travaille aussi */
+    pthread_mutex_lock(&m->lock);
+    m->busy = m->threads - 1;
+    m->job_seq++;
+    unsigned seq = m->job_seq;
+    pthread_cond_broadcast(&m->wake);
+    pthread_mutex_unlock(&m->lock);
+
+    run_job(m, 0x5EEDULL ^ (uint64_t)seq << 32);
+
+    pthread_mutex_lock(&m->lock);
+    while (m->busy > 0)
+        pthread_cond_wait(&m->idle, &m->lock);
+    pthread_mutex_unlock(&m->lock);
+
+    /* Coup le plus visité */
+    MctsNode *best = NULL;
+    if (atomic_load(&m->root->state) == 2) {
+        for (int k = 0; k < m->root->child_count; k++) {
+            MctsNode *c = &m->root->children[k];
+            if (!best || atomic_load(&c->visits) > atomic_load(&best->visits))
+                best = c;
+        }
+    }
+
+    uint32_t after = atomic_load(&m->root->visits);
+
+    res->move        = best ? best->move : __builtin_ctz((unsigned)mask);
+    res->playouts    = after - before;
+    res->root_visits = after;
+    res->win_rate    = (best && atomic_load(&best->visits))
+                     ? (double)atomic_load(&best->wins2) / (2.0 * atomic_load(&best->visits))
+                     : 0.0;
+    res->nodes       = atomic_load(&m->used) / sizeof(MctsNode);
+    res->threads     = m->threads;
+    res->elapsed_ns  = ai_now_ns() - start;
+    res->pps         = res->elapsed_ns
+                     ? (double)res->playouts * 1e9 / (double)res->elapsed_ns
+                     : 0.0;
+
+    return res->move;
+}
@@ -0,0 +1,453 @@
+/*************************************************************************
+                           Awale -- AI (Alpha-beta)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Négamax alpha-bêta à approfondissement itératif,
+                           tri des coups, budget de temps dur par coup et
+                           recherche parallèle Lazy SMP
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "ai.h"
+
+/* Vérification de l'horloge tous les CHECK_NODES nœuds */
+#define CHECK_NODES  1024
+
+/* Scores proches de AI_WIN : fin de partie connue à distance fixe */
+#define AI_WIN_BOUND (AI_WIN - 1000)
+
+/*
+ * Contexte d'une recherche :
+ *  tt        : table de transposition (éventuellement partagée)
+ *  deadline  : instant limite (ns, horloge monotone)
+ *  nodes     : nœuds visités
+ *  stop      : budget épuisé, résultats de l'itération en cours ignorés
+ *  abort     : arrêt demandé par le thread principal (partagé, Lazy SMP)
+ *  killers   : deux coups ayant provoqué une coupure, par ply
+ *  history   : bonus des coups ayant provoqué une coupure, par camp/case
+ */
+typedef struct {
+    TransTable *tt;
+    uint64_t    deadline;
+    uint64_t    nodes;
+    int         stop;
+    atomic_int *abort;
+    int         killers[AI_MAX_DEPTH + 1][2];
+    int         history[2][12];
+} Search;
+
+uint64_t ai_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* =====================================================
+ *                 Évaluation / fin de partie
+ * ===================================================== */
+
+/* Valeur d'une position terminale pour le joueur au trait */
+static int final_score(const PackedBoard *end, int me, int ply)
+{
+    int diff = end->score[me] - end->score[1 - me];
+
+    if (diff > 0) return  AI_WIN - ply;
+    if (diff < 0) return -AI_WIN + ply;
+    return 0;
+}
+
+/*
+ * Teste la fin de partie sans modifier pb (pbIsGameOver ramasse les
+ * graines restantes, on travaille donc sur une copie).
+ */
+static int is_terminal(const PackedBoard *pb, PackedBoard *end)
+{
+    *end = *pb;
+    return pbIsGameOver(end);
+}
+
+/* Écart de score, puis graines de chaque camp pour départager */
+static int evaluate(const PackedBoard *pb)
+{
+    int me = pb->toMove;
+    return 8 * (pb->score[me] - pb->score[1 - me])
+         + (pb->seeds[me] - pb->seeds[1 - me]);
+}
+
+/* Issue exacte d'une finale de la table, à distance connue */
+static int tb_score(const TbHit *hit, int ply)
+{
+    if (hit->wdl > 0) return  AI_WIN - ply - hit->dist;
+    if (hit->wdl < 0) return -AI_WIN + ply + hit->dist;
+    return 0;
+}
+
+static inline int score_to_tt(int score, int ply)
+{
+    if (score >  AI_WIN_BOUND) return score + ply;
+    if (score < -AI_WIN_BOUND) return score - ply;
+    return score;
+}
+
+static inline int score_from_tt(int score, int ply)
+{
+    if (score >  AI_WIN_BOUND) return score - ply;
+    if (score < -AI_WIN_BOUND) return score + ply;
+    return score;
+}
+
+/* =====================================================
+ *                     Tri des coups
+ * ===================================================== */
+
+/* Coups du masque triés : coup de la table, killers, puis historique */
+static int order_moves(const Search *s, int mask, int side, int tt_move,
+                       int ply, int moves[6])
+{
+    int keys[6];
+    int n = 0;
+
+    while (mask) {
+        int pit = __builtin_ctz(mask);
+        mask &= mask - 1;
+
+        int key = s->history[side][pit];
+        if (pit == s->killers[ply][0])      key += 1 << 24;
+        else if (pit == s->killers[ply][1]) key += 1 << 23;
+        if (pit == tt_move)                 key += 1 << 28;
+
+        int k = n++;
+        while (k > 0 && keys[k - 1] < key) {
+            keys[k]  = keys[k - 1];
+            moves[k] = moves[k - 1];
+            k--;
+        }
+        keys[k]  = key;
+        moves[k] = pit;
+    }
+    return n;
+}
+
+static void record_cutoff(Search *s, int side, int pit, int depth, int ply)
+{
+    if (s->killers[ply][0] != pit) {
+        s->killers[ply][1] = s->killers[ply][0];
+        s->killers[ply][0] = pit;
+    }
+
+    s->history[side][pit] += depth * depth;
+    if (s->history[side][pit] > (1 << 22)) {
+        for (int i = 0; i < 12; i++) {
+            s->history[0][i] /= 2;
+            s->history[1][i] /= 2;
+        }
+    }
+}
+
+/* =====================================================
+ *                       Négamax
+ * ===================================================== */
+static int negamax(Search *s, PackedBoard *pb, int depth,
+                   int alpha, int beta, int ply)
+{
+    if ((++s->nodes & (CHECK_NODES - 1)) == 0 &&
+        (ai_now_ns() >= s->deadline ||
+         atomic_load_explicit(s->abort, memory_order_relaxed)))
+        s->stop = 1;
+    if (s->stop)
+        return 0;
+
+    PackedBoard end;
+    if (is_terminal(pb, &end))
+        return final_score(&end, pb->toMove, ply);
+
+    int side = pb->toMove;
+    int mask = pbLegalMoves(pb, side);
+
+    /* Aucun coup ne nourrit l'adversaire : le joueur garde son camp */
+    if (!mask) {
+        end = *pb;
+        end.score[side] += end.seeds[0] + end.seeds[1];
+        return final_score(&end, side, ply);
+    }
+
+    /* Peu de graines : la table de finales donne l'issue */
+    TbHit tb;
+    if (tb_probe(pb, &tb))
+        return tb_score(&tb, ply);
+
+    if (depth <= 0 || ply >= AI_MAX_DEPTH)
+        return evaluate(pb);
+
+    int    alpha0  = alpha;
+    int    tt_move = TT_NO_MOVE;
+    TTHit  hit;
+
+    if (tt_probe(s->tt, pb->key, &hit)) {
+        tt_move = hit.move;
+        if (hit.depth >= depth) {
+            int v = score_from_tt(hit.score, ply);
+            if (hit.bound == TT_EXACT)                 return v;
+            if (hit.bound == TT_LOWER && v >= beta)    return v;
+            if (hit.bound == TT_UPPER && v <= alpha)   return v;
+        }
+    }
+
+    int moves[6];
+    int n = order_moves(s, mask, side, tt_move, ply, moves);
+
+    int best      = -AI_INF;
+    int best_move = moves[0];
+
+    for (int k = 0; k < n; k++) {
+        MoveUndo u;
+        makeMove(pb, moves[k], &u);
+        int v = -negamax(s, pb, depth - 1, -beta, -alpha, ply + 1);
+        unmakeMove(pb, &u);
+
+        if (s->stop)
+            return 0;
+
+        if (v > best) {
+            best      = v;
+            best_move = moves[k];
+        }
+        if (v > alpha)
+            alpha = v;
+        if (alpha >= beta) {
+            record_cutoff(s, side, moves[k], depth, ply);
+            break;
+        }
+    }
+
+    int bound = (best <= alpha0) ? TT_UPPER
+              : (best >= beta)   ? TT_LOWER
+              :                    TT_EXACT;
+    tt_store(s->tt, pb->key, best_move, depth, score_to_tt(best, ply), bound);
+
+    return best;
+}
+
+/* Racine : comme negamax, mais retient le meilleur coup */
+static int search_root(Search *s, PackedBoard *pb, int depth,
+                       int mask, int *best_move)
+{
+    int   tt_move = TT_NO_MOVE;
+    TTHit hit;
+
+    if (tt_probe(s->tt, pb->key, &hit))
+        tt_move = hit.move;
+
+    /* Le meilleur coup de l'itération précédente passe en premier */
+    if (*best_move >= 0)
+        tt_move = *best_move;
+
+    int moves[6];
+    int n = order_moves(s, mask, pb->toMove, tt_move, 0, moves);
+
+    int alpha = -AI_INF;
+    int best  = moves[0];
+
+    for (int k = 0; k < n; k++) {
+        MoveUndo u;
+        makeMove(pb, moves[k], &u);
+        int v = -negamax(s, pb, depth - 1, -AI_INF, -alpha, 1);
+        unmakeMove(pb, &u);
+
+        if (s->stop)
+            return 0;
+
+        if (v > alpha) {
+            alpha = v;
+            best  = moves[k];
+        }
+    }
+
+    tt_store(s->tt, pb->key, best, depth, score_to_tt(alpha, 0), TT_EXACT);
+    *best_move = best;
+    return alpha;
+}
+
+/* =====================================================
+ *               Approfondissement itératif
+ * ===================================================== */
+
+/*
+ * Itérations first_depth, first_depth + 1, ... jusqu'à max_depth ou
+ * l'arrêt. Le thread principal (main) s'arrête aussi quand l'itération
+ * suivante dépasserait le budget ; les threads auxiliaires tournent
+ * jusqu'à ce qu'on leur demande d'arrêter.
+ */
+static void iterate(Search *s, const PackedBoard *root, int mask,
+                    int first_depth, int max_depth,
+                    uint64_t start, uint64_t budget, int main,
+                    AiResult *res)
+{
+    PackedBoard pb = *root;
+    int best_move  = -1;
+
+    for (int depth = first_depth; depth <= max_depth; depth++) {
+        int score = search_root(s, &pb, depth, mask, &best_move);
+        if (s->stop)
+            break;
+
+        res->move  = best_move;
+        res->score = score;
+        res->depth = depth;
+
+        /* Issue de la partie connue : inutile d'aller plus loin */
+        if (score > AI_WIN_BOUND || score < -AI_WIN_BOUND)
+            break;
+
+        /* L'itération suivante coûterait plus que le temps restant */
+        if (main && ai_now_ns() - start > budget / 2)
+            break;
+    }
+}
+
+/* =====================================================
+ *                 Lazy SMP : threads auxiliaires
+ * ===================================================== */
+
+/*
+ * Thread auxiliaire : même racine, même table, mais profondeur de
+ * départ décalée et ordre des coups perturbé par un historique initial
+ * propre au thread. Il remplit la table pour le thread principal.
+ */
+typedef struct {
+    Search       s;
+    PackedBoard  root;
+    int          mask;
+    int          id;
+    int          max_depth;
+    uint64_t     start;
+    uint64_t     budget;
+    AiResult     res;
+    pthread_t    tid;
+} Helper;
+
+static void *helper_main(void *arg)
+{
+    Helper *h = arg;
+
+    uint64_t seed = 0x9E3779B97F4A7C15ULL * (uint64_t)(h->id + 1);
+    for (int side = 0; side < 2; side++)
+        for (int pit = 0; pit < 12; pit++) {
+            seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+            h->s.history[side][pit] = (int)(seed & 0xFF);
+        }
+
+    iterate(&h->s, &h->root, h->mask, 1 + (h->id & 1), h->max_depth,
+            h->start, h->budget, 0, &h->res);
+    return NULL;
+}
+
+int ai_default_threads(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+}
+
+/* =====================================================
+ *                    Point d'entrée
+ * ===================================================== */
+int ai_search(const PackedBoard *root, TransTable *tt,
+              const AiLimits *lim, AiResult *res)
+{
+    uint64_t start  = ai_now_ns();
+    uint64_t budget = (uint64_t)(lim->time_ms > 0 ? lim->time_ms : 1) * 1000000ULL;
+
+    int max_depth = lim->max_depth;
+    if (max_depth <= 0 || max_depth > AI_MAX_DEPTH)
+        max_depth = AI_MAX_DEPTH;
+
+    int threads = lim->threads;
+    if (threads <= 0)
+        threads = ai_default_threads();
+    if (threads > AI_MAX_THREADS)
+        threads = AI_MAX_THREADS;
+
+    memset(res, 0, sizeof(*res));
+    res->move = -1;
+
+    int mask = pbLegalMoves(root, root->toMove);
+    if (!mask)
+        return -1;
+
+    /* Toujours un coup jouable, même si la première itération n'aboutit pas */
+    res->move = __builtin_ctz(mask);
+    tt_new_search(tt);
+
+    atomic_int abort_flag;
+    atomic_init(&abort_flag, 0);
+
+    Helper *helpers = NULL;
+    int     started = 0;
+
+    if (threads > 1)
+        helpers = calloc((size_t)(threads - 1), sizeof(*helpers));
+
+    for (int k = 0; helpers && k < threads - 1; k++) {
+        Helper *h    = &helpers[k];
+        h->s.tt       = tt;
+        h->s.deadline = start + budget;
+        h->s.abort    = &abort_flag;
+        h->root       = *root;
+        h->mask       = mask;
+        h->id         = k + 1;
+        h->max_depth  = max_depth;
+        h->start      = start;
+        h->budget     = budget;
+        h->res.move   = -1;
+
+        if (pthread_create(&h->tid, NULL, helper_main, h) != 0)
+            break;
+        started++;
+    }
+
+    Search s;
+    memset(&s, 0, sizeof(s));
+    s.tt       = tt;
+    s.deadline = start + budget;
+    s.abort    = &abort_flag;
+
+    AiResult main_res = *res;
+    iterate(&s, root, mask, 1, max_depth, start, budget, 1, &main_res);
+    *res = main_res;
+
+    /* Le thread principal a fini : on arrête les auxiliaires */
+    atomic_store(&abort_flag, 1);
+
+    uint64_t nodes = s.nodes;
+    for (int k = 0; k < started; k++) {
+        pthread_join(helpers[k].tid, NULL);
+        nodes += helpers[k].s.nodes;
+
+        /* Un auxiliaire allé plus profond l'emporte */
+        if (helpers[k].res.move >= 0 && helpers[k].res.depth > res->depth) {
+            res->move  = helpers[k].res.move;
+            res->score = helpers[k].res.score;
+            res->depth = helpers[k].res.depth;
+        }
+    }
+    free(helpers);
+
+    res->threads    = started + 1;
+    res->nodes      = nodes;
+    res->elapsed_ns = ai_now_ns() - start;
+    res->nps        = res->elapsed_ns
+                    ? (double)nodes * 1e9 / (double)res->elapsed_ns
+                    : 0.0;
+
+    return res->move;
+}
@@ -0,0 +1,215 @@
+/*************************************************************************
+                           Awale -- AI (Endgame tablebase)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Indexation des plateaux à peu de graines et
+                           consultation en O(1) d'une table de finales
+                           projetée en mémoire (mmap)
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ai.h"
+
+/*
+ * Indexation : un plateau de n graines est une composition de n en 12
+ * cases. Les plateaux sont rangés par nombre de graines, puis dans
+ * l'ordre lexicographique des cases 0..10 (la case 11 est déduite) :
+ *
+ *   index = (tb_level_offset(n) + tb_rank(pb, n)) * 2 + joueur au trait
+ *
+ * Les scores n'entrent pas dans l'index : la valeur d'une position ne
+ * dépend que des graines restantes, les scores sont ajoutés à la lecture.
+ */
+
+/* C(a, k) pour a < BINOM_ROWS, k <= 12 */
+#define BINOM_ROWS  (TB_MAX_SEEDS + 13)
+
+static uint64_t g_binom[BINOM_ROWS][13];
+
+/*
+ * g_rank_tab[pit][r][v] : plateaux où la case pit reçoit moins de v
+ * graines, sachant que r graines restent pour les cases pit..11.
+ */
+static uint64_t g_rank_tab[11][TB_MAX_SEEDS + 1][TB_MAX_SEEDS + 2];
+static uint64_t g_level_off[TB_MAX_SEEDS + 2];
+
+static pthread_once_t g_index_once = PTHREAD_ONCE_INIT;
+
+/* Table chargée (une par processus) */
+static const TbEntry *g_tb       = NULL;
+static void          *g_tb_map   = NULL;
+static size_t         g_tb_bytes = 0;
+static int            g_tb_max   = 0;
+
+/* =====================================================
+ *                     Indexation
+ * ===================================================== */
+
+/* Compositions de s graines en m cases (m >= 1) */
+static uint64_t compositions(int s, int m)
+{
+    return g_binom[s + m - 1][m - 1];
+}
+
+static void index_build(void)
+{
+    for (int a = 0; a < BINOM_ROWS; a++) {
+        g_binom[a][0] = 1;
+        for (int k = 1; k <= 12; k++)
+            g_binom[a][k] = (a == 0) ? 0 : g_binom[a - 1][k - 1] + g_binom[a - 1][k];
+    }
+
+    for (int pit = 0; pit < 11; pit++) {
+        int after = 11 - pit;
+        for (int r = 0; r <= TB_MAX_SEEDS; r++) {
+            uint64_t acc = 0;
+            for (int v = 0; v <= r + 1; v++) {
+                g_rank_tab[pit][r][v] = acc;
+                if (v <= r)
+                    acc += compositions(r - v, after);
+            }
+        }
+    }
+
+    for (int n = 0; n <= TB_MAX_SEEDS + 1; n++)
+        g_level_off[n] = g_binom[n + 11][12];
+}
+
+void tb_index_init(void)
+{
+    pthread_once(&g_index_once, index_build);
+}
+
+uint64_t tb_level_size(int n)
+{
+    return g_binom[n + 11][11];
+}
+
+uint64_t tb_level_offset(int n)
+{
+    return g_level_off[n];
+}
+
+uint64_t tb_rank(const PackedBoard *pb, int n)
+{
+    uint64_t rank = 0;
+    int r = n;
+
+    for (int pit = 0; pit < 11; pit++) {
+        int v = pbPit(pb, pit);
+        rank += g_rank_tab[pit][r][v];
+        r    -= v;
+    }
+    return rank;
+}
+
+void tb_unrank(uint64_t rank, int n, int board[12])
+{
+    int r = n;
+
+    for (int pit = 0; pit < 11; pit++) {
+        int v = 0;
+        while (v < r && g_rank_tab[pit][r][v + 1] <= rank)
+            v++;
+        rank -= g_rank_tab[pit][r][v];
+        board[pit] = v;
+        r -= v;
+    }
+    board[11] = r;
+}
+
+/* =====================================================
+ *                 Chargement du fichier
+ * ===================================================== */
+int tb_open(const char *path)
+{
+    tb_index_init();
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(TbHeader)) {
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return -1;
+
+    const TbHeader *h = map;
+    size_t need = sizeof(TbHeader);
+
+    int ok = memcmp(h->magic, TB_MAGIC, sizeof(h->magic)) == 0 &&
+             h->max_seeds <= TB_MAX_SEEDS &&
+             h->entry_bytes == sizeof(TbEntry) &&
+             h->entries == 2 * tb_level_offset((int)h->max_seeds + 1);
+    if (ok)
+        need += h->entries * sizeof(TbEntry);
+
+    if (!ok || (size_t)st.st_size < need) {
+        munmap(map, (size_t)st.st_size);
+        return -1;
+    }
+
+    /* Accès aléatoires : pas de lecture anticipée */
+    madvise(map, (size_t)st.st_size, MADV_RANDOM);
+
+    tb_close();
+    g_tb_map   = map;
+    g_tb_bytes = (size_t)st.st_size;
+    g_tb       = (const TbEntry *)((const char *)map + sizeof(TbHeader));
+    g_tb_max   = (int)h->max_seeds;
+    return 0;
+}
+
+void tb_close(void)
+{
+    if (g_tb_map)
+        munmap(g_tb_map, g_tb_bytes);
+
+    g_tb       = NULL;
+    g_tb_map   = NULL;
+    g_tb_bytes = 0;
+    g_tb_max   = 0;
+}
+
+int tb_max_seeds(void)
+{
+    return g_tb_max;
+}
+
+/* =====================================================
+ *                     Consultation
+ * ===================================================== */
+int tb_probe(const PackedBoard *pb, TbHit *hit)
+{
+    int n = pb->seeds[0] + pb->seeds[1];
+    if (!g_tb || n > g_tb_max)
+        return 0;
+
+    uint64_t idx = (tb_level_offset(n) + tb_rank(pb, n)) * 2 + (uint64_t)pb->toMove;
+    TbEntry  e   = g_tb[idx];
+
+    int me   = pb->toMove;
+    int diff = pb->score[me] - pb->score[1 - me] + e.value;
+
+    hit->value = e.value;
+    hit->dist  = e.dist;
+    hit->wdl   = (diff > 0) - (diff < 0);
+    return 1;
+}
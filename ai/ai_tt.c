@@ -0,0 +1,172 @@
+/*************************************************************************
+                           Awale -- AI (Transposition table)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Table de transposition à seaux d'une ligne de
+                           cache, partagée sans verrou entre threads
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <string.h>
+#include <sys/mman.h>
+
+#include "ai.h"
+
+#define HUGE_PAGE_SIZE  (2UL * 1024 * 1024)
+
+/*
+ * Format de data (64 bits) :
+ *  bits  0..15 : score (int16)
+ *  bits 16..23 : profondeur
+ *  bits 24..27 : coup (TT_NO_MOVE si aucun)
+ *  bits 28..29 : borne
+ *  bits 32..39 : génération
+ */
+static inline uint64_t pack_data(int move, int depth, int score,
+                                 int bound, unsigned gen)
+{
+    return  (uint64_t)(uint16_t)(int16_t)score
+          | (uint64_t)(depth & 0xFF) << 16
+          | (uint64_t)(move & 0xF)   << 24
+          | (uint64_t)(bound & 0x3)  << 28
+          | (uint64_t)(gen & 0xFF)   << 32;
+}
+
+static inline int data_score(uint64_t d) { return (int16_t)(uint16_t)(d & 0xFFFF); }
+static inline int data_depth(uint64_t d) { return (int)((d >> 16) & 0xFF); }
+static inline int data_move(uint64_t d)  { return (int)((d >> 24) & 0xF); }
+static inline int data_bound(uint64_t d) { return (int)((d >> 28) & 0x3); }
+static inline unsigned data_gen(uint64_t d) { return (unsigned)((d >> 32) & 0xFF); }
+
+/* =====================================================
+ *                Allocation / libération
+ * ===================================================== */
+int tt_init(TransTable *tt, size_t megabytes, int use_huge_pages)
+{
+    memset(tt, 0, sizeof(*tt));
+
+    size_t want = (megabytes ? megabytes : 1) * 1024 * 1024;
+    size_t n    = 1;
+    while (n * 2 * sizeof(TTBucket) <= want)
+        n *= 2;
+
+    size_t bytes = n * sizeof(TTBucket);
+    void  *mem   = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    if (use_huge_pages && bytes >= HUGE_PAGE_SIZE) {
+        mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mem != MAP_FAILED)
+            tt->huge_pages = 1;
+    }
+#endif
+
+    if (mem == MAP_FAILED) {
+        mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED)
+            return -1;
+
+#ifdef MADV_HUGEPAGE
+        /* Huge pages transparentes : au mieux, sans garantie */
+        if (use_huge_pages && madvise(mem, bytes, MADV_HUGEPAGE) == 0)
+            tt->huge_pages = 1;
+#endif
+    }
+
+    /* mmap anonyme : mémoire déjà à zéro (entrées vides) */
+    tt->buckets = mem;
+    tt->mask    = n - 1;
+    tt->bytes   = bytes;
+    atomic_init(&tt->generation, 0);
+    return 0;
+}
+
+void tt_free(TransTable *tt)
+{
+    if (tt->buckets)
+        munmap(tt->buckets, tt->bytes);
+    memset(tt, 0, sizeof(*tt));
+}
+
+void tt_clear(TransTable *tt)
+{
+    for (size_t b = 0; b <= tt->mask; b++)
+        for (int i = 0; i < TT_BUCKET_ENTRIES; i++) {
+            atomic_store_explicit(&tt->buckets[b].entry[i].check, 0, memory_order_relaxed);
+            atomic_store_explicit(&tt->buckets[b].entry[i].data,  0, memory_order_relaxed);
+        }
+}
+
+void tt_new_search(TransTable *tt)
+{
+    atomic_fetch_add_explicit(&tt->generation, 1, memory_order_relaxed);
+}
+
+/* =====================================================
+ *                   Sonde / écriture
+ * ===================================================== */
+int tt_probe(const TransTable *tt, uint64_t key, TTHit *hit)
+{
+    TTBucket *b = &tt->buckets[key & tt->mask];
+
+    for (int i = 0; i < TT_BUCKET_ENTRIES; i++) {
+        uint64_t data  = atomic_load_explicit(&b->entry[i].data,  memory_order_relaxed);
+        uint64_t check = atomic_load_explicit(&b->entry[i].check, memory_order_relaxed);
+
+        if ((check ^ data) != key || data_bound(data) == TT_NONE)
+            continue;
+
+        hit->move  = data_move(data);
+        hit->depth = data_depth(data);
+        hit->score = data_score(data);
+        hit->bound = data_bound(data);
+        return 1;
+    }
+    return 0;
+}
+
+void tt_store(TransTable *tt, uint64_t key,
+              int move, int depth, int score, int bound)
+{
+    TTBucket *b   = &tt->buckets[key & tt->mask];
+    unsigned  gen = atomic_load_explicit(&tt->generation, memory_order_relaxed);
+
+    /*
+     * Victime : l'entrée de même clé si elle existe, sinon celle de plus
+     * faible profondeur, les entrées des recherches passées d'abord.
+     */
+    int victim     = 0;
+    int victim_val = 1 << 30;
+
+    for (int i = 0; i < TT_BUCKET_ENTRIES; i++) {
+        uint64_t data  = atomic_load_explicit(&b->entry[i].data,  memory_order_relaxed);
+        uint64_t check = atomic_load_explicit(&b->entry[i].check, memory_order_relaxed);
+
+        if ((check ^ data) == key) {
+            /* Garder le meilleur coup connu si le nouveau n'en a pas */
+            if (move == TT_NO_MOVE)
+                move = data_move(data);
+            victim = i;
+            break;
+        }
+
+        int age = (int)((gen - data_gen(data)) & 0xFF);
+        int val = data_depth(data) - 8 * age;
+        if (data_bound(data) == TT_NONE)
+            val = -(1 << 20);
+
+        if (val < victim_val) {
+            victim_val = val;
+            victim     = i;
+        }
+    }
+
+    uint64_t data = pack_data(move, depth, score, bound, gen);
+    atomic_store_explicit(&b->entry[victim].data,  data,       memory_order_relaxed);
+    atomic_store_explicit(&b->entry[victim].check, key ^ data, memory_order_relaxed);
+}
@@ -0,0 +1,376 @@
+/*************************************************************************
+                           Awale -- AI (Tablebase generator)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Génère hors ligne la table de finales de toutes
+                           les positions à au plus N graines (analyse
+                           rétrograde parallèle, niveau par niveau)
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "ai.h"
+
+#define DEFAULT_SEEDS   12
+#define DEFAULT_PATH    "awale.tb"
+
+/* Distance interne : position pas encore résolue */
+#define DIST_PENDING    254
+#define DIST_MAX        253
+
+/*
+ * Résolution d'un niveau (n graines sur le plateau) :
+ *
+ *  - une prise mène à un niveau inférieur, déjà exact ;
+ *  - un coup sans prise reste au même niveau : chaque position garde un
+ *    encadrement [lo, hi] de sa valeur, resserré passe après passe
+ *    (lo = max(prise - hi(fils)), hi = max(prise - lo(fils))) jusqu'à
+ *    ce qu'aucune borne ne bouge ;
+ *  - une position dont lo == hi est résolue dès qu'un fils qui atteint
+ *    cette valeur l'est, à distance 1 + dist(fils) ;
+ *  - ce qui reste ne se termine jamais avec un jeu parfait (cycle) :
+ *    chacun garde les graines de son camp, borné par [lo, hi].
+ *
+ * Les bornes ne font que se resserrer : des threads qui lisent une
+ * valeur ancienne ou nouvelle d'un voisin restent corrects, il suffit
+ * d'accès atomiques relâchés.
+ */
+
+/* Tableaux de génération, indexés comme le fichier */
+static _Atomic int8_t  *g_lo;
+static _Atomic int8_t  *g_hi;
+static _Atomic uint8_t *g_dist;
+
+/* Étapes d'un niveau */
+enum { STEP_INIT, STEP_PASS, STEP_CYCLES };
+
+/*
+ * Tranche [from, to) des rangs du niveau n confiée à un thread.
+ * changed : positions en attente (STEP_INIT), modifiées (STEP_PASS)
+ *           ou tranchées par la règle des cycles (STEP_CYCLES)
+ */
+typedef struct {
+    int       n;
+    int       step;
+    uint64_t  from;
+    uint64_t  to;
+    uint64_t  changed;
+    int       started;
+    pthread_t tid;
+} Job;
+
+static inline uint64_t entry_index(const PackedBoard *pb)
+{
+    int n = pb->seeds[0] + pb->seeds[1];
+    return (tb_level_offset(n) + tb_rank(pb, n)) * 2 + (uint64_t)pb->toMove;
+}
+
+/* =====================================================
+ *                 Une position, trois étapes
+ * ===================================================== */
+
+/* Fin de partie immédiate, sinon encadrement [-n, n]. 1 si en attente. */
+static int init_position(const PackedBoard *pb, uint64_t idx, int n)
+{
+    PackedBoard end = *pb;
+
+    if (pbIsGameOver(&end)) {
+        int me = pb->toMove;
+        atomic_store_explicit(&g_lo[idx], (int8_t)(end.score[me] - end.score[1 - me]),
+                              memory_order_relaxed);
+        atomic_store_explicit(&g_dist[idx], 0, memory_order_relaxed);
+        return 0;
+    }
+
+    /* Aucun coup ne nourrit l'adversaire : le joueur garde son camp */
+    if (!pbLegalMoves(pb, pb->toMove)) {
+        atomic_store_explicit(&g_lo[idx], (int8_t)n, memory_order_relaxed);
+        atomic_store_explicit(&g_dist[idx], 0, memory_order_relaxed);
+        return 0;
+    }
+
+    atomic_store_explicit(&g_lo[idx], (int8_t)-n, memory_order_relaxed);
+    atomic_store_explicit(&g_hi[idx], (int8_t)n, memory_order_relaxed);
+    atomic_store_explicit(&g_dist[idx], DIST_PENDING, memory_order_relaxed);
+    return 1;
+}
+
+/* Resserre l'encadrement d'après les fils. 1 si quelque chose a bougé. */
+static int pass_position(const PackedBoard *pb, uint64_t idx, int n)
+{
+    int lo0 = atomic_load_explicit(&g_lo[idx], memory_order_relaxed);
+    int hi0 = atomic_load_explicit(&g_hi[idx], memory_order_relaxed);
+
+    int me   = pb->toMove;
+    int mask = pbLegalMoves(pb, me);
+
+    int lo = -n, hi = -n;
+    int vals[6], dists[6], cnt = 0;
+
+    while (mask) {
+        int pit = __builtin_ctz((unsigned)mask);
+        mask &= mask - 1;
+
+        PackedBoard child = *pb;
+        MoveUndo u;
+        makeMove(&child, pit, &u);
+
+        int      cap = child.score[me];
+        uint64_t ci  = entry_index(&child);
+        int      cd  = atomic_load_explicit(&g_dist[ci], memory_order_relaxed);
+        int      clo = atomic_load_explicit(&g_lo[ci], memory_order_relaxed);
+        int      chi = (cd == DIST_PENDING)
+                     ? atomic_load_explicit(&g_hi[ci], memory_order_relaxed) : clo;
+
+        if (cap - chi > lo) lo = cap - chi;
+        if (cap - clo > hi) hi = cap - clo;
+
+        vals[cnt]  = (cd == DIST_PENDING) ? AI_INF : cap - clo;
+        dists[cnt] = cd;
+        cnt++;
+    }
+
+    if (lo < lo0) lo = lo0;
+    if (hi > hi0) hi = hi0;
+
+    int changed = (lo != lo0 || hi != hi0);
+    atomic_store_explicit(&g_lo[idx], (int8_t)lo, memory_order_relaxed);
+    atomic_store_explicit(&g_hi[idx], (int8_t)hi, memory_order_relaxed);
+
+    if (lo == hi) {
+        /* Fils résolu le plus proche qui réalise la valeur */
+        int best = -1;
+        for (int k = 0; k < cnt; k++) {
+            if (vals[k] != lo)
+                continue;
+            int d = (dists[k] == TB_DIST_CYCLE) ? TB_DIST_CYCLE
+                  : (dists[k] >= DIST_MAX)      ? DIST_MAX
+                  :                               dists[k] + 1;
+            if (best < 0 || d < best)
+                best = d;
+        }
+        if (best >= 0) {
+            atomic_store_explicit(&g_dist[idx], (uint8_t)best, memory_order_relaxed);
+            changed = 1;
+        }
+    }
+
+    return changed;
+}
+
+/* Jeu sans fin : chacun garde son camp, dans les bornes prouvées */
+static void cycle_position(const PackedBoard *pb, uint64_t idx)
+{
+    int me = pb->toMove;
+    int v  = pb->seeds[me] - pb->seeds[1 - me];
+    int lo = atomic_load_explicit(&g_lo[idx], memory_order_relaxed);
+    int hi = atomic_load_explicit(&g_hi[idx], memory_order_relaxed);
+
+    if (v < lo) v = lo;
+    if (v > hi) v = hi;
+
+    atomic_store_explicit(&g_lo[idx], (int8_t)v, memory_order_relaxed);
+    atomic_store_explicit(&g_dist[idx], TB_DIST_CYCLE, memory_order_relaxed);
+}
+
+static void *job_main(void *arg)
+{
+    Job *j = arg;
+    int board[12];
+
+    for (uint64_t r = j->from; r < j->to; r++) {
+        tb_unrank(r, j->n, board);
+
+        for (int side = 0; side < 2; side++) {
+            uint64_t idx = (tb_level_offset(j->n) + r) * 2 + (uint64_t)side;
+
+            if (j->step != STEP_INIT &&
+                atomic_load_explicit(&g_dist[idx], memory_order_relaxed) != DIST_PENDING)
+                continue;
+
+            PackedBoard pb;
+            packBoard(&pb, board, 0, 0);
+            pb.toMove = side;
+
+            switch (j->step) {
+            case STEP_INIT:
+                j->changed += (uint64_t)init_position(&pb, idx, j->n);
+                break;
+            case STEP_PASS:
+                j->changed += (uint64_t)pass_position(&pb, idx, j->n);
+                break;
+            default:
+                cycle_position(&pb, idx);
+                j->changed++;
+                break;
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Une étape sur tout le niveau n, découpée entre les threads */
+static uint64_t run_step(Job *jobs, int threads, int n, int step)
+{
+    uint64_t size = tb_level_size(n);
+
+    for (int t = 0; t < threads; t++) {
+        jobs[t].n       = n;
+        jobs[t].step    = step;
+        jobs[t].from    = size * (uint64_t)t / (uint64_t)threads;
+        jobs[t].to      = size * (uint64_t)(t + 1) / (uint64_t)threads;
+        jobs[t].changed = 0;
+    }
+
+    /* Le thread appelant prend la première tranche */
+    for (int t = 1; t < threads; t++) {
+        jobs[t].started = pthread_create(&jobs[t].tid, NULL, job_main, &jobs[t]) == 0;
+        if (!jobs[t].started)
+            job_main(&jobs[t]);
+    }
+    job_main(&jobs[0]);
+
+    uint64_t changed = jobs[0].changed;
+    for (int t = 1; t < threads; t++) {
+        if (jobs[t].started)
+            pthread_join(jobs[t].tid, NULL);
+        changed += jobs[t].changed;
+    }
+    return changed;
+}
+
+/* =====================================================
+ *                       Écriture
+ * ===================================================== */
+static int write_table(const char *path, int max_seeds, uint64_t entries,
+                       uint64_t gen_ns)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return -1;
+
+    TbHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, TB_MAGIC, sizeof(h.magic));
+    h.max_seeds   = (uint32_t)max_seeds;
+    h.entry_bytes = sizeof(TbEntry);
+    h.entries     = entries;
+    h.gen_ns      = gen_ns;
+
+    int ok = fwrite(&h, sizeof(h), 1, f) == 1;
+
+    TbEntry chunk[4096];
+    for (uint64_t i = 0; ok && i < entries; ) {
+        size_t k = 0;
+        for (; k < 4096 && i < entries; k++, i++) {
+            chunk[k].value = atomic_load_explicit(&g_lo[i], memory_order_relaxed);
+            chunk[k].dist  = atomic_load_explicit(&g_dist[i], memory_order_relaxed);
+        }
+        ok = fwrite(chunk, sizeof(TbEntry), k, f) == k;
+    }
+
+    if (fclose(f) != 0)
+        ok = 0;
+    return ok ? 0 : -1;
+}
+
+/* =====================================================
+ *                         main
+ * ===================================================== */
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [-n max_seeds] [-t threads] [-o file]\n", prog);
+}
+
+static double table_mb(int max_seeds)
+{
+    return (double)(sizeof(TbHeader)
+                  + 2 * tb_level_offset(max_seeds + 1) * sizeof(TbEntry)) / (1 << 20);
+}
+
+int main(int argc, char *argv[])
+{
+    int max_seeds    = DEFAULT_SEEDS;
+    int threads      = ai_default_threads();
+    const char *path = DEFAULT_PATH;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-n") == 0)      max_seeds = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-t") == 0) threads   = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-o") == 0) path      = argv[++i];
+        else { usage(argv[0]); return EXIT_FAILURE; }
+    }
+
+    if (max_seeds < 0 || max_seeds > TB_MAX_SEEDS || threads < 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (threads > AI_MAX_THREADS)
+        threads = AI_MAX_THREADS;
+
+    tb_index_init();
+
+    uint64_t entries = 2 * tb_level_offset(max_seeds + 1);
+    g_lo   = malloc(entries * sizeof(*g_lo));
+    g_hi   = malloc(entries * sizeof(*g_hi));
+    g_dist = malloc(entries * sizeof(*g_dist));
+    Job *jobs = calloc((size_t)threads, sizeof(*jobs));
+
+    if (!g_lo || !g_hi || !g_dist || !jobs) {
+        fprintf(stderr, "Not enough memory for %llu positions\n",
+                (unsigned long long)entries);
+        return EXIT_FAILURE;
+    }
+
+    printf("Tablebase: up to %d seeds, %llu positions, %d threads\n",
+           max_seeds, (unsigned long long)entries, threads);
+    printf("%5s %14s %7s %10s %10s %10s %12s\n",
+           "seeds", "positions", "passes", "cycles",
+           "level (s)", "total (s)", "file (MB)");
+
+    uint64_t start = ai_now_ns();
+
+    /* Niveau par niveau : une prise ne mène qu'à un niveau déjà résolu */
+    for (int n = 0; n <= max_seeds; n++) {
+        uint64_t t0 = ai_now_ns();
+
+        uint64_t pending = run_step(jobs, threads, n, STEP_INIT);
+        int passes = 0;
+
+        while (pending && run_step(jobs, threads, n, STEP_PASS))
+            passes++;
+
+        uint64_t cycles = pending ? run_step(jobs, threads, n, STEP_CYCLES) : 0;
+        uint64_t now    = ai_now_ns();
+
+        printf("%5d %14llu %7d %10llu %10.3f %10.3f %12.2f\n",
+               n, (unsigned long long)(2 * tb_level_size(n)), passes,
+               (unsigned long long)cycles,
+               (double)(now - t0) / 1e9, (double)(now - start) / 1e9,
+               table_mb(n));
+        fflush(stdout);
+    }
+
+    uint64_t gen_ns = ai_now_ns() - start;
+
+    if (write_table(path, max_seeds, entries, gen_ns) < 0) {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+
+    printf("Written %s (%.2f MB) in %.3fs\n",
+           path, table_mb(max_seeds), (double)gen_ns / 1e9);
+
+    free(jobs);
+    free(g_dist);
+    free(g_hi);
+    free(g_lo);
+    return 0;
+}
@@ -0,0 +1,54 @@
+/*************************************************************************
+                           Awale -- Bench
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Outils communs aux programmes de mesure :
+                           lecture des parties de saved_games/ et
+                           constitution d'un jeu de positions fixe
+*************************************************************************/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "../game/game.h"
+
+#define SAVED_MAX_MOVES  1024
+#define SAVED_MAX_FILES  4096
+#define SAVED_PATH_LEN   512
+
+/*
+ * Partie relue depuis un fichier de saved_games/ :
+ *  p0, p1   : joueurs dans l'ordre de GAME_START
+ *  count    : nombre de coups
+ *  player[] : 0 ou 1 (auteur du coup)
+ *  pit[]    : case jouée
+ */
+typedef struct {
+    char p0[16];
+    char p1[16];
+    int  count;
+    int  player[SAVED_MAX_MOVES];
+    int  pit[SAVED_MAX_MOVES];
+} SavedGame;
+
+/* Lit un journal de partie. Retourne 0 si succès, -1 sinon. */
+int saved_game_read(const char *path, SavedGame *g);
+
+/*
+ * Liste les fichiers *.txt de dir (triés par nom).
+ * Retourne le nombre de chemins écrits dans paths.
+ */
+int saved_games_list(const char *dir, char paths[][SAVED_PATH_LEN], int max);
+
+/*
+ * Remplit out avec au plus max positions (trait compris) : une toutes
+ * les every demi-coups des parties de dir, puis, si elles ne suffisent
+ * pas, des positions de parties aléatoires à graine fixe.
+ * Retourne le nombre de positions, toujours identique d'un lancement
+ * à l'autre pour un même dossier.
+ */
+int bench_positions(const char *dir, PackedBoard *out, int max, int every);
+
+#endif /* BENCH_H */
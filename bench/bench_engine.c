@@ -0,0 +1,472 @@
+/*************************************************************************
+                           Awale -- Bench (Engine)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Perft, ns/op des fonctions du moteur et parties
+                           aléatoires par seconde, pour le moteur de
+                           référence et le plateau compact ; sortie JSON
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench.h"
+#include "../ai/ai.h"
+
+#define DEFAULT_DEPTH        8
+#define DEFAULT_SAVED_DEPTH  6
+#define DEFAULT_POSITIONS    16
+#define DEFAULT_OPS          2000000
+#define DEFAULT_GAMES        20000
+#define SAMPLE_SIZE          4096
+#define MAX_PLIES            400
+
+/* Empêche le compilateur de supprimer les appels mesurés */
+static volatile int g_sink;
+
+/* Résumé lisible : stdout, ou stderr quand le JSON part sur stdout */
+static FILE *g_log;
+
+/* =====================================================
+ *                    Sortie JSON
+ * ===================================================== */
+
+/* Un objet JSON par mesure, séparés par des virgules */
+typedef struct {
+    FILE *f;
+    int   first;
+} Json;
+
+static void json_sep(Json *j)
+{
+    fprintf(j->f, j->first ? "\n    " : ",\n    ");
+    j->first = 0;
+}
+
+/* =====================================================
+ *                         Perft
+ * ===================================================== */
+typedef struct {
+    int    board[12];
+    Player p0, p1;
+    int    toMove;
+} RefPos;
+
+static uint64_t perft_ref(const RefPos *pos, int depth)
+{
+    if (depth == 0)
+        return 1;
+
+    RefPos end = *pos;
+    if (isGameOver(end.board, &end.p0.score, &end.p1.score))
+        return 1;
+
+    int mask = legalMoves((int *)pos->board, pos->toMove);
+    if (!mask)
+        return 1;
+
+    uint64_t leaves = 0;
+    while (mask) {
+        int pit = __builtin_ctz(mask);
+        mask &= mask - 1;
+
+        RefPos next = *pos;
+        playMove(next.board, next.toMove, &next.p0, &next.p1, pit);
+        next.toMove = 1 - next.toMove;
+        leaves += perft_ref(&next, depth - 1);
+    }
+    return leaves;
+}
+
+static uint64_t perft_packed(PackedBoard *pb, int depth)
+{
+    if (depth == 0)
+        return 1;
+
+    PackedBoard end = *pb;
+    if (pbIsGameOver(&end))
+        return 1;
+
+    int mask = pbLegalMoves(pb, pb->toMove);
+    if (!mask)
+        return 1;
+
+    uint64_t leaves = 0;
+    while (mask) {
+        int pit = __builtin_ctz(mask);
+        mask &= mask - 1;
+
+        MoveUndo u;
+        makeMove(pb, pit, &u);
+        leaves += perft_packed(pb, depth - 1);
+        unmakeMove(pb, &u);
+    }
+    return leaves;
+}
+
+static void to_ref(const PackedBoard *pb, RefPos *r)
+{
+    memset(r, 0, sizeof(*r));
+    unpackBoard(pb, r->board, &r->p0.score, &r->p1.score);
+    r->p0.number = 0;
+    r->p1.number = 1;
+    r->toMove    = pb->toMove;
+}
+
+/* Perft des deux moteurs sur count positions ; les feuilles doivent coïncider */
+static int bench_perft(Json *j, const char *from, const PackedBoard *pos,
+                       int count, int depth)
+{
+    uint64_t ref_leaves = 0, packed_leaves = 0;
+    uint64_t ref_ns = 0, packed_ns = 0;
+
+    for (int k = 0; k < count; k++) {
+        RefPos r;
+        to_ref(&pos[k], &r);
+
+        uint64_t t0 = ai_now_ns();
+        ref_leaves += perft_ref(&r, depth);
+        uint64_t t1 = ai_now_ns();
+
+        PackedBoard pb = pos[k];
+        packed_leaves += perft_packed(&pb, depth);
+        uint64_t t2 = ai_now_ns();
+
+        ref_ns    += t1 - t0;
+        packed_ns += t2 - t1;
+    }
+
+    int match = (ref_leaves == packed_leaves);
+
+    fprintf(g_log, "perft %-12s d=%-2d %3d pos %14llu leaves  ref %7.2f ns/leaf  packed %7.2f ns/leaf  %s\n",
+            from, depth, count, (unsigned long long)packed_leaves,
+            (double)ref_ns / (double)ref_leaves,
+            (double)packed_ns / (double)packed_leaves,
+            match ? "ok" : "MISMATCH");
+
+    json_sep(j);
+    fprintf(j->f,
+            "{\"from\": \"%s\", \"depth\": %d, \"positions\": %d, "
+            "\"leaves\": %llu, \"reference_leaves\": %llu, \"match\": %s, "
+            "\"reference_ns_per_leaf\": %.3f, \"packed_ns_per_leaf\": %.3f}",
+            from, depth, count,
+            (unsigned long long)packed_leaves, (unsigned long long)ref_leaves,
+            match ? "true" : "false",
+            (double)ref_ns / (double)ref_leaves,
+            (double)packed_ns / (double)packed_leaves);
+
+    return match ? 0 : -1;
+}
+
+/* =====================================================
+ *                   Fonctions du moteur
+ * ===================================================== */
+
+/*
+ * Jeu d'essai : pour chaque position, un coup légal et la position
+ * juste après les semailles (pour mesurer la capture seule).
+ */
+typedef struct {
+    PackedBoard pos;
+    RefPos      ref;
+    int         pit;
+    PackedBoard sown;
+    RefPos      sown_ref;
+    int         last;
+} Sample;
+
+static int build_samples(Sample *s, const PackedBoard *pos, int count)
+{
+    uint64_t rng = 0xB0A4D5EEDULL;
+
+    for (int k = 0; k < count; k++) {
+        s[k].pos = pos[k];
+        to_ref(&pos[k], &s[k].ref);
+
+        int mask = pbLegalMoves(&pos[k], pos[k].toMove);
+        int n    = __builtin_popcount((unsigned)mask);
+
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        for (int skip = (int)(rng % (uint64_t)n); skip > 0; skip--)
+            mask &= mask - 1;
+        s[k].pit = __builtin_ctz((unsigned)mask);
+
+        s[k].sown = pos[k];
+        s[k].last = pbSow(&s[k].sown, s[k].pit);
+        to_ref(&s[k].sown, &s[k].sown_ref);
+    }
+    return count;
+}
+
+typedef enum {
+    OP_PLAY_REF, OP_PLAY_PACKED, OP_MAKE_UNMAKE,
+    OP_CAPTURE_REF, OP_CAPTURE_PACKED,
+    OP_OVER_REF, OP_OVER_PACKED,
+    OP_LEGAL_REF, OP_LEGAL_PACKED,
+    OP_COUNT
+} Op;
+
+static const struct {
+    const char *name;
+    const char *impl;
+} g_ops[OP_COUNT] = {
+    { "playMove",     "reference" },
+    { "playMove",     "packed"    },
+    { "makeMove",     "packed"    },
+    { "captureSeeds", "reference" },
+    { "captureSeeds", "packed"    },
+    { "isGameOver",   "reference" },
+    { "isGameOver",   "packed"    },
+    { "legalMoves",   "reference" },
+    { "legalMoves",   "packed"    },
+};
+
+/* Une opération sur une copie de l'échantillon (copie comprise dans la mesure) */
+static inline int run_op(Op op, const Sample *s)
+{
+    switch (op) {
+    case OP_PLAY_REF: {
+        RefPos r = s->ref;
+        return playMove(r.board, r.toMove, &r.p0, &r.p1, s->pit);
+    }
+    case OP_PLAY_PACKED: {
+        PackedBoard pb = s->pos;
+        return pbPlayMove(&pb, pb.toMove, s->pit);
+    }
+    case OP_MAKE_UNMAKE: {
+        PackedBoard pb = s->pos;
+        MoveUndo u;
+        makeMove(&pb, s->pit, &u);
+        unmakeMove(&pb, &u);
+        return (int)pb.key;
+    }
+    case OP_CAPTURE_REF: {
+        RefPos r = s->sown_ref;
+        captureSeeds(r.board, r.toMove, &r.p0, &r.p1, s->last);
+        return r.p0.score + r.p1.score;
+    }
+    case OP_CAPTURE_PACKED: {
+        PackedBoard pb = s->sown;
+        return pbCaptureSeeds(&pb, pb.toMove, s->last);
+    }
+    case OP_OVER_REF: {
+        RefPos r = s->ref;
+        return isGameOver(r.board, &r.p0.score, &r.p1.score);
+    }
+    case OP_OVER_PACKED: {
+        PackedBoard pb = s->pos;
+        return pbIsGameOver(&pb);
+    }
+    case OP_LEGAL_REF: {
+        RefPos r = s->ref;
+        return legalMoves(r.board, r.toMove);
+    }
+    case OP_LEGAL_PACKED:
+        return pbLegalMoves(&s->pos, s->pos.toMove);
+    default:
+        return 0;
+    }
+}
+
+static void bench_ops(Json *j, const Sample *s, int count, uint64_t ops)
+{
+    for (int op = 0; op < OP_COUNT; op++) {
+        int acc = 0;
+        uint64_t t0 = ai_now_ns();
+
+        for (uint64_t k = 0; k < ops; k++)
+            acc += run_op((Op)op, &s[k % (uint64_t)count]);
+
+        uint64_t ns = ai_now_ns() - t0;
+        g_sink += acc;
+
+        double per = (double)ns / (double)ops;
+        fprintf(g_log, "op    %-12s %-9s %10.2f ns/op %12.0f ops/s\n",
+                       g_ops[op].name, g_ops[op].impl, per, per > 0 ? 1e9 / per : 0.0);
+
+        json_sep(j);
+        fprintf(j->f,
+                "{\"name\": \"%s\", \"impl\": \"%s\", \"ops\": %llu, "
+                "\"ns_per_op\": %.3f, \"ops_per_sec\": %.0f}",
+                g_ops[op].name, g_ops[op].impl, (unsigned long long)ops,
+                per, per > 0 ? 1e9 / per : 0.0);
+    }
+}
+
+/* =====================================================
+ *                   Parties aléatoires
+ * ===================================================== */
+static inline uint64_t xorshift(uint64_t *s)
+{
+    *s ^= *s << 13;
+    *s ^= *s >> 7;
+    *s ^= *s << 17;
+    return *s;
+}
+
+static inline int random_pit(int mask, uint64_t *rng)
+{
+    int n = __builtin_popcount((unsigned)mask);
+    for (int skip = (int)(xorshift(rng) % (uint64_t)n); skip > 0; skip--)
+        mask &= mask - 1;
+    return __builtin_ctz((unsigned)mask);
+}
+
+static uint64_t playout_ref(uint64_t *rng)
+{
+    RefPos r;
+    memset(&r, 0, sizeof(r));
+    initGame(r.board);
+    r.p1.number = 1;
+
+    uint64_t plies = 0;
+    while (plies < MAX_PLIES && !isGameOver(r.board, &r.p0.score, &r.p1.score)) {
+        int mask = legalMoves(r.board, r.toMove);
+        if (!mask)
+            break;
+        playMove(r.board, r.toMove, &r.p0, &r.p1, random_pit(mask, rng));
+        r.toMove = 1 - r.toMove;
+        plies++;
+    }
+    return plies;
+}
+
+static uint64_t playout_packed(uint64_t *rng)
+{
+    PackedBoard pb;
+    pbInitGame(&pb);
+
+    uint64_t plies = 0;
+    while (plies < MAX_PLIES && !pbIsGameOver(&pb)) {
+        int mask = pbLegalMoves(&pb, pb.toMove);
+        if (!mask)
+            break;
+        MoveUndo u;
+        makeMove(&pb, random_pit(mask, rng), &u);
+        plies++;
+    }
+    return plies;
+}
+
+static void bench_playouts(Json *j, int games)
+{
+    for (int impl = 0; impl < 2; impl++) {
+        uint64_t rng   = 0x9A3E5EEDULL;
+        uint64_t plies = 0;
+        uint64_t t0    = ai_now_ns();
+
+        for (int g = 0; g < games; g++)
+            plies += impl ? playout_packed(&rng) : playout_ref(&rng);
+
+        uint64_t ns   = ai_now_ns() - t0;
+        double   secs = (double)ns / 1e9;
+        const char *name = impl ? "packed" : "reference";
+
+        fprintf(g_log, "games %-22s %10.0f games/s %8.2f ns/ply (%llu plies)\n",
+                       name, secs > 0 ? games / secs : 0.0,
+                       (double)ns / (double)plies, (unsigned long long)plies);
+
+        json_sep(j);
+        fprintf(j->f,
+                "{\"impl\": \"%s\", \"games\": %d, \"plies\": %llu, "
+                "\"games_per_sec\": %.1f, \"ns_per_ply\": %.3f}",
+                name, games, (unsigned long long)plies,
+                secs > 0 ? games / secs : 0.0, (double)ns / (double)plies);
+    }
+}
+
+/* =====================================================
+ *                         main
+ * ===================================================== */
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [-d depth] [-D saved_depth] [-n positions] [-i ops] "
+            "[-g games] [-s saved_dir] [-o file.json|-]\n", prog);
+}
+
+int main(int argc, char *argv[])
+{
+    int depth        = DEFAULT_DEPTH;
+    int saved_depth  = DEFAULT_SAVED_DEPTH;
+    int count        = DEFAULT_POSITIONS;
+    long long ops    = DEFAULT_OPS;
+    int games        = DEFAULT_GAMES;
+    const char *dir  = "saved_games";
+    const char *path = "bench.json";
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-d") == 0)      depth       = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-D") == 0) saved_depth = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-n") == 0) count       = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-i") == 0) ops         = atoll(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-g") == 0) games       = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) dir         = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "-o") == 0) path        = argv[++i];
+        else { usage(argv[0]); return EXIT_FAILURE; }
+    }
+
+    if (depth < 0 || saved_depth < 0 || count < 1 || ops < 1 || games < 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    PackedBoard *pos    = malloc(SAMPLE_SIZE * sizeof(*pos));
+    Sample      *sample = malloc(SAMPLE_SIZE * sizeof(*sample));
+    if (!pos || !sample)
+        return EXIT_FAILURE;
+
+    /* Positions jouables : une tous les 3 demi-coups des parties enregistrées */
+    int sampled = bench_positions(dir, pos, SAMPLE_SIZE, 3);
+    if (count > sampled)
+        count = sampled;
+    build_samples(sample, pos, sampled);
+
+    /* -o - : JSON sur la sortie standard */
+    int   to_stdout = (strcmp(path, "-") == 0);
+    FILE *out       = to_stdout ? stdout : fopen(path, "w");
+    if (!out) {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+    g_log = to_stdout ? stderr : stdout;
+
+    Json j = { out, 1 };
+    int  status = 0;
+
+    fprintf(out, "{\n  \"bench\": \"engine\",\n  \"timestamp\": %lld,\n"
+                 "  \"sample_positions\": %d,\n  \"perft\": [",
+            (long long)time(NULL), sampled);
+
+    PackedBoard start;
+    pbInitGame(&start);
+    if (bench_perft(&j, "initial", &start, 1, depth) < 0)
+        status = EXIT_FAILURE;
+    if (bench_perft(&j, "saved_games", pos, count, saved_depth) < 0)
+        status = EXIT_FAILURE;
+
+    fprintf(out, "\n  ],\n  \"ops\": [");
+    j.first = 1;
+    bench_ops(&j, sample, sampled, (uint64_t)ops);
+
+    fprintf(out, "\n  ],\n  \"playouts\": [");
+    j.first = 1;
+    bench_playouts(&j, games);
+
+    fprintf(out, "\n  ]\n}\n");
+
+    if (!to_stdout) {
+        fclose(out);
+        printf("Results written to %s\n", path);
+    }
+
+    free(sample);
+    free(pos);
+    return status;
+}
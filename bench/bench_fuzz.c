@@ -0,0 +1,515 @@
+/*************************************************************************
+                           Awale -- Bench (Differential fuzzing)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Compare coup par coup le moteur de référence
+                           (game.c) aux noyaux optimisés : séquences
+                           aléatoires, exhaustives, parties de
+                           saved_games/ et mode débit multi-cœurs
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "bench.h"
+#include "../ai/ai.h"
+
+#define DEFAULT_GAMES      100000
+#define DEFAULT_DEPTH      7
+#define MAX_PLIES          400
+#define BATCH_GAMES        256
+
+/* =====================================================
+ *                 Noyaux comparés
+ * ===================================================== */
+
+/*
+ * Un noyau optimisé joue sur un PackedBoard. exact_codes indique s'il
+ * rend les mêmes codes d'erreur que playMove ; sinon seul « coup
+ * accepté ou non » est comparé. Ajouter un noyau = ajouter une ligne.
+ */
+typedef struct {
+    const char *name;
+    int       (*play)(PackedBoard *pb, int player, int pit);
+    int         exact_codes;
+} Kernel;
+
+static int kernel_pb_play(PackedBoard *pb, int player, int pit)
+{
+    return pbPlayMove(pb, player, pit);
+}
+
+/* makeMove ne valide rien : le masque des coups légaux filtre */
+static int kernel_make_move(PackedBoard *pb, int player, int pit)
+{
+    if (pit < 0 || pit > 11 || !(pbLegalMoves(pb, player) >> pit & 1))
+        return -1;
+
+    PackedBoard before = *pb;
+    MoveUndo u;
+
+    pb->toMove = player;
+    pb->key    = pbComputeKey(pb);
+    makeMove(pb, pit, &u);
+
+    /* Aller-retour : unmakeMove doit rendre la position exacte */
+    PackedBoard back = *pb;
+    unmakeMove(&back, &u);
+    before.toMove = player;
+    before.key    = pbComputeKey(&before);
+    if (memcmp(back.side, before.side, sizeof(back.side)) != 0 ||
+        back.score[0] != before.score[0] || back.score[1] != before.score[1] ||
+        back.seeds[0] != before.seeds[0] || back.seeds[1] != before.seeds[1] ||
+        back.key != before.key || back.toMove != before.toMove)
+        return -2;
+
+    return 0;
+}
+
+static const Kernel g_kernels[] = {
+    { "pbPlayMove",         kernel_pb_play,   1 },
+    { "makeMove/unmakeMove", kernel_make_move, 0 },
+};
+
+#define KERNEL_COUNT ((int)(sizeof(g_kernels) / sizeof(g_kernels[0])))
+
+/* =====================================================
+ *               État comparé après chaque demi-coup
+ * ===================================================== */
+typedef struct {
+    int         board[12];
+    Player      p0, p1;
+    PackedBoard pb[KERNEL_COUNT];
+} Twin;
+
+/* Une seule divergence est décrite, tous threads confondus */
+static pthread_mutex_t g_report_lock = PTHREAD_MUTEX_INITIALIZER;
+static atomic_int      g_failed;
+
+static void twin_init(Twin *t, const int board[12], int s0, int s1)
+{
+    memcpy(t->board, board, sizeof(t->board));
+    memset(&t->p0, 0, sizeof(t->p0));
+    memset(&t->p1, 0, sizeof(t->p1));
+    t->p0.number = 0;
+    t->p1.number = 1;
+    t->p0.score  = s0;
+    t->p1.score  = s1;
+
+    for (int k = 0; k < KERNEL_COUNT; k++)
+        packBoard(&t->pb[k], board, s0, s1);
+}
+
+static void print_board(const char *label, const int board[12], int s0, int s1)
+{
+    fprintf(stderr, "  %-22s", label);
+    for (int i = 0; i < 12; i++)
+        fprintf(stderr, " %2d", board[i]);
+    fprintf(stderr, "  | %d-%d\n", s0, s1);
+}
+
+static int report(const Twin *before, const Twin *t, int k, const char *what,
+                  const char *origin, uint64_t seed, int ply, int player, int pit)
+{
+    pthread_mutex_lock(&g_report_lock);
+    if (!atomic_exchange(&g_failed, 1)) {
+        fprintf(stderr, "MISMATCH (%s) %s: %s, seed %llu ply %d, player %d pit %d\n",
+                what, g_kernels[k].name, origin,
+                (unsigned long long)seed, ply, player, pit);
+        print_board("before", before->board, before->p0.score, before->p1.score);
+        print_board("reference", t->board, t->p0.score, t->p1.score);
+
+        int b[12], s0, s1;
+        unpackBoard(&t->pb[k], b, &s0, &s1);
+        print_board(g_kernels[k].name, b, s0, s1);
+    }
+    pthread_mutex_unlock(&g_report_lock);
+    return -1;
+}
+
+/* Compare le plateau, les scores et la clé d'un noyau à la référence */
+static int same_state(const Twin *t, int k)
+{
+    const PackedBoard *pb = &t->pb[k];
+    int b[12], s0, s1;
+    unpackBoard(pb, b, &s0, &s1);
+
+    int seeds0 = 0, seeds1 = 0;
+    for (int i = 0; i < 6; i++)  seeds0 += b[i];
+    for (int i = 6; i < 12; i++) seeds1 += b[i];
+
+    return memcmp(b, t->board, sizeof(b)) == 0 &&
+           s0 == t->p0.score && s1 == t->p1.score &&
+           pb->seeds[0] == seeds0 && pb->seeds[1] == seeds1 &&
+           pb->key == pbComputeKey(pb);
+}
+
+/*
+ * Joue pit pour player dans la référence et dans chaque noyau, puis
+ * compare : code de retour, plateau, scores, coups légaux suivants et
+ * décision de fin de partie. Retourne le code de la référence (0 si le
+ * coup est joué), 1 si la partie est finie après le coup, -1 si
+ * divergence.
+ */
+static int twin_step(Twin *t, int player, int pit,
+                     const char *origin, uint64_t seed, int ply)
+{
+    Twin before = *t;
+
+    int ref_mask = legalMoves(t->board, player);
+    int rc       = playMove(t->board, player, &t->p0, &t->p1, pit);
+
+    for (int k = 0; k < KERNEL_COUNT; k++) {
+        if (pbLegalMoves(&t->pb[k], player) != ref_mask)
+            return report(&before, t, k, "legal mask", origin, seed, ply, player, pit);
+
+        int krc = g_kernels[k].play(&t->pb[k], player, pit);
+
+        if (krc == -2)
+            return report(&before, t, k, "unmake", origin, seed, ply, player, pit);
+        if (g_kernels[k].exact_codes ? krc != rc : (krc == 0) != (rc == 0))
+            return report(&before, t, k, "return code", origin, seed, ply, player, pit);
+        if (!same_state(t, k))
+            return report(&before, t, k, "board", origin, seed, ply, player, pit);
+    }
+
+    if (rc != 0)
+        return rc;
+
+    /* Fin de partie : même décision et même ramassage des graines */
+    int over = isGameOver(t->board, &t->p0.score, &t->p1.score);
+
+    for (int k = 0; k < KERNEL_COUNT; k++) {
+        if (pbIsGameOver(&t->pb[k]) != over)
+            return report(&before, t, k, "game over", origin, seed, ply, player, pit);
+        if (!same_state(t, k))
+            return report(&before, t, k, "game over board", origin, seed, ply, player, pit);
+    }
+
+    return over ? 1 : 0;
+}
+
+/* =====================================================
+ *                   Séquences aléatoires
+ * ===================================================== */
+static inline uint64_t next_rand(uint64_t *s)
+{
+    uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Plateau quelconque : 48 graines réparties entre cases et scores */
+static void random_start(uint64_t *rng, int board[12], int *s0, int *s1)
+{
+    memset(board, 0, 12 * sizeof(int));
+    *s0 = *s1 = 0;
+
+    int on_board = 1 + (int)(next_rand(rng) % 48);
+    int captured = 48 - on_board;
+
+    *s0 = (int)(next_rand(rng) % (uint64_t)(captured + 1));
+    if (*s0 > 24) *s0 = 24;
+    *s1 = captured - *s0;
+    if (*s1 > 24) {
+        on_board += *s1 - 24;
+        *s1 = 24;
+    }
+
+    /* Quelques cases privilégiées : on obtient des tas et des cases vides */
+    int hot = (int)(next_rand(rng) % 12);
+    for (int s = 0; s < on_board; s++) {
+        int pit = (next_rand(rng) & 3) ? (int)(next_rand(rng) % 12) : hot;
+        board[pit]++;
+    }
+}
+
+/*
+ * Une partie aléatoire. La plupart des coups sont légaux ; un sur huit
+ * est tiré parmi les 12 cases (et parfois hors plateau) pour vérifier
+ * les codes d'erreur. Retourne le nombre de demi-coups, -1 si divergence.
+ */
+static int fuzz_game(uint64_t seed)
+{
+    uint64_t rng = seed;
+    int board[12], s0 = 0, s1 = 0;
+
+    if (next_rand(&rng) & 1) {
+        initGame(board);
+    } else {
+        random_start(&rng, board, &s0, &s1);
+    }
+
+    Twin t;
+    twin_init(&t, board, s0, s1);
+
+    int player = (int)(next_rand(&rng) & 1);
+    int plies  = 0;
+
+    for (int ply = 0; ply < MAX_PLIES; ply++) {
+        int mask = legalMoves(t.board, player);
+        int pit;
+
+        if (!mask || (next_rand(&rng) & 7) == 0) {
+            pit = (int)(next_rand(&rng) % 14) - 1;
+        } else {
+            int n = __builtin_popcount((unsigned)mask);
+            for (int skip = (int)(next_rand(&rng) % (uint64_t)n); skip > 0; skip--)
+                mask &= mask - 1;
+            pit = __builtin_ctz((unsigned)mask);
+        }
+
+        int rc = twin_step(&t, player, pit, "random", seed, ply);
+        if (rc < 0)
+            return -1;
+        plies++;
+
+        if (rc == 1)
+            break;
+        if (rc == 0)
+            player = 1 - player;
+        else if (!mask)
+            break;
+    }
+    return plies;
+}
+
+/* =====================================================
+ *                Séquences exhaustives
+ * ===================================================== */
+
+/* Toutes les cases 0..11 à chaque demi-coup, légales ou non */
+static int exhaustive(const Twin *t, int player, int depth, uint64_t *plies)
+{
+    if (depth == 0)
+        return 0;
+
+    for (int pit = 0; pit < 12; pit++) {
+        Twin next = *t;
+        int rc = twin_step(&next, player, pit, "exhaustive", 0, depth);
+        if (rc < 0)
+            return -1;
+        (*plies)++;
+
+        if (rc == 0 && exhaustive(&next, 1 - player, depth - 1, plies) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+/* =====================================================
+ *                Parties enregistrées
+ * ===================================================== */
+static int replay_saved(const char *dir, int *games, uint64_t *plies)
+{
+    char (*paths)[SAVED_PATH_LEN] = malloc(SAVED_MAX_FILES * sizeof(*paths));
+    SavedGame *g = malloc(sizeof(*g));
+    if (!paths || !g) {
+        free(paths);
+        free(g);
+        return -1;
+    }
+
+    int files  = saved_games_list(dir, paths, SAVED_MAX_FILES);
+    int status = 0;
+    *games = 0;
+
+    for (int fi = 0; fi < files && status == 0; fi++) {
+        if (saved_game_read(paths[fi], g) < 0)
+            continue;
+
+        int board[12];
+        initGame(board);
+
+        Twin t;
+        twin_init(&t, board, 0, 0);
+        (*games)++;
+
+        for (int k = 0; k < g->count; k++) {
+            int rc = twin_step(&t, g->player[k], g->pit[k], paths[fi], 0, k);
+            if (rc < 0) {
+                status = -1;
+                break;
+            }
+            (*plies)++;
+            if (rc == 1)
+                break;
+        }
+    }
+
+    free(paths);
+    free(g);
+    return status;
+}
+
+/* =====================================================
+ *                     Mode débit
+ * ===================================================== */
+typedef struct {
+    uint64_t          seed;
+    int               id;
+    int               threads;
+    uint64_t          max_games;
+    uint64_t          deadline;
+    _Atomic uint64_t *games;
+    _Atomic uint64_t *plies;
+    pthread_t         tid;
+} Worker;
+
+static void *worker_main(void *arg)
+{
+    Worker *w = arg;
+
+    /* Les threads se partagent la suite des graines : partie i = graine + i */
+    for (uint64_t batch = (uint64_t)w->id; !atomic_load(&g_failed); batch += (uint64_t)w->threads) {
+        uint64_t first = batch * BATCH_GAMES;
+        if (w->max_games && first >= w->max_games)
+            break;
+        if (w->deadline && ai_now_ns() >= w->deadline)
+            break;
+
+        uint64_t plies = 0, games = 0;
+        for (uint64_t g = first; g < first + BATCH_GAMES; g++) {
+            if (w->max_games && g >= w->max_games)
+                break;
+            int n = fuzz_game(w->seed + g);
+            if (n < 0)
+                return NULL;
+            plies += (uint64_t)n;
+            games++;
+        }
+
+        atomic_fetch_add(w->games, games);
+        atomic_fetch_add(w->plies, plies);
+    }
+    return NULL;
+}
+
+static int run_random(uint64_t seed, uint64_t games, int seconds, int threads)
+{
+    _Atomic uint64_t done_games = 0, done_plies = 0;
+    uint64_t start = ai_now_ns();
+
+    Worker *w = calloc((size_t)threads, sizeof(*w));
+    if (!w)
+        return -1;
+
+    for (int k = 0; k < threads; k++) {
+        w[k].seed      = seed;
+        w[k].id        = k;
+        w[k].threads   = threads;
+        w[k].max_games = games;
+        w[k].deadline  = seconds ? start + (uint64_t)seconds * 1000000000ULL : 0;
+        w[k].games     = &done_games;
+        w[k].plies     = &done_plies;
+        pthread_create(&w[k].tid, NULL, worker_main, &w[k]);
+    }
+
+    /* Progression toutes les 10 s en mode débit */
+    if (seconds) {
+        for (;;) {
+            struct timespec ts = { 1, 0 };
+            nanosleep(&ts, NULL);
+
+            uint64_t now = ai_now_ns();
+            if (atomic_load(&g_failed) || now >= w[0].deadline)
+                break;
+            if (((now - start) / 1000000000ULL) % 10 == 0) {
+                double secs = (double)(now - start) / 1e9;
+                printf("  %6.0fs  %14llu plies  %10.2f Mplies/s\n", secs,
+                       (unsigned long long)atomic_load(&done_plies),
+                       (double)atomic_load(&done_plies) / secs / 1e6);
+                fflush(stdout);
+            }
+        }
+    }
+
+    for (int k = 0; k < threads; k++)
+        pthread_join(w[k].tid, NULL);
+    free(w);
+
+    double secs = (double)(ai_now_ns() - start) / 1e9;
+    printf("random      %12llu games %14llu plies  %8.2f Mplies/s on %d threads  %s\n",
+           (unsigned long long)atomic_load(&done_games),
+           (unsigned long long)atomic_load(&done_plies),
+           secs > 0 ? (double)atomic_load(&done_plies) / secs / 1e6 : 0.0,
+           threads, atomic_load(&g_failed) ? "FAILED" : "ok");
+
+    return atomic_load(&g_failed) ? -1 : 0;
+}
+
+/* =====================================================
+ *                         main
+ * ===================================================== */
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [-g games] [-d depth] [-S seed] [-s saved_dir] "
+            "[-t threads] [-T seconds]\n"
+            "  -T : mode débit, parties aléatoires sur -t threads pendant T secondes\n",
+            prog);
+}
+
+int main(int argc, char *argv[])
+{
+    long long games  = DEFAULT_GAMES;
+    int depth        = DEFAULT_DEPTH;
+    uint64_t seed    = 1;
+    const char *dir  = "saved_games";
+    int threads      = 1;
+    int seconds      = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-g") == 0)      games   = atoll(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-d") == 0) depth   = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-S") == 0) seed    = strtoull(argv[++i], NULL, 0);
+        else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) dir     = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "-t") == 0) threads = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-T") == 0) seconds = atoi(argv[++i]);
+        else { usage(argv[0]); return EXIT_FAILURE; }
+    }
+
+    if (games < 0 || depth < 0 || threads < 0 || seconds < 0) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (threads == 0)
+        threads = ai_default_threads();
+
+    /* Mode débit : seulement les parties aléatoires, sans limite de nombre */
+    if (seconds)
+        return run_random(seed, 0, seconds, threads) < 0 ? EXIT_FAILURE : 0;
+
+    int saved = 0;
+    uint64_t plies = 0;
+    if (replay_saved(dir, &saved, &plies) < 0)
+        return EXIT_FAILURE;
+    printf("saved_games %12d games %14llu plies  ok\n",
+           saved, (unsigned long long)plies);
+
+    int start[12];
+    initGame(start);
+    Twin t;
+    twin_init(&t, start, 0, 0);
+
+    plies = 0;
+    for (int player = 0; player < 2; player++)
+        if (exhaustive(&t, player, depth, &plies) < 0)
+            return EXIT_FAILURE;
+    printf("exhaustive  %12d depth %14llu plies  ok\n",
+           depth, (unsigned long long)plies);
+
+    if (games && run_random(seed, (uint64_t)games, 0, threads) < 0)
+        return EXIT_FAILURE;
+
+    return 0;
+}
@@ -0,0 +1,487 @@
+/*************************************************************************
+                           Awale -- Bench (Load generator)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Charge réseau pour comparer les boucles
+                           d'événements du serveur : connexions inactives
+                           en masse et clients actifs en ping-pong,
+                           éventuellement en rafales, répartis sur
+                           plusieurs threads (latence p50/p99, requêtes/s),
+                           ou connectés et envoyant une commande donnée ;
+                           appels système du serveur par requête (-S)
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+
+#define DEFAULT_PORT      4444
+#define DEFAULT_IDLE      1000
+#define DEFAULT_ACTIVE    16
+#define DEFAULT_SECONDS   5
+#define MAX_EVENTS        256
+#define MAX_PIPELINE      256
+#define MAX_THREADS       64
+
+/*
+ * Tant qu'il n'est pas connecté, le serveur répond à une ligne vide par
+ * « Enter your username : » : c'est la requête la plus légère possible,
+ * elle ne mesure que la boucle d'événements.
+ */
+static const char PING[] = "\n";
+
+typedef struct {
+    int      fd;
+    int      ready;     /* invite initiale reçue */
+    int      pending;   /* réponses attendues pour la rafale en vol */
+    uint64_t sent_ns;   /* 0 = aucune rafale en vol */
+} Conn;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile_us(const uint64_t *v, size_t n, double p)
+{
+    if (n == 0)
+        return 0.0;
+    size_t k = (size_t)(p * (double)(n - 1) + 0.5);
+    return (double)v[k] / 1000.0;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [-H host] [-p port] [-i idle] [-a active] [-P depth] [-s seconds] [-T threads] [-c command] [-S]\n"
+            "  -i  connexions ouvertes puis laissées inactives (defaut %d)\n"
+            "  -a  clients en ping-pong continu (defaut %d)\n"
+            "  -P  requêtes envoyées d'un bloc par client (defaut 1, max %d)\n"
+            "  -s  durée de la mesure en secondes (defaut %d)\n"
+            "  -T  threads se partageant les clients actifs (defaut 1, max %d)\n"
+            "  -c  clients connectés (lgN / pw) envoyant cette commande, qui doit\n"
+            "      produire une ligne de réponse (STATS, MOVE 0, verbe inconnu...)\n"
+            "  -S  appels système du serveur par requête (loop_syscalls de STATS)\n",
+            prog, DEFAULT_IDLE, DEFAULT_ACTIVE, MAX_PIPELINE, DEFAULT_SECONDS,
+            MAX_THREADS);
+}
+
+/* Connexion bloquante ; -1 si refusée */
+static int open_conn(const struct sockaddr_in *addr)
+{
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+
+    if (connect(fd, (const struct sockaddr *)addr, sizeof(*addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* Lit n lignes (bloquant) ; la dernière est gardée dans last */
+static int read_lines(int fd, int n, char *last, size_t cap)
+{
+    size_t len = 0;
+    while (n > 0) {
+        char ch;
+        if (recv(fd, &ch, 1, 0) != 1)
+            return -1;
+        if (ch == '\n') {
+            n--;
+            if (n > 0)
+                len = 0;
+        } else if (len + 1 < cap) {
+            last[len++] = ch;
+        }
+    }
+    last[len] = '\0';
+    return 0;
+}
+
+/* Connexion du client lg<id> (compte créé au premier passage) */
+static int login(int fd, int id)
+{
+    char line[256];
+    char name[32];
+    snprintf(name, sizeof(name), "lg%d\n", id);
+
+    if (read_lines(fd, 1, line, sizeof(line)) < 0 ||
+        send(fd, name, strlen(name), MSG_NOSIGNAL) < 0 ||
+        read_lines(fd, 2, line, sizeof(line)) < 0 ||
+        send(fd, "pw\n", 3, MSG_NOSIGNAL) < 0 ||
+        read_lines(fd, 1, line, sizeof(line)) < 0)
+        return -1;
+
+    if (strncmp(line, "ERROR", 5) == 0) {
+        fprintf(stderr, "login lg%d: %s\n", id, line);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Compteur loop_syscalls du serveur, lu par STATS sur la connexion fd
+ * (déjà connectée) ; -1 si la réponse n'en contient pas.
+ */
+static long long server_syscalls(int fd)
+{
+    char line[512];
+
+    if (send(fd, "STATS\n", 6, MSG_NOSIGNAL) < 0 ||
+        read_lines(fd, 1, line, sizeof(line)) < 0)
+        return -1;
+
+    const char *p = strstr(line, "loop_syscalls=");
+    return p ? atoll(p + strlen("loop_syscalls=")) : -1;
+}
+
+/* =====================================================
+ *                   Clients actifs
+ * ===================================================== */
+
+/*
+ * Chaque thread mène sa part des clients actifs avec son propre epoll ;
+ * les résultats sont fusionnés à la fin. Un seul thread ne suffit plus
+ * à saturer un serveur qui en a plusieurs.
+ */
+typedef struct {
+    const struct sockaddr_in *addr;
+    Conn     *conns;
+    int       count;
+    int       depth;
+    int       base;     /* numéro du premier client (pseudo lg<n>) */
+    const char *command;
+    uint64_t  end;
+    uint64_t *samples;
+    size_t    nsamples;
+    size_t    cap;
+    size_t    replies;
+    int       refused;
+    int       failed;
+} Worker;
+
+static void *worker_run(void *arg)
+{
+    Worker *w = arg;
+
+    int ep = epoll_create1(EPOLL_CLOEXEC);
+    if (ep < 0) {
+        perror("epoll_create1");
+        w->failed = 1;
+        return NULL;
+    }
+
+    /* Une rafale : depth requêtes en un seul send */
+    size_t reqlen = w->command ? strlen(w->command) + 1 : 1;
+    size_t blen   = reqlen * (size_t)w->depth;
+    char  *burst  = malloc(blen);
+    if (!burst) {
+        perror("malloc");
+        close(ep);
+        w->failed = 1;
+        return NULL;
+    }
+    for (int d = 0; d < w->depth; d++) {
+        char *q = burst + (size_t)d * reqlen;
+        if (w->command)
+            memcpy(q, w->command, reqlen - 1);
+        q[reqlen - 1] = PING[0];
+    }
+
+    int live = 0;
+    for (int k = 0; k < w->count; k++) {
+        Conn *c = &w->conns[k];
+        c->fd = open_conn(w->addr);
+        if (c->fd < 0) {
+            fprintf(stderr, "connect: %s\n", strerror(errno));
+            w->failed = 1;
+            break;
+        }
+
+        /* Connecté : la première rafale part tout de suite */
+        if (w->command) {
+            if (login(c->fd, w->base + k) < 0) {
+                w->failed = 1;
+                break;
+            }
+            c->ready   = 1;
+            c->pending = w->depth;
+            send(c->fd, burst, blen, MSG_NOSIGNAL);
+            c->sent_ns = now_ns();
+        } else {
+            c->pending = 1;     /* invite de connexion */
+        }
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events   = EPOLLIN;
+        ev.data.ptr = c;
+        epoll_ctl(ep, EPOLL_CTL_ADD, c->fd, &ev);
+        live++;
+    }
+
+    struct epoll_event events[MAX_EVENTS];
+
+    while (live > 0 && !w->failed) {
+        uint64_t now = now_ns();
+        if (now >= w->end)
+            break;
+
+        int timeout_ms = (int)((w->end - now) / 1000000ull) + 1;
+        int n = epoll_wait(ep, events, MAX_EVENTS, timeout_ms);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("epoll_wait");
+            break;
+        }
+
+        for (int e = 0; e < n; e++) {
+            Conn *c = events[e].data.ptr;
+            char  buf[512];
+            ssize_t r = recv(c->fd, buf, sizeof(buf), 0);
+
+            if (r <= 0 || (r >= 11 && memcmp(buf, "Server full", 11) == 0)) {
+                if (!c->ready)
+                    w->refused++;
+                epoll_ctl(ep, EPOLL_CTL_DEL, c->fd, NULL);
+                close(c->fd);
+                c->fd = -1;
+                live--;
+                continue;
+            }
+
+            /* Chaque requête appelle une ligne de réponse */
+            for (ssize_t k = 0; k < r; k++)
+                if (buf[k] == '\n')
+                    c->pending--;
+
+            if (c->pending > 0)
+                continue;
+
+            uint64_t t = now_ns();
+            if (c->sent_ns) {
+                w->replies += (size_t)w->depth;
+                if (w->nsamples == w->cap) {
+                    size_t    cap   = w->cap ? w->cap * 2 : 1 << 16;
+                    uint64_t *grown = realloc(w->samples, cap * sizeof(uint64_t));
+                    if (!grown) {
+                        perror("realloc");
+                        w->failed = 1;
+                        break;
+                    }
+                    w->samples = grown;
+                    w->cap     = cap;
+                }
+                w->samples[w->nsamples++] = t - c->sent_ns;
+            }
+            c->ready = 1;
+
+            c->pending = w->depth;
+            if (send(c->fd, burst, blen, MSG_NOSIGNAL) < 0) {
+                epoll_ctl(ep, EPOLL_CTL_DEL, c->fd, NULL);
+                close(c->fd);
+                c->fd = -1;
+                live--;
+                continue;
+            }
+            c->sent_ns = now_ns();
+        }
+    }
+
+    for (int k = 0; k < w->count; k++)
+        if (w->conns[k].fd >= 0)
+            close(w->conns[k].fd);
+    close(ep);
+    free(burst);
+    return NULL;
+}
+
+/* =====================================================
+ *                         Main
+ * ===================================================== */
+int main(int argc, char *argv[])
+{
+    const char *host    = "127.0.0.1";
+    int         port    = DEFAULT_PORT;
+    int         idle    = DEFAULT_IDLE;
+    int         active  = DEFAULT_ACTIVE;
+    int         seconds = DEFAULT_SECONDS;
+    int         depth   = 1;
+    int         threads = 1;
+    const char *command = NULL;
+    int         syscalls = 0;
+    int         opt;
+
+    while ((opt = getopt(argc, argv, "H:p:i:a:P:s:T:c:S")) != -1) {
+        switch (opt) {
+            case 'H': host    = optarg;       break;
+            case 'p': port    = atoi(optarg); break;
+            case 'i': idle    = atoi(optarg); break;
+            case 'a': active  = atoi(optarg); break;
+            case 'P': depth   = atoi(optarg); break;
+            case 's': seconds = atoi(optarg); break;
+            case 'T': threads = atoi(optarg); break;
+            case 'c': command = optarg;       break;
+            case 'S': syscalls = 1;           break;
+            default:  usage(argv[0]);         return EXIT_FAILURE;
+        }
+    }
+    if (port <= 0 || port > 65535 || idle < 0 || active < 1 || seconds < 1 ||
+        depth < 1 || depth > MAX_PIPELINE || threads < 1 || threads > MAX_THREADS) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (threads > active)
+        threads = active;
+
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+        rl.rlim_cur = rl.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &rl);
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port   = htons((uint16_t)port);
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) {
+        fprintf(stderr, "ERROR : invalid host %s\n", host);
+        return EXIT_FAILURE;
+    }
+
+    /* ---------- Connexions inactives ---------- */
+    int *idle_fd = calloc((size_t)idle + 1, sizeof(int));
+    Conn *conns  = calloc((size_t)active, sizeof(Conn));
+    if (!idle_fd || !conns) {
+        perror("calloc");
+        return EXIT_FAILURE;
+    }
+
+    int opened = 0;
+    uint64_t t0 = now_ns();
+    for (int k = 0; k < idle; k++) {
+        int fd = open_conn(&addr);
+        if (fd < 0) {
+            fprintf(stderr, "connect: %s (after %d idle)\n", strerror(errno), opened);
+            break;
+        }
+        idle_fd[opened++] = fd;
+    }
+    printf("idle connections : %d opened in %.1f ms\n",
+           opened, (double)(now_ns() - t0) / 1e6);
+
+    /* Connexion à part (lg<active>) qui relève le compteur avant et après */
+    int       stats_fd = -1;
+    long long sys0     = -1;
+    if (syscalls) {
+        stats_fd = open_conn(&addr);
+        if (stats_fd < 0 || login(stats_fd, active) < 0 ||
+            (sys0 = server_syscalls(stats_fd)) < 0)
+            fprintf(stderr, "WARNING : server syscalls unavailable\n");
+    }
+
+    /* ---------- Clients actifs, répartis entre les threads ---------- */
+    Worker    workers[MAX_THREADS];
+    pthread_t tids[MAX_THREADS];
+    uint64_t  start = now_ns();
+    uint64_t  end   = start + (uint64_t)seconds * 1000000000ull;
+
+    for (int t = 0; t < threads; t++) {
+        int from = (int)((long)active * t / threads);
+        int to   = (int)((long)active * (t + 1) / threads);
+
+        memset(&workers[t], 0, sizeof(Worker));
+        workers[t].addr    = &addr;
+        workers[t].conns   = conns + from;
+        workers[t].count   = to - from;
+        workers[t].depth   = depth;
+        workers[t].base    = from;
+        workers[t].command = command;
+        workers[t].end     = end;
+
+        for (int k = from; k < to; k++)
+            conns[k].fd = -1;
+
+        if (pthread_create(&tids[t], NULL, worker_run, &workers[t]) != 0) {
+            perror("pthread_create");
+            return EXIT_FAILURE;
+        }
+    }
+
+    size_t replies = 0, count = 0;
+    int    refused = 0, failed = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+        replies += workers[t].replies;
+        count   += workers[t].nsamples;
+        refused += workers[t].refused;
+        failed  |= workers[t].failed;
+    }
+
+    double elapsed = (double)(now_ns() - start) / 1e9;
+
+    long long sys1 = (sys0 >= 0) ? server_syscalls(stats_fd) : -1;
+    if (stats_fd >= 0)
+        close(stats_fd);
+
+    uint64_t *samples = malloc((count ? count : 1) * sizeof(uint64_t));
+    if (!samples) {
+        perror("malloc");
+        return EXIT_FAILURE;
+    }
+    count = 0;
+    for (int t = 0; t < threads; t++) {
+        if (workers[t].nsamples)
+            memcpy(samples + count, workers[t].samples,
+                   workers[t].nsamples * sizeof(uint64_t));
+        count += workers[t].nsamples;
+        free(workers[t].samples);
+    }
+    qsort(samples, count, sizeof(uint64_t), cmp_u64);
+
+    printf("active clients   : %d (%d refused) on %d thread%s\n",
+           active - refused, refused, threads, threads > 1 ? "s" : "");
+    printf("requests         : %zu in %.2f s (%d per burst)\n", replies, elapsed, depth);
+    printf("throughput       : %.0f req/s\n", (double)replies / elapsed);
+    printf("burst latency    : p50 %.1f us  p99 %.1f us  max %.1f us\n",
+           percentile_us(samples, count, 0.50),
+           percentile_us(samples, count, 0.99),
+           count ? (double)samples[count - 1] / 1000.0 : 0.0);
+    if (sys1 >= 0)
+        printf("server syscalls  : %lld (%.2f per request)\n", sys1 - sys0,
+               replies ? (double)(sys1 - sys0) / (double)replies : 0.0);
+
+    for (int k = 0; k < opened; k++)
+        close(idle_fd[k]);
+
+    free(samples);
+    free(conns);
+    free(idle_fd);
+    return failed ? EXIT_FAILURE : 0;
+}
@@ -0,0 +1,166 @@
+/*************************************************************************
+                           Awale -- Bench (Positions)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Relecture des journaux de saved_games/ et
+                           jeu de positions reproductible pour les mesures
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <dirent.h>
+
+#include "bench.h"
+
+/* =====================================================
+ *              Lecture d'un journal de partie
+ * ===================================================== */
+int saved_game_read(const char *path, SavedGame *g)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return -1;
+
+    memset(g, 0, sizeof(*g));
+
+    char line[256];
+    int  started = 0;
+
+    while (fgets(line, sizeof(line), f)) {
+        char name[16];
+        int  pit;
+
+        if (sscanf(line, "GAME_START %15s vs %15s", g->p0, g->p1) == 2) {
+            started = 1;
+            continue;
+        }
+
+        if (!started || g->count >= SAVED_MAX_MOVES)
+            continue;
+
+        if (sscanf(line, "%15s MOVE %d", name, &pit) == 2) {
+            g->player[g->count] = (strcasecmp(name, g->p0) == 0) ? 0 : 1;
+            g->pit[g->count]    = pit;
+            g->count++;
+        }
+    }
+
+    fclose(f);
+    return started ? 0 : -1;
+}
+
+static int cmp_paths(const void *a, const void *b)
+{
+    return strcmp((const char *)a, (const char *)b);
+}
+
+int saved_games_list(const char *dir, char paths[][SAVED_PATH_LEN], int max)
+{
+    DIR *d = opendir(dir);
+    if (!d)
+        return 0;
+
+    int n = 0;
+    struct dirent *e;
+
+    while (n < max && (e = readdir(d)) != NULL) {
+        size_t len = strlen(e->d_name);
+        if (len < 4 || strcmp(e->d_name + len - 4, ".txt") != 0)
+            continue;
+        snprintf(paths[n++], SAVED_PATH_LEN, "%s/%s", dir, e->d_name);
+    }
+
+    closedir(d);
+    qsort(paths, (size_t)n, SAVED_PATH_LEN, cmp_paths);
+    return n;
+}
+
+/* =====================================================
+ *                  Jeu de positions
+ * ===================================================== */
+
+/* xorshift64 : suite identique à chaque lancement */
+static uint64_t next_rand(uint64_t *s)
+{
+    *s ^= *s << 13;
+    *s ^= *s >> 7;
+    *s ^= *s << 17;
+    return *s;
+}
+
+static int pick_move(int mask, uint64_t *rng)
+{
+    int moves[12], n = 0;
+    while (mask) {
+        moves[n++] = __builtin_ctz(mask);
+        mask &= mask - 1;
+    }
+    return moves[next_rand(rng) % (uint64_t)n];
+}
+
+/* Position jouable (partie non finie, au moins un coup légal) */
+static int is_playable(const PackedBoard *pb)
+{
+    PackedBoard tmp = *pb;
+    return !pbIsGameOver(&tmp) && pbLegalMoves(pb, pb->toMove) != 0;
+}
+
+int bench_positions(const char *dir, PackedBoard *out, int max, int every)
+{
+    int n = 0;
+    if (every < 1)
+        every = 1;
+
+    char (*paths)[SAVED_PATH_LEN] = malloc(SAVED_MAX_FILES * sizeof(*paths));
+    SavedGame *g = malloc(sizeof(*g));
+
+    int files = (paths && g && dir) ? saved_games_list(dir, paths, SAVED_MAX_FILES) : 0;
+
+    for (int fi = 0; fi < files && n < max; fi++) {
+        if (saved_game_read(paths[fi], g) < 0)
+            continue;
+
+        PackedBoard pb;
+        pbInitGame(&pb);
+
+        for (int k = 0; k < g->count && n < max; k++) {
+            pb.toMove = g->player[k];
+            pb.key    = pbComputeKey(&pb);
+
+            if (k % every == 0 && is_playable(&pb))
+                out[n++] = pb;
+
+            if (pbPlayMove(&pb, g->player[k], g->pit[k]) != 0)
+                break;
+        }
+    }
+
+    free(paths);
+    free(g);
+
+    /* Complément : parties aléatoires à graine fixe */
+    uint64_t rng = 0x5EED5EED5EEDULL;
+
+    while (n < max) {
+        PackedBoard pb;
+        pbInitGame(&pb);
+        pb.toMove = (int)(next_rand(&rng) & 1);
+        pb.key    = pbComputeKey(&pb);
+
+        for (int ply = 0; n < max && is_playable(&pb); ply++) {
+            if (ply % every == 0)
+                out[n++] = pb;
+
+            MoveUndo u;
+            makeMove(&pb, pick_move(pbLegalMoves(&pb, pb.toMove), &rng), &u);
+        }
+    }
+
+    return n;
+}
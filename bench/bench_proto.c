@@ -0,0 +1,429 @@
+/*************************************************************************
+                           Awale -- Bench (Protocol)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Compare le protocole texte et les trames
+                           binaires : octets par message, temps d'encodage
+                           (snprintf contre proto_*) et de décodage
+                           (sscanf contre proto_next / proto_decode) ;
+                           plateaux complets contre BOARD_DELTA sur des
+                           parties aléatoires. Avec -p, vérifie qu'une
+                           connexion en trames reste lisible quand un
+                           serveur lancé refuse ses commandes (débit)
+*************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#include "../proto/proto.h"
+#include "../game/game.h"
+
+#define DEFAULT_ITERATIONS  2000000
+#define DEFAULT_GAMES       2000
+#define MAX_PLIES           400
+#define SAMPLES             64
+#define THROTTLE_BURST      64          /* SAY envoyés d'un bloc */
+#define THROTTLE_IDLE_MS    1500        /* fin de lecture, seaux remplis */
+
+/* Empêche le compilateur de supprimer les boucles mesurées */
+static volatile unsigned g_sink;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * Plateaux de test variés (graines entre 0 et 48), pour que les
+ * conversions ne portent pas toujours sur les mêmes chiffres.
+ */
+static void sample_boards(int pits[SAMPLES][12], int scores[SAMPLES][2])
+{
+    unsigned x = 2463534242u;
+
+    for (int s = 0; s < SAMPLES; s++) {
+        for (int k = 0; k < 12; k++) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            pits[s][k] = (int)(x % 12);
+        }
+        scores[s][0] = (int)(x % 25);
+        scores[s][1] = (int)((x >> 8) % 25);
+    }
+}
+
+/* Résultat d'une mesure : octets par message et ns par opération */
+static void report(const char *name, size_t bytes, uint64_t enc_ns,
+                   uint64_t dec_ns, long iterations)
+{
+    printf("%-18s %8zu %12.1f %12.1f\n", name, bytes,
+           (double)enc_ns / (double)iterations,
+           (double)dec_ns / (double)iterations);
+}
+
+/* =====================================================
+ *                       BOARD
+ * ===================================================== */
+static void bench_board_text(long iterations, int pits[SAMPLES][12],
+                             int scores[SAMPLES][2])
+{
+    char   lines[SAMPLES][128];
+    size_t bytes = 0;
+
+    uint64_t t0 = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        int s = (int)(i % SAMPLES);
+        const int *p = pits[s];
+        int n = snprintf(lines[s], sizeof(lines[s]),
+                         "BOARD %d %d %d %d %d %d %d %d %d %d %d %d | Scores: %d-%d | Next: %d\n",
+                         p[0], p[1], p[2], p[3], p[4], p[5],
+                         p[6], p[7], p[8], p[9], p[10], p[11],
+                         scores[s][0], scores[s][1], s & 1);
+        bytes += (size_t)n;
+    }
+    uint64_t t1 = now_ns();
+
+    for (long i = 0; i < iterations; i++) {
+        int p[12], s0, s1, next;
+        sscanf(lines[i % SAMPLES],
+               "BOARD %d %d %d %d %d %d %d %d %d %d %d %d | Scores: %d-%d | Next: %d",
+               &p[0], &p[1], &p[2], &p[3], &p[4], &p[5],
+               &p[6], &p[7], &p[8], &p[9], &p[10], &p[11],
+               &s0, &s1, &next);
+        g_sink += (unsigned)(p[(i % 12)] + s0 + next);
+    }
+    uint64_t t2 = now_ns();
+
+    report("board/text", bytes / (size_t)iterations, t1 - t0, t2 - t1, iterations);
+}
+
+static void bench_board_bin(long iterations, int pits[SAMPLES][12],
+                            int scores[SAMPLES][2])
+{
+    uint8_t frames[SAMPLES][PROTO_BOARD_FRAME];
+    size_t  bytes = 0;
+
+    uint64_t t0 = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        int s = (int)(i % SAMPLES);
+        bytes += proto_board(frames[s], pits[s], scores[s][0], scores[s][1], s & 1,
+                             (unsigned)i, NULL);
+    }
+    uint64_t t1 = now_ns();
+
+    for (long i = 0; i < iterations; i++) {
+        ProtoFrame f;
+        ProtoMsg   msg;
+        if (proto_next(frames[i % SAMPLES], PROTO_BOARD_FRAME, &f) > 0 &&
+            proto_decode(&f, &msg) == 0)
+            g_sink += (unsigned)(msg.pits[i % 12] + msg.scores[0] + msg.next);
+    }
+    uint64_t t2 = now_ns();
+
+    report("board/binary", bytes / (size_t)iterations, t1 - t0, t2 - t1, iterations);
+}
+
+/* =====================================================
+ *                     GAME_START
+ * ===================================================== */
+static const char *const g_names[4] = { "alice", "bob", "mohammed", "dame" };
+
+static void bench_start_text(long iterations)
+{
+    char   lines[SAMPLES][64];
+    size_t bytes = 0;
+
+    uint64_t t0 = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        int s = (int)(i % SAMPLES);
+        int n = snprintf(lines[s], sizeof(lines[s]), "GAME_START %s vs %s\n",
+                         g_names[s & 3], g_names[(s + 1) & 3]);
+        bytes += (size_t)n;
+    }
+    uint64_t t1 = now_ns();
+
+    for (long i = 0; i < iterations; i++) {
+        char p0[16], p1[16];
+        if (sscanf(lines[i % SAMPLES], "GAME_START %15s vs %15s", p0, p1) == 2)
+            g_sink += (unsigned)(p0[0] + p1[0]);
+    }
+    uint64_t t2 = now_ns();
+
+    report("game_start/text", bytes / (size_t)iterations, t1 - t0, t2 - t1, iterations);
+}
+
+static void bench_start_bin(long iterations)
+{
+    uint8_t frames[SAMPLES][PROTO_GAME_START_FRAME];
+    size_t  bytes = 0;
+
+    uint64_t t0 = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        int s = (int)(i % SAMPLES);
+        bytes += proto_game_start(frames[s], g_names[s & 3], g_names[(s + 1) & 3]);
+    }
+    uint64_t t1 = now_ns();
+
+    for (long i = 0; i < iterations; i++) {
+        ProtoFrame f;
+        ProtoMsg   msg;
+        if (proto_next(frames[i % SAMPLES], PROTO_GAME_START_FRAME, &f) > 0 &&
+            proto_decode(&f, &msg) == 0)
+            g_sink += (unsigned)(msg.names[0][0] + msg.names[1][0]);
+    }
+    uint64_t t2 = now_ns();
+
+    report("game_start/binary", bytes / (size_t)iterations, t1 - t0, t2 - t1, iterations);
+}
+
+/* =====================================================
+ *          Parties aléatoires : complet ou BOARD_DELTA
+ * ===================================================== */
+
+/*
+ * Plateaux envoyés à un observateur pendant une partie : chaque coup
+ * donne un plateau complet ou un différentiel (le premier plateau est
+ * toujours complet). Mesure les octets par plateau des quatre formes et
+ * le coût de l'encodage et de la lecture d'un BOARD_DELTA en texte.
+ */
+static void bench_stream(int games)
+{
+    uint64_t bytes[4] = { 0, 0, 0, 0 };   /* texte, trame ; complet, delta */
+    uint64_t boards   = 0;
+    uint64_t enc_ns   = 0;
+    uint64_t dec_ns   = 0;
+    unsigned x        = 88172645u;
+
+    for (int n = 0; n < games; n++) {
+        PackedBoard pb;
+        pbInitGame(&pb);
+
+        int pits[12], scores[2], old_pits[12], old_scores[2];
+        int player = n & 1;
+
+        for (int k = 0; k < 12; k++)
+            old_pits[k] = pbPit(&pb, k);
+        old_scores[0] = old_scores[1] = 0;
+
+        for (int ply = 0; ply < MAX_PLIES && !pbIsGameOver(&pb); ply++) {
+            int legal = pbLegalMoves(&pb, player);
+            if (!legal)
+                break;
+
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            for (int skip = (int)(x % (unsigned)__builtin_popcount((unsigned)legal));
+                 skip > 0; skip--)
+                legal &= legal - 1;
+
+            pbPlayMove(&pb, player, __builtin_ctz((unsigned)legal));
+            player ^= 1;
+
+            for (int k = 0; k < 12; k++)
+                pits[k] = pbPit(&pb, k);
+            scores[0] = pb.score[0];
+            scores[1] = pb.score[1];
+
+            unsigned seq  = (unsigned)ply + 1;
+            unsigned mask = proto_delta_mask(old_pits, old_scores, pits, scores);
+            char     line[PROTO_BOARD_LINE];
+            uint8_t  frame[PROTO_DELTA_MAX_FRAME];
+
+            size_t full = proto_board_line(line, pits, scores[0], scores[1], player, seq, NULL);
+            bytes[0] += full;
+            bytes[2] += proto_board(frame, pits, scores[0], scores[1], player, seq, NULL);
+            bytes[3] += (ply == 0) ? PROTO_BOARD_FRAME
+                : proto_board_delta(frame, seq, player, mask, pits, scores[0], scores[1],
+                                    NULL);
+
+            uint64_t t0 = now_ns();
+            size_t   len = proto_delta_line(line, seq, player, mask, pits,
+                                            scores[0], scores[1], NULL);
+            uint64_t t1 = now_ns();
+
+            line[len - 1] = '\0';
+            ProtoMsg msg;
+            if (proto_parse_delta(line, &msg) == 0)
+                g_sink += msg.mask;
+            uint64_t t2 = now_ns();
+
+            if (ply == 0) {
+                bytes[1] += full;
+            } else {
+                bytes[1] += len;
+                enc_ns   += t1 - t0;
+                dec_ns   += t2 - t1;
+            }
+
+            memcpy(old_pits, pits, sizeof(pits));
+            memcpy(old_scores, scores, sizeof(scores));
+            boards++;
+        }
+    }
+
+    if (boards == 0)
+        return;
+
+    printf("\nBoard stream: %d random games, %llu boards\n",
+           games, (unsigned long long)boards);
+    printf("%-18s %12s %12s %10s\n", "form", "full (B)", "delta (B)", "saved");
+    for (int k = 0; k < 2; k++)
+        printf("%-18s %12.1f %12.1f %9.1f%%\n", k ? "binary" : "text",
+               (double)bytes[2 * k] / (double)boards,
+               (double)bytes[2 * k + 1] / (double)boards,
+               100.0 * (1.0 - (double)bytes[2 * k + 1] / (double)bytes[2 * k]));
+    printf("delta/text encode %.1f ns, parse %.1f ns (timer included)\n",
+           (double)enc_ns / (double)boards, (double)dec_ns / (double)boards);
+}
+
+/* =====================================================
+ *          Connexion en trames limitée par le serveur
+ * ===================================================== */
+
+/* Messages reçus : refus de débit, réponse à LIST */
+typedef struct {
+    int refused;
+    int listed;
+} Throttle;
+
+static int throttle_msg(void *ctx, const ProtoMsg *msg)
+{
+    Throttle *t = ctx;
+
+    if (msg->op != PROTO_OP_TEXT)
+        return 1;
+    if (strstr(msg->text, "Too many commands") || strstr(msg->text, "Server busy"))
+        t->refused++;
+    if (strncmp(msg->text, "ONLINE", 6) == 0)
+        t->listed++;
+    return 1;
+}
+
+/*
+ * Lit jusqu'à THROTTLE_IDLE_MS sans données (0), ou -1 si le flux
+ * n'est plus découpable en trames ou si la connexion est fermée.
+ */
+static int throttle_read(ProtoConn *pc, Throttle *t)
+{
+    for (;;) {
+        errno = 0;
+        int rc = proto_conn_read(pc, throttle_msg, t);
+        if (rc < 0)
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+}
+
+/*
+ * Serveur lancé sur host:port : connexion HELLO BIN1, rafale de SAY
+ * au-delà du débit de chat, puis LIST une fois les seaux remplis. Les
+ * refus doivent arriver en trames TEXT, et LIST être lu ensuite.
+ */
+static int check_throttle(const char *host, int port)
+{
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port   = htons((uint16_t)port);
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) {
+        fprintf(stderr, "ERROR : invalid host %s\n", host);
+        return -1;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (const struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror("connect");
+        return -1;
+    }
+
+    struct timeval tv = { THROTTLE_IDLE_MS / 1000, (THROTTLE_IDLE_MS % 1000) * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    ProtoConn pc;
+    Throttle  t = { 0, 0 };
+    char      name[16];
+    snprintf(name, sizeof(name), "bp%d", (int)(getpid() % 100000));
+
+    int ok = proto_conn_init(&pc, fd, PROTO_WANT_BIN) == 0 &&
+             proto_conn_send(&pc, name) == 0 &&
+             proto_conn_send(&pc, "pw") == 0;
+
+    /* Réponse à HELLO d'abord : la rafale part directement en trames */
+    while (ok && pc.pending)
+        ok = proto_conn_read(&pc, throttle_msg, &t) > 0;
+
+    for (int k = 0; ok && k < THROTTLE_BURST; k++)
+        ok = proto_conn_send(&pc, "SAY throttle") == 0;
+
+    int burst = ok ? throttle_read(&pc, &t) : -1;
+    int mode  = pc.mode;
+
+    if (burst == 0)
+        burst = (proto_conn_send(&pc, "LIST") == 0) ? throttle_read(&pc, &t) : -1;
+    close(fd);
+
+    printf("Throttle check %s:%d: %s, %d refused, LIST %s, stream %s\n",
+           host, port, mode == PROTO_BIN ? "binary" : "text", t.refused,
+           t.listed ? "read" : "missing", burst == 0 ? "ok" : "broken");
+
+    return (mode == PROTO_BIN && t.refused > 0 && t.listed > 0 && burst == 0) ? 0 : -1;
+}
+
+/* =====================================================
+ *                        main
+ * ===================================================== */
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [-i iterations] [-g games] [-H host -p port]\n", prog);
+}
+
+int main(int argc, char *argv[])
+{
+    long        iterations = DEFAULT_ITERATIONS;
+    int         games      = DEFAULT_GAMES;
+    const char *host       = "127.0.0.1";
+    int         port       = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-i") == 0)      iterations = atol(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-g") == 0) games      = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-H") == 0) host       = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "-p") == 0) port       = atoi(argv[++i]);
+        else { usage(argv[0]); return EXIT_FAILURE; }
+    }
+
+    if (iterations < 1 || games < 0 || port < 0 || port > 65535) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* Serveur lancé : seulement la vérification de la connexion limitée */
+    if (port)
+        return check_throttle(host, port) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    int pits[SAMPLES][12];
+    int scores[SAMPLES][2];
+    sample_boards(pits, scores);
+
+    printf("Protocol: %ld messages per case\n", iterations);
+    printf("%-18s %8s %12s %12s\n", "message", "bytes", "encode (ns)", "parse (ns)");
+
+    bench_board_text(iterations, pits, scores);
+    bench_board_bin(iterations, pits, scores);
+    bench_start_text(iterations);
+    bench_start_bin(iterations);
+    bench_stream(games);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+/*************************************************************************
+                           Awale -- Bench (Lazy SMP scaling)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Mesure le temps pour atteindre une profondeur
+                           fixe selon le nombre de threads de recherche,
+                           sur des positions de saved_games/
+*************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "../ai/ai.h"
+
+#define DEFAULT_POSITIONS  16
+#define DEFAULT_DEPTH      14
+#define TT_MB              256
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [-d depth] [-n positions] [-t max_threads] [-s saved_dir]\n",
+            prog);
+}
+
+int main(int argc, char *argv[])
+{
+    int depth       = DEFAULT_DEPTH;
+    int count       = DEFAULT_POSITIONS;
+    int max_threads = ai_default_threads();
+    const char *dir = "saved_games";
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-d") == 0)      depth       = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-n") == 0) count       = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-t") == 0) max_threads = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) dir         = argv[++i];
+        else { usage(argv[0]); return EXIT_FAILURE; }
+    }
+
+    if (depth < 1 || count < 1 || max_threads < 1) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    PackedBoard *pos = malloc((size_t)count * sizeof(*pos));
+    if (!pos)
+        return EXIT_FAILURE;
+
+    /* Positions espacées de 7 demi-coups : ouvertures et milieux de partie */
+    count = bench_positions(dir, pos, count, 7);
+
+    TransTable tt;
+    if (tt_init(&tt, TT_MB, 1) < 0) {
+        perror("tt_init");
+        free(pos);
+        return EXIT_FAILURE;
+    }
+
+    printf("Lazy SMP: %d positions, depth %d, TT %zu MB%s\n",
+           count, depth, tt.bytes >> 20, tt.huge_pages ? " (huge pages)" : "");
+    printf("%8s %12s %14s %12s %10s %10s\n",
+           "threads", "time (s)", "nodes", "Mnps", "speedup", "efficiency");
+
+    double base = 0.0;
+
+    for (int threads = 1; threads <= max_threads; ) {
+        uint64_t nodes = 0;
+        uint64_t ns    = 0;
+
+        for (int k = 0; k < count; k++) {
+            /* Table vide pour chaque mesure : pas d'avantage au second passage */
+            tt_clear(&tt);
+
+            AiLimits lim = { depth, 3600 * 1000, threads };
+            AiResult res;
+            ai_search(&pos[k], &tt, &lim, &res);
+
+            nodes += res.nodes;
+            ns    += res.elapsed_ns;
+        }
+
+        double secs = (double)ns / 1e9;
+        if (threads == 1)
+            base = secs;
+
+        double speedup = (secs > 0.0) ? base / secs : 0.0;
+        printf("%8d %12.3f %14llu %12.2f %10.2f %9.0f%%\n",
+               threads, secs, (unsigned long long)nodes,
+               secs > 0.0 ? (double)nodes / secs / 1e6 : 0.0,
+               speedup, 100.0 * speedup / threads);
+
+        /* Puissances de 2, puis toujours le nombre maximal demandé */
+        if (threads == max_threads)
+            break;
+        threads = (threads * 2 > max_threads) ? max_threads : threads * 2;
+    }
+
+    tt_free(&tt);
+    free(pos);
+    return 0;
+}
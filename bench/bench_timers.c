@@ -0,0 +1,233 @@
+/*************************************************************************
+                           Awale -- Bench (Timers)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Coût de la roue de minuteurs du serveur avec
+                           beaucoup de minuteurs armés : armer, déplacer,
+                           annuler, délai d'attente, puis déclenchement
+                           de tous (coût et retard par rapport à
+                           l'échéance), en temps réel sur une seconde
+                           puis en horloge simulée sur des heures (tous
+                           les niveaux cascadent). Échoue si un minuteur
+                           part avant son échéance ou jamais.
+*************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "../server/server.h"
+
+#define DEFAULT_TIMERS   100000
+#define DEFAULT_SPREAD   1000       /* ms : échéances du déclenchement */
+#define DEFAULT_HOURS    24         /* h : échéances en horloge simulée */
+#define TIMEOUT_CALLS    1000000
+
+/* Minuteur de test : son échéance et le retard constaté */
+typedef struct {
+    Timer    timer;
+    uint64_t when;
+} Item;
+
+static uint64_t g_fired;
+static uint64_t g_early;
+static uint64_t g_late_sum;
+static uint64_t g_late_max;
+
+/* Empêche le compilateur de supprimer les boucles mesurées */
+static volatile int g_sink;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static unsigned rnd(unsigned *x)
+{
+    *x ^= *x << 13; *x ^= *x >> 17; *x ^= *x << 5;
+    return *x;
+}
+
+/* Heure de la roue au déclenchement : avant l'échéance, c'est une erreur */
+static void on_expire(Timer *t)
+{
+    Item    *it  = timer_owner(t, Item, timer);
+    uint64_t now = timers_now();
+
+    g_fired++;
+    if (now < it->when) {
+        g_early++;
+        return;
+    }
+
+    uint64_t late = now - it->when;
+    g_late_sum += late;
+    if (late > g_late_max)
+        g_late_max = late;
+}
+
+/* Arme les n minuteurs entre base + 1 et base + spread ms */
+static void arm_spread(Item *items, long n, uint64_t base, uint64_t spread, unsigned *x)
+{
+    g_fired = g_early = g_late_sum = g_late_max = 0;
+
+    for (long k = 0; k < n; k++) {
+        uint64_t r = ((uint64_t)rnd(x) << 32 | rnd(x)) % spread;
+        items[k].when = base + 1 + r;
+        timer_arm(&items[k].timer, items[k].when, on_expire);
+    }
+}
+
+/* Retard, minuteurs en avance et perdus ; 0 si aucun des deux */
+static int report_fire(const char *name, uint64_t ns, long n, long turns)
+{
+    uint64_t lost = (uint64_t)n - g_fired;
+
+    printf("%s\n", name);
+    printf("  %-20s %10.1f ns\n", "fire (per timer)", (double)ns / (double)n);
+    printf("  %-20s %10ld\n", "loop turns", turns);
+    printf("  %-20s %10.2f ms avg, %llu ms max\n", "lateness",
+           (double)g_late_sum / (double)n, (unsigned long long)g_late_max);
+    printf("  %-20s %10llu early, %llu lost\n", "errors",
+           (unsigned long long)g_early, (unsigned long long)lost);
+
+    return (g_early || lost) ? -1 : 0;
+}
+
+static void report(const char *name, uint64_t ns, long count)
+{
+    printf("%-22s %10.1f ns\n", name, (double)ns / (double)count);
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [-n timers] [-s spread_ms] [-H hours]\n", prog);
+}
+
+int main(int argc, char *argv[])
+{
+    long n      = DEFAULT_TIMERS;
+    long spread = DEFAULT_SPREAD;
+    long hours  = DEFAULT_HOURS;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-n") == 0)      n      = atol(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) spread = atol(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-H") == 0) hours  = atol(argv[++i]);
+        else { usage(argv[0]); return EXIT_FAILURE; }
+    }
+
+    /* Au-delà de 7 jours, la roue ramène l'échéance à sa limite */
+    if (n < 1 || spread < 1 || hours < 1 || hours > 7 * 24) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Item *items = calloc((size_t)n, sizeof(Item));
+    if (!items) {
+        perror("calloc");
+        return EXIT_FAILURE;
+    }
+
+    timers_init();
+    timers_run();
+
+    unsigned x    = 2463534242u;
+    uint64_t base = timers_now();
+
+    printf("Timer wheel: %ld timers, tick %d ms\n", n, TIMER_TICK_MS);
+
+    /* ---------- Armer : échéances entre 1 s et 1 h ---------- */
+    uint64_t t0 = now_ns();
+    for (long k = 0; k < n; k++) {
+        items[k].when = base + 1000 + rnd(&x) % 3600000u;
+        timer_arm(&items[k].timer, items[k].when, on_expire);
+    }
+    uint64_t t1 = now_ns();
+    report("arm", t1 - t0, n);
+
+    /* ---------- Déplacer (activité d'un client) ---------- */
+    t0 = now_ns();
+    for (long k = 0; k < n; k++) {
+        items[k].when = base + 1000 + rnd(&x) % 3600000u;
+        timer_arm(&items[k].timer, items[k].when, on_expire);
+    }
+    t1 = now_ns();
+    report("re-arm", t1 - t0, n);
+
+    /* ---------- Délai d'attente de la boucle ---------- */
+    t0 = now_ns();
+    for (long k = 0; k < TIMEOUT_CALLS; k++)
+        g_sink += timers_timeout();
+    t1 = now_ns();
+    report("timeout", t1 - t0, TIMEOUT_CALLS);
+
+    /* ---------- Annuler ---------- */
+    t0 = now_ns();
+    for (long k = 0; k < n; k++)
+        timer_cancel(&items[k].timer);
+    t1 = now_ns();
+    report("cancel", t1 - t0, n);
+
+    /* ---------- Déclencher : échéances sur spread ms ---------- */
+    timers_run();
+    arm_spread(items, n, timers_now(), (uint64_t)spread, &x);
+
+    uint64_t limit  = timers_now() + (uint64_t)spread + 1000;
+    uint64_t run_ns = 0;
+    long     turns  = 0;
+
+    while (g_fired < (uint64_t)n && timers_now() < limit) {
+        /* Attente de la boucle d'événements, sans événement */
+        int ms = timers_timeout();
+        if (ms > 0) {
+            struct timespec ts = { ms / 1000, (long)(ms % 1000) * 1000000L };
+            nanosleep(&ts, NULL);
+        }
+
+        t0 = now_ns();
+        timers_run();
+        run_ns += now_ns() - t0;
+        turns++;
+    }
+
+    int failed = report_fire("fire (real clock)", run_ns, n, turns);
+
+    /*
+     * ---------- Déclencher : échéances sur des heures ----------
+     * Horloge simulée, avancée d'un tick par tour : les minuteurs
+     * partent des niveaux 1 à 3 et cascadent jusqu'au premier.
+     */
+    uint64_t sim    = timers_now_ns();
+    uint64_t span   = (uint64_t)hours * 3600000u;
+    uint64_t tick   = (uint64_t)TIMER_TICK_MS * 1000000u;
+
+    arm_spread(items, n, timers_now(), span, &x);
+    limit  = timers_now() + span + 1000;
+    run_ns = 0;
+    turns  = 0;
+
+    while (g_fired < (uint64_t)n && timers_now() < limit) {
+        sim += tick;
+        t0 = now_ns();
+        timers_run_at(sim);
+        run_ns += now_ns() - t0;
+        turns++;
+    }
+
+    char name[48];
+    snprintf(name, sizeof(name), "fire (simulated, %ld h)", hours);
+    if (report_fire(name, run_ns, n, turns) < 0)
+        failed = 1;
+
+    free(items);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
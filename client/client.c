@@ -32,7 +32,7 @@
  *  - réception des messages serveur
  *  - lecture et envoi des commandes utilisateur
  * ===================================================================== */
-int client_run(const char *server_ip, const char *server_port)
+int client_run(const char *server_ip, const char *server_port, int binary)
 {
     /* -------------------------
      *  Création socket client
@@ -66,17 +66,19 @@ int client_run(const char *server_ip, const char *server_port)
      *  Initialisation de l'état
      * ------------------------- */
     ClientState state;
-    client_state_init(&state, sock);
+    if (client_state_init(&state, sock, binary) < 0) {
+        perror("send");
+        close(sock);
+        return EXIT_FAILURE;
+    }
 
     ui_print_banner();
 
     fd_set readfds;
     int maxfd = (sock > STDIN_FILENO ? sock : STDIN_FILENO);
 
-    char recv_buf[CLIENT_BUF_SIZE];
     char input_buf[CLIENT_BUF_SIZE];
 
-    memset(recv_buf, 0, sizeof(recv_buf));
     memset(input_buf, 0, sizeof(input_buf));
 
     /* =====================================================================
@@ -106,37 +108,12 @@ int client_run(const char *server_ip, const char *server_port)
          * ===================================================== */
         if (FD_ISSET(sock, &readfds)) {
 
-            int n = recv(sock, recv_buf, sizeof(recv_buf) - 1, 0);
-            if (n < 0) {
-                perror(COL_RED "recv" COL_RESET);
-                printf(COL_RED "Connection error, closing client.\n" COL_RESET);
-                break;
-            }
-            if (n == 0) {
+            /* Lignes de texte ou trames, découpées par la connexion */
+            if (proto_conn_read(&state.conn, protocol_handle_message, &state) < 0) {
                 printf("\n" COL_RED "Disconnected from server!\n" COL_RESET);
                 break;
             }
 
-            /* Assurer la terminaison de la chaîne */
-            recv_buf[n] = '\0';
-
-            /* Validation : vérifier que le buffer est bien terminé */
-            if (!is_buffer_terminated(recv_buf, n + 1)) {
-                printf(COL_RED "ERROR: Buffer not properly terminated\n" COL_RESET);
-                continue;
-            }
-
-            /* Découpage en lignes (protocole basé sur '\n') */
-            char *saveptr = NULL;
-            char *line = strtok_r(recv_buf, "\n", &saveptr);
-
-            while (line) {
-                if (line[0] != '\0') {
-                    protocol_handle_server_line(&state, line);
-                }
-                line = strtok_r(NULL, "\n", &saveptr);
-            }
-
             /* Après réception de messages serveur, on affiche le prompt */
             prompt_needed = 1;
         }
@@ -192,28 +169,14 @@ int client_run(const char *server_ip, const char *server_port)
 
             /* QUIT : demande explicite de fermeture par l'utilisateur */
             if (strcasecmp(input_buf, "QUIT") == 0) {
-                const char *quit_msg = "QUIT\n";
-                ssize_t sent = send(sock, quit_msg, strlen(quit_msg), 0);
-                if (sent < 0) {
+                if (protocol_send(&state, "QUIT") < 0) {
                     perror(COL_RED "send" COL_RESET);
                 }
                 break;
             }
 
-            /* Envoi de la ligne brute au serveur (commande ou réponse login) */
-            size_t len = strlen(input_buf);
-
-            if (len + 1 < sizeof(input_buf)) {
-                input_buf[len] = '\n';
-                input_buf[len + 1] = '\0';
-            } else {
-                /* Sécurité : si trop plein, on force juste un '\n' final */
-                input_buf[sizeof(input_buf) - 2] = '\n';
-                input_buf[sizeof(input_buf) - 1] = '\0';
-            }
-
-            ssize_t sent = send(sock, input_buf, strlen(input_buf), 0);
-            if (sent < 0) {
+            /* Envoi de la ligne au serveur (commande ou réponse login) */
+            if (protocol_send(&state, input_buf) < 0) {
                 perror(COL_RED "send" COL_RESET);
                 break;
             }
@@ -232,13 +195,16 @@ int client_run(const char *server_ip, const char *server_port)
  * ===================================================================== */
 int main(int argc, char *argv[])
 {
-    if (argc != 3) {
+    /* bin : trames binaires demandées au serveur (texte par défaut) */
+    int binary = (argc == 4 && strcasecmp(argv[3], "bin") == 0);
+
+    if (argc != 3 && !binary) {
         fprintf(stderr,
-                "Usage: %s <server_ip> <port>\n"
+                "Usage: %s <server_ip> <port> [bin]\n"
                 "Example: %s 127.0.0.1 4444\n",
                 argv[0], argv[0]);
         return EXIT_FAILURE;
     }
 
-    return client_run(argv[1], argv[2]);
+    return client_run(argv[1], argv[2], binary);
 }
@@ -14,6 +14,8 @@
 
 #include <stddef.h>
 
+#include "../proto/proto.h"
+
 /* Taille des buffers pour l'entrée / sortie réseau & clavier */
 #define CLIENT_BUF_SIZE 1024
 
@@ -37,6 +39,7 @@
  */
 typedef struct {
     int  sock;                     /* socket connecté au serveur */
+    ProtoConn conn;                /* texte ou trames (négocié par HELLO) */
 
     /* Login / authentification */
     int  logged_in;                /* 1 si authentifié */
@@ -59,6 +62,11 @@ typedef struct {
     int  score0;
     int  score1;
     int  next_player;              /* prochain joueur à jouer (0 ou 1) */
+    unsigned board_seq;            /* numéro du dernier plateau reçu */
+    int  board_known;              /* plateau complet reçu : les BOARD_DELTA s'y appliquent */
+    int  board_resync;             /* plateau complet redemandé, pas encore reçu */
+    int  timed;                    /* partie à la pendule */
+    unsigned clocks[2];            /* temps restant de chaque joueur (ms), au dernier plateau */
 
     int  board_pending;            /* 1 si un plateau est en attente d'affichage */
 } ClientState;
@@ -84,8 +92,11 @@ int  is_valid_score(int score);
 /*
  * Initialise l'état du client avec une socket connectée.
  * Met tous les champs à des valeurs cohérentes.
+ * Les plateaux différentiels sont toujours demandés (HELLO envoyé) ;
+ * binary : demande aussi les trames binaires.
+ * Retourne -1 si la demande n'a pas pu être envoyée.
  */
-void client_state_init(ClientState *state, int sock);
+int  client_state_init(ClientState *state, int sock, int binary);
 
 /*
  * Gère une ligne complète envoyée par le serveur.
@@ -94,6 +105,15 @@ void client_state_init(ClientState *state, int sock);
  */
 void protocol_handle_server_line(ClientState *state, const char *line);
 
+/*
+ * Gère un message reçu (ligne de texte ou trame décodée) ; ctx est le
+ * ClientState. Signature de ProtoHandler, retourne toujours 1.
+ */
+int  protocol_handle_message(void *ctx, const ProtoMsg *msg);
+
+/* Envoie une commande (sans '\n') dans le protocole négocié ; -1 si échec */
+int  protocol_send(ClientState *state, const char *line);
+
 /* ============================
  *  Interface utilisateur (UI)
  * ============================ */
@@ -125,6 +145,6 @@ void ui_print_prompt(const ClientState *state);
  *  - connexion TCP au serveur (ip, port)
  *  - boucle select() sur socket + stdin
  */
-int client_run(const char *server_ip, const char *server_port);
+int client_run(const char *server_ip, const char *server_port, int binary);
 
 #endif /* CLIENT_H */
@@ -9,6 +9,7 @@
 
 #define _GNU_SOURCE
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
@@ -28,11 +29,125 @@ static void print_server_text(const char *msg)
 /* ============================================================
  *                  INITIALIZE CLIENT STATE
  * ============================================================ */
-void client_state_init(ClientState *state, int sock)
+int client_state_init(ClientState *state, int sock, int binary)
 {
     memset(state, 0, sizeof(*state));
     state->sock = sock;
     state->player_index = -1;
+
+    return proto_conn_init(&state->conn, sock,
+                           PROTO_WANT_DELTA | (binary ? PROTO_WANT_BIN : 0));
+}
+
+/* ============================================================
+ *                  SEND A COMMAND TO THE SERVER
+ * ============================================================ */
+int protocol_send(ClientState *state, const char *line)
+{
+    return proto_conn_send(&state->conn, line);
+}
+
+/* ============================================================
+ *            GAME START / BOARD (text line or frame)
+ * ============================================================ */
+static void protocol_game_start(ClientState *state, const char *p0, const char *p1)
+{
+    safe_strcpy_client(state->player0_name, p0, sizeof(state->player0_name));
+    safe_strcpy_client(state->player1_name, p1, sizeof(state->player1_name));
+
+    state->in_game     = 1;
+    state->is_observer = 0;
+    state->has_players = 1;
+
+    state->board_known  = 0;
+    state->board_resync = 0;
+    state->timed        = 0;
+
+    if (safe_strcasecmp(state->username, state->player0_name) == 0)
+        state->player_index = 0;
+    else if (safe_strcasecmp(state->username, state->player1_name) == 0)
+        state->player_index = 1;
+    else
+        state->player_index = -1;
+
+    ui_clear_screen();
+    printf(COL_GREEN "New game started : %s vs %s\n" COL_RESET,
+           state->player0_name, state->player1_name);
+
+    protocol_send(state, "READY");
+}
+
+static void protocol_board(ClientState *state, const int p[12],
+                           int s0, int s1, int next, int has_seq, unsigned seq,
+                           const uint32_t *clocks)
+{
+    /* Valider les graines sur le plateau */
+    for (int i = 0; i < 12; i++) {
+        if (p[i] < 0 || p[i] > 48)
+            return;
+    }
+
+    /* Valider les scores et le joueur suivant */
+    if (!is_valid_score(s0) || !is_valid_score(s1) ||
+        !is_valid_player_index(next))
+        return;
+
+    memcpy(state->board, p, sizeof(state->board));
+    state->score0 = s0;
+    state->score1 = s1;
+    state->next_player = next;
+
+    /* Base des plateaux différentiels qui suivent */
+    state->board_seq    = seq;
+    state->board_known  = has_seq;
+    state->board_resync = 0;
+
+    /* Temps restant, envoyé avec chaque plateau d'une partie à la pendule */
+    state->timed = (clocks != NULL);
+    if (clocks) {
+        state->clocks[0] = clocks[0];
+        state->clocks[1] = clocks[1];
+    }
+
+    ui_print_board(state);
+}
+
+/* ============================================================
+ *        BOARD DELTA (changed pits and scores only)
+ * ============================================================ */
+static void protocol_board_delta(ClientState *state, const ProtoMsg *msg)
+{
+    /* Plateau de base absent ou plateau sauté : l'état complet est redemandé */
+    if (!state->board_known ||
+        msg->seq != ((state->board_seq + 1) & PROTO_SEQ_MASK))
+    {
+        state->board_known = 0;
+        if (!state->board_resync) {
+            state->board_resync = 1;
+            protocol_send(state, PROTO_RESYNC);
+        }
+        return;
+    }
+
+    for (int k = 0; k < 12; k++)
+        if (msg->mask & (1u << k))
+            state->board[k] = msg->pits[k];
+
+    if (msg->mask & PROTO_DELTA_SCORES) {
+        state->score0 = msg->scores[0];
+        state->score1 = msg->scores[1];
+    }
+
+    if (msg->mask & PROTO_DELTA_CLOCKS) {
+        state->timed     = 1;
+        state->clocks[0] = msg->clocks[0];
+        state->clocks[1] = msg->clocks[1];
+    }
+
+    state->next_player = msg->next;
+    state->board_seq   = msg->seq;
+
+    ui_print_board(state);
 }
 
 /* ============================================================
@@ -113,6 +228,19 @@ void protocol_handle_server_line(ClientState *state, const char *line)
         return;
     }
 
+    /* ============================================================
+     *           RATE LIMIT (BOARD de resynchronisation refusé)
+     * ============================================================ */
+    if (strncmp(buf, "ERROR : Too many commands", 25) == 0 ||
+        strncmp(buf, "ERROR : Server busy", 19) == 0) {
+
+        /* Le plateau complet ne viendra pas : le prochain trou le redemande */
+        state->board_resync = 0;
+
+        print_server_text(buf);
+        return;
+    }
+
     /* ============================================================
      *                 GAME START
      * ============================================================ */
@@ -123,28 +251,8 @@ void protocol_handle_server_line(ClientState *state, const char *line)
         memset(p0, 0, sizeof(p0));
         memset(p1, 0, sizeof(p1));
 
-        if (sscanf(buf, "GAME_START %15s vs %15s", p0, p1) == 2) {
-
-            safe_strcpy_client(state->player0_name, p0, sizeof(state->player0_name));
-            safe_strcpy_client(state->player1_name, p1, sizeof(state->player1_name));
-
-            state->in_game     = 1;
-            state->is_observer = 0;
-            state->has_players = 1;
-
-            if (safe_strcasecmp(state->username, state->player0_name) == 0)
-                state->player_index = 0;
-            else if (safe_strcasecmp(state->username, state->player1_name) == 0)
-                state->player_index = 1;
-            else
-                state->player_index = -1;
-
-            ui_clear_screen();
-            printf(COL_GREEN "New game started : %s vs %s\n" COL_RESET,
-                   state->player0_name, state->player1_name);
-
-            send(state->sock, "READY\n", 6, 0);
-        }
+        if (sscanf(buf, "GAME_START %15s vs %15s", p0, p1) == 2)
+            protocol_game_start(state, p0, p1);
         return;
     }
 
@@ -155,49 +263,33 @@ void protocol_handle_server_line(ClientState *state, const char *line)
 
         int p[12];
         int s0, s1, next;
+        unsigned seq = 0;
+        uint32_t clocks[2];
         
         memset(p, 0, sizeof(p));
 
-        if (sscanf(
+        int n = sscanf(
                 buf,
-                "BOARD %d %d %d %d %d %d %d %d %d %d %d %d | Scores: %d-%d | Next: %d",
+                "BOARD %d %d %d %d %d %d %d %d %d %d %d %d | Scores: %d-%d | Next: %d | Seq: %u | Clock: %" SCNu32 " %" SCNu32,
                 &p[0], &p[1], &p[2], &p[3], &p[4], &p[5],
                 &p[6], &p[7], &p[8], &p[9], &p[10], &p[11],
-                &s0, &s1, &next
-            ) == 15)
-        {
-            /* Valider les graines sur le plateau */
-            int valid = 1;
-            for (int i = 0; i < 12; i++) {
-                if (p[i] < 0 || p[i] > 48) {
-                    valid = 0;
-                    break;
-                }
-            }
-            
-            /* Valider les scores */
-            if (!is_valid_score(s0) || !is_valid_score(s1)) {
-                valid = 0;
-            }
-            
-            /* Joueur suivant */
-            if (!is_valid_player_index(next)) {
-                valid = 0;
-            }
-            
-            if (valid) {
-                memcpy(state->board, p, sizeof(p));
-                state->score0 = s0;
-                state->score1 = s1;
-                state->next_player = next;
-
-                ui_print_board(state);
-            }
-        }
+                &s0, &s1, &next, &seq, &clocks[0], &clocks[1]);
+
+        if (n >= 15)
+            protocol_board(state, p, s0, s1, next, n >= 16, seq & PROTO_SEQ_MASK,
+                           (n == 18) ? clocks : NULL);
 
         return;
     }
 
+    if (strncmp(buf, "BOARD_DELTA ", 12) == 0) {
+
+        ProtoMsg msg;
+        if (proto_parse_delta(buf, &msg) == 0)
+            protocol_board_delta(state, &msg);
+        return;
+    }
+
     /* ============================================================
      *                  OBSERVATION MODE
      * ============================================================ */
@@ -220,6 +312,8 @@ void protocol_handle_server_line(ClientState *state, const char *line)
             state->in_game     = 0;
             state->has_players = 1;
             state->player_index = -1;
+            state->board_known  = 0;
+            state->board_resync = 0;
 
             ui_clear_screen();
             printf("Observing game %d : %s vs %s\n",
@@ -279,3 +373,44 @@ void protocol_handle_server_line(ClientState *state, const char *line)
      * ============================================================ */
     print_server_text(buf);
 }
+
+/* ============================================================
+ *           MESSAGE PROCESSOR (text lines and frames)
+ * ============================================================ */
+int protocol_handle_message(void *ctx, const ProtoMsg *msg)
+{
+    ClientState *state = ctx;
+    char line[64];
+
+    switch (msg->op) {
+        case PROTO_OP_TEXT:
+            protocol_handle_server_line(state, msg->text);
+            break;
+
+        case PROTO_OP_GAME_START:
+            protocol_game_start(state, msg->names[0], msg->names[1]);
+            break;
+
+        case PROTO_OP_BOARD:
+            protocol_board(state, msg->pits, msg->scores[0], msg->scores[1],
+                           msg->next, 1, msg->seq, msg->timed ? msg->clocks : NULL);
+            break;
+
+        case PROTO_OP_BOARD_DELTA:
+            protocol_board_delta(state, msg);
+            break;
+
+        case PROTO_OP_GAME_END:
+            /* Même affichage et même retour au menu qu'en texte */
+            if (msg->flag >= 0)
+                snprintf(line, sizeof(line), "GAME_END %d %d %s flag",
+                         msg->scores[0], msg->scores[1],
+                         msg->flag ? state->player1_name : state->player0_name);
+            else
+                snprintf(line, sizeof(line), "GAME_END %d %d",
+                         msg->scores[0], msg->scores[1]);
+            protocol_handle_server_line(state, line);
+            break;
+    }
+    return 1;
+}
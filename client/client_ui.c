@@ -85,6 +85,7 @@ void ui_print_commands(const ClientState *state)
     printf("  LIST                         → Show online players\n");
     printf("  GAMES                        → List active games\n");
     printf("  CHALLENGE <user>             → Challenge a player\n");
+    printf("  CHALLENGE bot [ab|mcts]      → Play against the server AI\n");
     printf("  ACCEPT <user>                → Accept a challenge\n");
     printf("  REFUSE <user>                → Refuse a challenge\n");
     printf("  MOVE <0-11>                  → Play a move during a game\n");
@@ -102,6 +103,7 @@ void ui_print_commands(const ClientState *state)
 
     /* ---------- DIVERS ---------- */
     printf(COL_GREEN "== Misc ==\n" COL_RESET);
+    printf("  STATS                        → Show server output queue counters\n");
     printf("  QUIT                         → Exit the client\n\n");
 
     /* ---------- INFORMATIONS CONTEXTUELLES ---------- */
@@ -156,6 +158,8 @@ void ui_print_board(const ClientState *state)
     } else {
         printf("%d", state->score1);
     }
+    if (state->timed)
+        printf(" | Clock : %u:%02u", state->clocks[1] / 60000, state->clocks[1] / 1000 % 60);
     printf("\n\n");
 
     /* Joueur inférieur (player0) */
@@ -173,6 +177,8 @@ void ui_print_board(const ClientState *state)
     } else {
         printf("%d", state->score0);
     }
+    if (state->timed)
+        printf(" | Clock : %u:%02u", state->clocks[0] / 60000, state->clocks[0] / 1000 % 60);
     printf("\n\n");
 
     /* Informations contextuelles sur le tour */
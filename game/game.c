@@ -203,6 +203,26 @@ int playMove(int board[], int playerNumber,
     return 0;
 }
 
+/*
+ * Masque des coups légaux : mêmes tests que playMove,
+ * sans copier le plateau ni les joueurs.
+ */
+int legalMoves(int board[], int playerNumber) {
+    if (playerNumber != 0 && playerNumber != 1) return 0;
+
+    int first    = (playerNumber == 0) ? 0 : 6;
+    int starving = detectStarvation(board);
+    int mask     = 0;
+
+    for (int pit = first; pit < first + 6; pit++) {
+        if (board[pit] == 0) continue;
+        if (starving != -1 && board[pit] <= (first + 5 - pit)) continue;
+        mask |= 1 << pit;
+    }
+
+    return mask;
+}
+
 /* Affichage simple ASCII du plateau en 2 lignes */
 void printBoard(int board[], Player p0, Player p1) {
     printf("%-15s : ", p1.name);
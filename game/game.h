@@ -12,6 +12,7 @@
 #define GAME_H
 
 #include <stdio.h>
+#include <stdint.h>
 
 /*
  * Représente un joueur d'Awalé.
@@ -77,4 +78,108 @@ int playMove(int board[], int playerNumber,
 /* Affiche le plateau en deux lignes (utile pour le débogage local) */
 void printBoard(int board[], Player p0, Player p1);
 
+/*
+ * Coups légaux de playerNumber en une passe :
+ * bit i à 1 ssi playMove(board, playerNumber, ..., i) retournerait 0.
+ */
+int legalMoves(int board[], int playerNumber);
+
+/* ================================================================
+ *  Plateau compact (chemin rapide)
+ * ================================================================ */
+
+/*
+ * Plateau compact :
+ *  side[0] : cases 0..5  (un octet par case, case 0 dans l'octet de poids faible)
+ *  side[1] : cases 6..11 (idem, case 6 dans l'octet de poids faible)
+ *  seeds[] : total de graines de chaque camp, tenu à jour par les routines pb*
+ *  score[] : graines capturées par chaque joueur
+ *  toMove  : joueur au trait (utilisé par makeMove / unmakeMove uniquement)
+ *  key     : clé de Zobrist (cases, scores et trait), tenue à jour par
+ *            toutes les routines pb* et makeMove / unmakeMove
+ *
+ * Une case ne dépasse jamais 48 graines : les additions octet par octet
+ * ne débordent donc jamais sur la case voisine.
+ */
+typedef struct {
+    uint64_t side[2];
+    int      seeds[2];
+    int      score[2];
+    int      toMove;
+    uint64_t key;
+} PackedBoard;
+
+/*
+ * Informations nécessaires pour défaire un coup joué par makeMove :
+ *  pit      : case jouée
+ *  seeds    : graines semées depuis cette case
+ *  captured : graines capturées (= variation du score du joueur)
+ *  taken    : octets des cases capturées, avec leur valeur avant capture
+ *  key      : clé de Zobrist avant le coup
+ */
+typedef struct {
+    int      pit;
+    int      seeds;
+    int      captured;
+    uint64_t taken;
+    uint64_t key;
+} MoveUndo;
+
+#define PB_LANE_BITS  8
+#define PB_LANE_MASK  0xFFULL
+#define PB_SIDE_MASK  0x0000FFFFFFFFFFFFULL
+
+/* Camp et décalage d'une case dans la représentation compacte */
+static inline int pbSideOf(int pit)  { return pit >= 6; }
+static inline int pbShiftOf(int pit) { return PB_LANE_BITS * (pit >= 6 ? pit - 6 : pit); }
+
+/* Nombre de graines dans une case */
+static inline int pbPit(const PackedBoard *pb, int pit)
+{
+    return (int)((pb->side[pbSideOf(pit)] >> pbShiftOf(pit)) & PB_LANE_MASK);
+}
+
+/* Conversions depuis / vers le plateau historique int board[12] */
+void packBoard(PackedBoard *pb, const int board[], int score0, int score1);
+void unpackBoard(const PackedBoard *pb, int board[], int *score0, int *score1);
+
+/* Équivalent de initGame + resetScores */
+void pbInitGame(PackedBoard *pb);
+
+/* Recalcule entièrement la clé de Zobrist (référence pour pb->key) */
+uint64_t pbComputeKey(const PackedBoard *pb);
+
+/* Mêmes conventions que detectStarvation, en O(1) grâce aux totaux */
+int pbDetectStarvation(const PackedBoard *pb);
+
+/* Mêmes règles et effets de bord que isGameOver (scores inclus) */
+int pbIsGameOver(PackedBoard *pb);
+
+/*
+ * Même règle que captureSeeds.
+ * Retourne le nombre de graines capturées (0 si aucune capture).
+ */
+int pbCaptureSeeds(PackedBoard *pb, int playerNumber, int lastPit);
+
+/*
+ * Sème les graines de pit (case d'origine sautée) sans aucune vérification.
+ * Retourne la dernière case ensemencée.
+ */
+int pbSow(PackedBoard *pb, int pit);
+
+/* Même contrat et mêmes codes de retour que playMove */
+int pbPlayMove(PackedBoard *pb, int playerNumber, int pit);
+
+/* Même résultat que legalMoves, sans boucle sur les cases */
+int pbLegalMoves(const PackedBoard *pb, int playerNumber);
+
+/*
+ * Joue un coup légal de pb->toMove sur place (aucune vérification),
+ * remplit undo puis passe le trait à l'adversaire.
+ */
+void makeMove(PackedBoard *pb, int pit, MoveUndo *undo);
+
+/* Défait exactement le dernier makeMove (trait compris) */
+void unmakeMove(PackedBoard *pb, const MoveUndo *undo);
+
 #endif
@@ -0,0 +1,369 @@
+/*************************************************************************
+                           Awale -- Game (Packed board)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Moteur Awalé sur plateau compact : mêmes règles
+                           que game.c, sans boucles de sommation par camp
+*************************************************************************/
+
+#include "game.h"
+#include "game_sow_tables.h"       /* généré dans obj/gen par gen_sow_tables */
+#include "game_zobrist_tables.h"   /* généré dans obj/gen par gen_zobrist_tables */
+
+/*
+ * Biais ajoutés à chaque octet pour tester « case > seuil » en une
+ * seule addition : le bit 7 de l'octet passe à 1 ssi la case dépasse
+ * son seuil (au plus 48 + 0x7F, pas de débordement).
+ *
+ *  camp 0 : case i nourrit si board[i] > 5 - i      → biais 0x7A + i
+ *  camp 1 : case 6+k nourrit si board[6+k] > k + 1  → biais 0x7E - k
+ *           (seuil repris tel quel de isGameOver)
+ */
+#define PB_HIGH_BITS   0x0000808080808080ULL
+#define PB_FEED_BIAS0  0x00007F7E7D7C7B7AULL
+#define PB_FEED_BIAS1  0x0000797A7B7C7D7EULL
+
+/*
+ * Génération de coups : case k du camp non vide  → biais 0x7F,
+ * case k du camp qui nourrit (graines > 5 - k)  → biais 0x7A + k
+ * (valable pour les deux camps, voir playMove).
+ */
+#define PB_NONEMPTY_BIAS  0x00007F7F7F7F7F7FULL
+#define PB_REACH_BIAS     PB_FEED_BIAS0
+
+/* Rassemble les bits 7, 15, ..., 47 d'un mot en un masque de 6 bits */
+static inline int lanes_to_mask(uint64_t high)
+{
+    return (int)((((high >> 7) * 0x0102040810200000ULL) >> 56) & 0x3F);
+}
+
+/*
+ * Met à jour la clé pour chaque case d'un camp qui a changé
+ * entre before et after (au plus 6 cases).
+ */
+static inline uint64_t rehash_side(uint64_t key, int s,
+                                   uint64_t before, uint64_t after)
+{
+    uint64_t diff = before ^ after;
+
+    while (diff) {
+        int shift = __builtin_ctzll(diff) & ~7;
+        int pit   = 6 * s + shift / 8;
+
+        key ^= ZOBRIST_PIT[pit][(before >> shift) & PB_LANE_MASK]
+             ^ ZOBRIST_PIT[pit][(after  >> shift) & PB_LANE_MASK];
+        diff &= ~(PB_LANE_MASK << shift);
+    }
+    return key;
+}
+
+static inline uint64_t rehash_score(uint64_t key, int player,
+                                    int before, int after)
+{
+    return key ^ ZOBRIST_SCORE[player][before] ^ ZOBRIST_SCORE[player][after];
+}
+
+uint64_t pbComputeKey(const PackedBoard *pb)
+{
+    uint64_t key = 0;
+
+    for (int i = 0; i < 12; i++)
+        key ^= ZOBRIST_PIT[i][pbPit(pb, i)];
+
+    key ^= ZOBRIST_SCORE[0][pb->score[0]];
+    key ^= ZOBRIST_SCORE[1][pb->score[1]];
+
+    if (pb->toMove)
+        key ^= ZOBRIST_SIDE;
+
+    return key;
+}
+
+/* =====================================================
+ *                    Conversions
+ * ===================================================== */
+void packBoard(PackedBoard *pb, const int board[], int score0, int score1)
+{
+    pb->side[0]  = 0;
+    pb->side[1]  = 0;
+    pb->seeds[0] = 0;
+    pb->seeds[1] = 0;
+
+    for (int i = 0; i < 12; i++) {
+        pb->side[pbSideOf(i)]  |= ((uint64_t)board[i] & PB_LANE_MASK) << pbShiftOf(i);
+        pb->seeds[pbSideOf(i)] += board[i];
+    }
+
+    pb->score[0] = score0;
+    pb->score[1] = score1;
+    pb->toMove   = 0;
+    pb->key      = pbComputeKey(pb);
+}
+
+void unpackBoard(const PackedBoard *pb, int board[], int *score0, int *score1)
+{
+    for (int i = 0; i < 12; i++)
+        board[i] = pbPit(pb, i);
+
+    if (score0) *score0 = pb->score[0];
+    if (score1) *score1 = pb->score[1];
+}
+
+void pbInitGame(PackedBoard *pb)
+{
+    pb->side[0]  = 0x0000040404040404ULL;
+    pb->side[1]  = 0x0000040404040404ULL;
+    pb->seeds[0] = 24;
+    pb->seeds[1] = 24;
+    pb->score[0] = 0;
+    pb->score[1] = 0;
+    pb->toMove   = 0;
+    pb->key      = pbComputeKey(pb);
+}
+
+/* =====================================================
+ *                      Famine
+ * ===================================================== */
+int pbDetectStarvation(const PackedBoard *pb)
+{
+    if (pb->seeds[0] == 0) return 0;
+    if (pb->seeds[1] == 0) return 1;
+    return -1;
+}
+
+/* =====================================================
+ *                    Fin de partie
+ * ===================================================== */
+int pbIsGameOver(PackedBoard *pb)
+{
+    if (pb->score[0] > 24 || pb->score[1] > 24)
+        return 1;
+
+    if (pb->score[0] + pb->score[1] >= 48)
+        return 1;
+
+    if (pbDetectStarvation(pb) != -1) {
+        int emptyPlayer = (pb->seeds[0] == 0) ? 0 : 1;
+        int opponent    = 1 - emptyPlayer;
+
+        uint64_t bias = (opponent == 0) ? PB_FEED_BIAS0 : PB_FEED_BIAS1;
+        int canFeed   = ((pb->side[opponent] + bias) & PB_HIGH_BITS) != 0;
+
+        /* Impossible de nourrir → les graines restantes vont à l'adversaire */
+        if (!canFeed) {
+            pb->score[opponent] += pb->seeds[0] + pb->seeds[1];
+            pb->side[0]  = pb->side[1]  = 0;
+            pb->seeds[0] = pb->seeds[1] = 0;
+            pb->key      = pbComputeKey(pb);
+            return 1;
+        }
+    }
+
+    /* Trop peu de graines (≤ 3) : chacun récupère son camp */
+    if (pb->seeds[0] + pb->seeds[1] <= 3) {
+        pb->score[0] += pb->seeds[0];
+        pb->score[1] += pb->seeds[1];
+        pb->side[0]  = pb->side[1]  = 0;
+        pb->seeds[0] = pb->seeds[1] = 0;
+        pb->key      = pbComputeKey(pb);
+        return 1;
+    }
+
+    return 0;
+}
+
+/* =====================================================
+ *                      Capture
+ * ===================================================== */
+
+/*
+ * Cherche les cases capturables à partir de lastPit.
+ * Retourne le total capturé (0 si la capture affamerait l'adversaire)
+ * et place dans *taken les octets concernés, valeurs comprises.
+ */
+static int find_capture(const PackedBoard *pb, int playerNumber, int lastPit,
+                        uint64_t *taken)
+{
+    int opp = 1 - playerNumber;
+
+    /* Même sens de parcours que captureSeeds */
+    int direction = (playerNumber == 0) ? -1 : 1;
+    int lo = (opp == 0) ? 0 : 6;
+    int hi = lo + 5;
+
+    uint64_t lanes = 0;
+    int total      = 0;
+
+    for (int pos = lastPit; pos >= lo && pos <= hi; pos += direction) {
+        int shift = pbShiftOf(pos);
+        uint64_t v = (pb->side[opp] >> shift) & PB_LANE_MASK;
+        if (v != 2 && v != 3)
+            break;
+        lanes |= v << shift;
+        total += (int)v;
+    }
+
+    *taken = 0;
+
+    /* Une capture qui affamerait l'adversaire est annulée */
+    if (total == 0 || total >= pb->seeds[opp])
+        return 0;
+
+    *taken = lanes;
+    return total;
+}
+
+int pbCaptureSeeds(PackedBoard *pb, int playerNumber, int lastPit)
+{
+    uint64_t taken;
+    int total = find_capture(pb, playerNumber, lastPit, &taken);
+    int opp   = 1 - playerNumber;
+
+    if (total == 0)
+        return 0;
+
+    pb->key = rehash_side(pb->key, opp, pb->side[opp], pb->side[opp] - taken);
+    pb->key = rehash_score(pb->key, playerNumber, pb->score[playerNumber],
+                           pb->score[playerNumber] + total);
+
+    pb->side[opp]           -= taken;
+    pb->seeds[opp]          -= total;
+    pb->score[playerNumber] += total;
+    return total;
+}
+
+/* =====================================================
+ *                      Semailles
+ * ===================================================== */
+
+/*
+ * Forme close : seeds = 11 * laps + r. Chaque tour complet ajoute une
+ * graine à toutes les cases sauf l'origine (SOW_LAP), puis le reste
+ * ajoute une graine aux r cases suivantes (SOW_REM). Aucune case ne
+ * dépasse 48 graines, les additions par mot ne débordent donc jamais.
+ */
+int pbSow(PackedBoard *pb, int pit)
+{
+    int s     = pbSideOf(pit);
+    int seeds = pbPit(pb, pit);
+    int laps  = seeds / 11;
+    int r     = seeds - 11 * laps;
+
+    uint64_t before0 = pb->side[0];
+    uint64_t before1 = pb->side[1];
+
+    pb->side[s]  &= ~(PB_LANE_MASK << pbShiftOf(pit));
+    pb->seeds[s] -= seeds;
+
+    pb->side[0] += (uint64_t)laps * SOW_LAP[pit][0] + SOW_REM[pit][r][0];
+    pb->side[1] += (uint64_t)laps * SOW_LAP[pit][1] + SOW_REM[pit][r][1];
+
+    /* Un tour apporte 5 graines au camp de l'origine et 6 à l'autre */
+    pb->seeds[s]     += laps * 5 + SOW_GAIN[pit][r][s];
+    pb->seeds[1 - s] += laps * 6 + SOW_GAIN[pit][r][1 - s];
+
+    pb->key = rehash_side(pb->key, 0, before0, pb->side[0]);
+    pb->key = rehash_side(pb->key, 1, before1, pb->side[1]);
+
+    return SOW_LAST[pit][seeds];
+}
+
+/* =====================================================
+ *                     Jouer un coup
+ * ===================================================== */
+int pbPlayMove(PackedBoard *pb, int playerNumber, int pit)
+{
+    if (playerNumber != 0 && playerNumber != 1) return 1;
+    if (pit < 0 || pit > 11) return 2;
+    if (playerNumber == 0 && pit > 5)  return 3;
+    if (playerNumber == 1 && pit <= 5) return 4;
+
+    int seeds = pbPit(pb, pit);
+    if (seeds == 0) return 5;
+
+    /* Si l'adversaire est affamé, le coup doit le nourrir */
+    if (pbDetectStarvation(pb) != -1) {
+        if (playerNumber == 0 && seeds <= (5 - pit))  return 6;
+        if (playerNumber == 1 && seeds <= (11 - pit)) return 6;
+    }
+
+    int last = pbSow(pb, pit);
+    pbCaptureSeeds(pb, playerNumber, last);
+
+    return 0;
+}
+
+/* =====================================================
+ *                    Coups légaux
+ * ===================================================== */
+int pbLegalMoves(const PackedBoard *pb, int playerNumber)
+{
+    if (playerNumber != 0 && playerNumber != 1) return 0;
+
+    uint64_t side = pb->side[playerNumber];
+    uint64_t ok   = (side + PB_NONEMPTY_BIAS) & PB_HIGH_BITS;
+
+    if (pbDetectStarvation(pb) != -1)
+        ok &= (side + PB_REACH_BIAS) & PB_HIGH_BITS;
+
+    return lanes_to_mask(ok) << (6 * playerNumber);
+}
+
+/* =====================================================
+ *                 Jouer / défaire en place
+ * ===================================================== */
+void makeMove(PackedBoard *pb, int pit, MoveUndo *undo)
+{
+    int player = pb->toMove;
+
+    undo->pit   = pit;
+    undo->seeds = pbPit(pb, pit);
+    undo->key   = pb->key;
+
+    int last = pbSow(pb, pit);
+    undo->captured = find_capture(pb, player, last, &undo->taken);
+
+    if (undo->captured) {
+        pb->key = rehash_side(pb->key, 1 - player, pb->side[1 - player],
+                              pb->side[1 - player] - undo->taken);
+        pb->key = rehash_score(pb->key, player, pb->score[player],
+                               pb->score[player] + undo->captured);
+    }
+
+    pb->side[1 - player]  -= undo->taken;
+    pb->seeds[1 - player] -= undo->captured;
+    pb->score[player]     += undo->captured;
+
+    pb->toMove = 1 - player;
+    pb->key   ^= ZOBRIST_SIDE;
+}
+
+void unmakeMove(PackedBoard *pb, const MoveUndo *undo)
+{
+    int player = 1 - pb->toMove;
+    int pit    = undo->pit;
+    int s      = pbSideOf(pit);
+    int laps   = undo->seeds / 11;
+    int r      = undo->seeds - 11 * laps;
+
+    pb->toMove = player;
+
+    /* Restitue la capture */
+    pb->side[1 - player]  += undo->taken;
+    pb->seeds[1 - player] += undo->captured;
+    pb->score[player]     -= undo->captured;
+
+    /* Retire les graines semées et remplit la case d'origine */
+    pb->side[0] -= (uint64_t)laps * SOW_LAP[pit][0] + SOW_REM[pit][r][0];
+    pb->side[1] -= (uint64_t)laps * SOW_LAP[pit][1] + SOW_REM[pit][r][1];
+
+    pb->seeds[s]     -= laps * 5 + SOW_GAIN[pit][r][s];
+    pb->seeds[1 - s] -= laps * 6 + SOW_GAIN[pit][r][1 - s];
+
+    pb->side[s]  += (uint64_t)undo->seeds << pbShiftOf(pit);
+    pb->seeds[s] += undo->seeds;
+
+    pb->key = undo->key;
+}
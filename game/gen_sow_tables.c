@@ -0,0 +1,121 @@
+/*************************************************************************
+                           Awale -- Game (Sow tables generator)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Génère les tables des semailles utilisées par
+                           pbSow (lancé par le Makefile au moment du build)
+*************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Une case contient au plus toutes les graines du jeu */
+#define MAX_SEEDS 48
+
+/*
+ * Semailles de référence (même boucle que playMove) sur un plateau
+ * vide : compte les graines reçues par case et renvoie la dernière.
+ */
+static int sow_reference(int pit, int seeds, int inc[12])
+{
+    for (int i = 0; i < 12; i++)
+        inc[i] = 0;
+
+    int pos = pit;
+    while (seeds > 0) {
+        pos = (pos + 1) % 12;
+        if (pos == pit) continue;
+        inc[pos]++;
+        seeds--;
+    }
+    return pos;
+}
+
+/* Plateau d'incréments → deux mots compacts */
+static void pack_words(const int inc[12], uint64_t w[2])
+{
+    w[0] = w[1] = 0;
+    for (int i = 0; i < 12; i++)
+        w[i >= 6] |= (uint64_t)inc[i] << (8 * (i % 6));
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *out = stdout;
+
+    if (argc > 1) {
+        out = fopen(argv[1], "w");
+        if (!out) {
+            perror(argv[1]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    int inc[12];
+    uint64_t w[2];
+
+    fprintf(out,
+            "/* Fichier généré par game/gen_sow_tables.c : ne pas modifier */\n\n"
+            "#ifndef GAME_SOW_TABLES_H\n"
+            "#define GAME_SOW_TABLES_H\n\n");
+
+    /* Un tour complet : +1 partout sauf sur la case d'origine */
+    fprintf(out, "static const uint64_t SOW_LAP[12][2] = {\n");
+    for (int p = 0; p < 12; p++) {
+        sow_reference(p, 11, inc);
+        pack_words(inc, w);
+        fprintf(out, "    { 0x%016llXULL, 0x%016llXULL },\n",
+                (unsigned long long)w[0], (unsigned long long)w[1]);
+    }
+    fprintf(out, "};\n\n");
+
+    /* Reste r < 11 : +1 sur les r cases suivant l'origine */
+    fprintf(out, "static const uint64_t SOW_REM[12][11][2] = {\n");
+    for (int p = 0; p < 12; p++) {
+        fprintf(out, "    {\n");
+        for (int r = 0; r < 11; r++) {
+            sow_reference(p, r, inc);
+            pack_words(inc, w);
+            fprintf(out, "        { 0x%016llXULL, 0x%016llXULL },\n",
+                    (unsigned long long)w[0], (unsigned long long)w[1]);
+        }
+        fprintf(out, "    },\n");
+    }
+    fprintf(out, "};\n\n");
+
+    /* Graines reçues par chaque camp pour le reste r */
+    fprintf(out, "static const uint8_t SOW_GAIN[12][11][2] = {\n");
+    for (int p = 0; p < 12; p++) {
+        fprintf(out, "    {");
+        for (int r = 0; r < 11; r++) {
+            sow_reference(p, r, inc);
+            int g0 = 0, g1 = 0;
+            for (int i = 0; i < 6; i++)  g0 += inc[i];
+            for (int i = 6; i < 12; i++) g1 += inc[i];
+            fprintf(out, " { %d, %d },", g0, g1);
+        }
+        fprintf(out, " },\n");
+    }
+    fprintf(out, "};\n\n");
+
+    /* (case, graines) → dernière case ensemencée */
+    fprintf(out, "static const uint8_t SOW_LAST[12][%d] = {\n", MAX_SEEDS + 1);
+    for (int p = 0; p < 12; p++) {
+        fprintf(out, "    {");
+        for (int s = 0; s <= MAX_SEEDS; s++)
+            fprintf(out, "%s%d,", (s % 16 == 0) ? "\n        " : " ",
+                    sow_reference(p, s, inc));
+        fprintf(out, "\n    },\n");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "#endif /* GAME_SOW_TABLES_H */\n");
+
+    if (out != stdout)
+        fclose(out);
+
+    return 0;
+}
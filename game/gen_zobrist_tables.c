@@ -0,0 +1,80 @@
+/*************************************************************************
+                           Awale -- Game (Zobrist tables generator)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Génère les clés de Zobrist du plateau compact
+                           (lancé par le Makefile au moment du build)
+*************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Une case ou un score ne dépasse jamais 48 */
+#define MAX_SEEDS 48
+
+/*
+ * splitmix64 à graine fixe : les clés sont identiques d'un build à
+ * l'autre, ce qui permet de comparer des clés entre programmes.
+ */
+static uint64_t splitmix64(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void print_row(FILE *out, uint64_t *state, int n)
+{
+    fprintf(out, "    {");
+    for (int v = 0; v < n; v++) {
+        /* 0 graine dans une case = clé nulle : un plateau vide vaut 0 */
+        uint64_t k = (v == 0) ? 0 : splitmix64(state);
+        fprintf(out, "%s0x%016llXULL,", (v % 3 == 0) ? "\n        " : " ",
+                (unsigned long long)k);
+    }
+    fprintf(out, "\n    },\n");
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *out = stdout;
+
+    if (argc > 1) {
+        out = fopen(argv[1], "w");
+        if (!out) {
+            perror(argv[1]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    uint64_t state = 0x41574C45ULL;   /* "AWLE" */
+
+    fprintf(out,
+            "/* Fichier généré par game/gen_zobrist_tables.c : ne pas modifier */\n\n"
+            "#ifndef GAME_ZOBRIST_TABLES_H\n"
+            "#define GAME_ZOBRIST_TABLES_H\n\n");
+
+    fprintf(out, "static const uint64_t ZOBRIST_PIT[12][%d] = {\n", MAX_SEEDS + 1);
+    for (int p = 0; p < 12; p++)
+        print_row(out, &state, MAX_SEEDS + 1);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const uint64_t ZOBRIST_SCORE[2][%d] = {\n", MAX_SEEDS + 1);
+    for (int p = 0; p < 2; p++)
+        print_row(out, &state, MAX_SEEDS + 1);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const uint64_t ZOBRIST_SIDE = 0x%016llXULL;\n\n",
+            (unsigned long long)splitmix64(&state));
+
+    fprintf(out, "#endif /* GAME_ZOBRIST_TABLES_H */\n");
+
+    if (out != stdout)
+        fclose(out);
+
+    return 0;
+}
@@ -0,0 +1,270 @@
+/* Fichier généré par game/gen_sow_tables.c : ne pas modifier */
+
+#ifndef GAME_SOW_TABLES_H
+#define GAME_SOW_TABLES_H
+
+static const uint64_t SOW_LAP[12][2] = {
+    { 0x0000010101010100ULL, 0x0000010101010101ULL },
+    { 0x0000010101010001ULL, 0x0000010101010101ULL },
+    { 0x0000010101000101ULL, 0x0000010101010101ULL },
+    { 0x0000010100010101ULL, 0x0000010101010101ULL },
+    { 0x0000010001010101ULL, 0x0000010101010101ULL },
+    { 0x0000000101010101ULL, 0x0000010101010101ULL },
+    { 0x0000010101010101ULL, 0x0000010101010100ULL },
+    { 0x0000010101010101ULL, 0x0000010101010001ULL },
+    { 0x0000010101010101ULL, 0x0000010101000101ULL },
+    { 0x0000010101010101ULL, 0x0000010100010101ULL },
+    { 0x0000010101010101ULL, 0x0000010001010101ULL },
+    { 0x0000010101010101ULL, 0x0000000101010101ULL },
+};
+
+static const uint64_t SOW_REM[12][11][2] = {
+    {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000100ULL, 0x0000000000000000ULL },
+        { 0x0000000000010100ULL, 0x0000000000000000ULL },
+        { 0x0000000001010100ULL, 0x0000000000000000ULL },
+        { 0x0000000101010100ULL, 0x0000000000000000ULL },
+        { 0x0000010101010100ULL, 0x0000000000000000ULL },
+        { 0x0000010101010100ULL, 0x0000000000000001ULL },
+        { 0x0000010101010100ULL, 0x0000000000000101ULL },
+        { 0x0000010101010100ULL, 0x0000000000010101ULL },
+        { 0x0000010101010100ULL, 0x0000000001010101ULL },
+        { 0x0000010101010100ULL, 0x0000000101010101ULL },
+    },
+    {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000010000ULL, 0x0000000000000000ULL },
+        { 0x0000000001010000ULL, 0x0000000000000000ULL },
+        { 0x0000000101010000ULL, 0x0000000000000000ULL },
+        { 0x0000010101010000ULL, 0x0000000000000000ULL },
+        { 0x0000010101010000ULL, 0x0000000000000001ULL },
+        { 0x0000010101010000ULL, 0x0000000000000101ULL },
+        { 0x0000010101010000ULL, 0x0000000000010101ULL },
+        { 0x0000010101010000ULL, 0x0000000001010101ULL },
+        { 0x0000010101010000ULL, 0x0000000101010101ULL },
+        { 0x0000010101010000ULL, 0x0000010101010101ULL },
+    },
+    {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000001000000ULL, 0x0000000000000000ULL },
+        { 0x0000000101000000ULL, 0x0000000000000000ULL },
+        { 0x0000010101000000ULL, 0x0000000000000000ULL },
+        { 0x0000010101000000ULL, 0x0000000000000001ULL },
+        { 0x0000010101000000ULL, 0x0000000000000101ULL },
+        { 0x0000010101000000ULL, 0x0000000000010101ULL },
+        { 0x0000010101000000ULL, 0x0000000001010101ULL },
+        { 0x0000010101000000ULL, 0x0000000101010101ULL },
+        { 0x0000010101000000ULL, 0x0000010101010101ULL },
+        { 0x0000010101000001ULL, 0x0000010101010101ULL },
+    },
+    {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000100000000ULL, 0x0000000000000000ULL },
+        { 0x0000010100000000ULL, 0x0000000000000000ULL },
+        { 0x0000010100000000ULL, 0x0000000000000001ULL },
+        { 0x0000010100000000ULL, 0x0000000000000101ULL },
+        { 0x0000010100000000ULL, 0x0000000000010101ULL },
+        { 0x0000010100000000ULL, 0x0000000001010101ULL },
+        { 0x0000010100000000ULL, 0x0000000101010101ULL },
+        { 0x0000010100000000ULL, 0x0000010101010101ULL },
+        { 0x0000010100000001ULL, 0x0000010101010101ULL },
+        { 0x0000010100000101ULL, 0x0000010101010101ULL },
+    },
+    {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000010000000000ULL, 0x0000000000000000ULL },
+        { 0x0000010000000000ULL, 0x0000000000000001ULL },
+        { 0x0000010000000000ULL, 0x0000000000000101ULL },
+        { 0x0000010000000000ULL, 0x0000000000010101ULL },
+        { 0x0000010000000000ULL, 0x0000000001010101ULL },
+        { 0x0000010000000000ULL, 0x0000000101010101ULL },
+        { 0x0000010000000000ULL, 0x0000010101010101ULL },
+        { 0x0000010000000001ULL, 0x0000010101010101ULL },
+        { 0x0000010000000101ULL, 0x0000010101010101ULL },
+        { 0x0000010000010101ULL, 0x0000010101010101ULL },
+    },
+    {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000001ULL },
+        { 0x0000000000000000ULL, 0x0000000000000101ULL },
+        { 0x0000000000000000ULL, 0x0000000000010101ULL },
+        { 0x0000000000000000ULL, 0x0000000001010101ULL },
+        { 0x0000000000000000ULL, 0x0000000101010101ULL },
+        { 0x0000000000000000ULL, 0x0000010101010101ULL },
+        { 0x0000000000000001ULL, 0x0000010101010101ULL },
+        { 0x0000000000000101ULL, 0x0000010101010101ULL },
+        { 0x0000000000010101ULL, 0x0000010101010101ULL },
+        { 0x0000000001010101ULL, 0x0000010101010101ULL },
+    },
+    {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000100ULL },
+        { 0x0000000000000000ULL, 0x0000000000010100ULL },
+        { 0x0000000000000000ULL, 0x0000000001010100ULL },
+        { 0x0000000000000000ULL, 0x0000000101010100ULL },
+        { 0x0000000000000000ULL, 0x0000010101010100ULL },
+        { 0x0000000000000001ULL, 0x0000010101010100ULL },
+        { 0x0000000000000101ULL, 0x0000010101010100ULL },
+        { 0x0000000000010101ULL, 0x0000010101010100ULL },
+        { 0x0000000001010101ULL, 0x0000010101010100ULL },
+        { 0x0000000101010101ULL, 0x0000010101010100ULL },
+    },
+    {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000010000ULL },
+        { 0x0000000000000000ULL, 0x0000000001010000ULL },
+        { 0x0000000000000000ULL, 0x0000000101010000ULL },
+        { 0x0000000000000000ULL, 0x0000010101010000ULL },
+        { 0x0000000000000001ULL, 0x0000010101010000ULL },
+        { 0x0000000000000101ULL, 0x0000010101010000ULL },
+        { 0x0000000000010101ULL, 0x0000010101010000ULL },
+        { 0x0000000001010101ULL, 0x0000010101010000ULL },
+        { 0x0000000101010101ULL, 0x0000010101010000ULL },
+        { 0x0000010101010101ULL, 0x0000010101010000ULL },
+    },
+    {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000001000000ULL },
+        { 0x0000000000000000ULL, 0x0000000101000000ULL },
+        { 0x0000000000000000ULL, 0x0000010101000000ULL },
+        { 0x0000000000000001ULL, 0x0000010101000000ULL },
+        { 0x0000000000000101ULL, 0x0000010101000000ULL },
+        { 0x0000000000010101ULL, 0x0000010101000000ULL },
+        { 0x0000000001010101ULL, 0x0000010101000000ULL },
+        { 0x0000000101010101ULL, 0x0000010101000000ULL },
+        { 0x0000010101010101ULL, 0x0000010101000000ULL },
+        { 0x0000010101010101ULL, 0x0000010101000001ULL },
+    },
+    {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000100000000ULL },
+        { 0x0000000000000000ULL, 0x0000010100000000ULL },
+        { 0x0000000000000001ULL, 0x0000010100000000ULL },
+        { 0x0000000000000101ULL, 0x0000010100000000ULL },
+        { 0x0000000000010101ULL, 0x0000010100000000ULL },
+        { 0x0000000001010101ULL, 0x0000010100000000ULL },
+        { 0x0000000101010101ULL, 0x0000010100000000ULL },
+        { 0x0000010101010101ULL, 0x0000010100000000ULL },
+        { 0x0000010101010101ULL, 0x0000010100000001ULL },
+        { 0x0000010101010101ULL, 0x0000010100000101ULL },
+    },
+    {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000010000000000ULL },
+        { 0x0000000000000001ULL, 0x0000010000000000ULL },
+        { 0x0000000000000101ULL, 0x0000010000000000ULL },
+        { 0x0000000000010101ULL, 0x0000010000000000ULL },
+        { 0x0000000001010101ULL, 0x0000010000000000ULL },
+        { 0x0000000101010101ULL, 0x0000010000000000ULL },
+        { 0x0000010101010101ULL, 0x0000010000000000ULL },
+        { 0x0000010101010101ULL, 0x0000010000000001ULL },
+        { 0x0000010101010101ULL, 0x0000010000000101ULL },
+        { 0x0000010101010101ULL, 0x0000010000010101ULL },
+    },
+    {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000001ULL, 0x0000000000000000ULL },
+        { 0x0000000000000101ULL, 0x0000000000000000ULL },
+        { 0x0000000000010101ULL, 0x0000000000000000ULL },
+        { 0x0000000001010101ULL, 0x0000000000000000ULL },
+        { 0x0000000101010101ULL, 0x0000000000000000ULL },
+        { 0x0000010101010101ULL, 0x0000000000000000ULL },
+        { 0x0000010101010101ULL, 0x0000000000000001ULL },
+        { 0x0000010101010101ULL, 0x0000000000000101ULL },
+        { 0x0000010101010101ULL, 0x0000000000010101ULL },
+        { 0x0000010101010101ULL, 0x0000000001010101ULL },
+    },
+};
+
+static const uint8_t SOW_GAIN[12][11][2] = {
+    { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 5, 0 }, { 5, 1 }, { 5, 2 }, { 5, 3 }, { 5, 4 }, { 5, 5 }, },
+    { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 4, 1 }, { 4, 2 }, { 4, 3 }, { 4, 4 }, { 4, 5 }, { 4, 6 }, },
+    { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 }, { 3, 1 }, { 3, 2 }, { 3, 3 }, { 3, 4 }, { 3, 5 }, { 3, 6 }, { 4, 6 }, },
+    { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 2, 1 }, { 2, 2 }, { 2, 3 }, { 2, 4 }, { 2, 5 }, { 2, 6 }, { 3, 6 }, { 4, 6 }, },
+    { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 1, 2 }, { 1, 3 }, { 1, 4 }, { 1, 5 }, { 1, 6 }, { 2, 6 }, { 3, 6 }, { 4, 6 }, },
+    { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }, { 0, 6 }, { 1, 6 }, { 2, 6 }, { 3, 6 }, { 4, 6 }, },
+    { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }, { 1, 5 }, { 2, 5 }, { 3, 5 }, { 4, 5 }, { 5, 5 }, },
+    { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 1, 4 }, { 2, 4 }, { 3, 4 }, { 4, 4 }, { 5, 4 }, { 6, 4 }, },
+    { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 1, 3 }, { 2, 3 }, { 3, 3 }, { 4, 3 }, { 5, 3 }, { 6, 3 }, { 6, 4 }, },
+    { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 1, 2 }, { 2, 2 }, { 3, 2 }, { 4, 2 }, { 5, 2 }, { 6, 2 }, { 6, 3 }, { 6, 4 }, },
+    { { 0, 0 }, { 0, 1 }, { 1, 1 }, { 2, 1 }, { 3, 1 }, { 4, 1 }, { 5, 1 }, { 6, 1 }, { 6, 2 }, { 6, 3 }, { 6, 4 }, },
+    { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 5, 0 }, { 6, 0 }, { 6, 1 }, { 6, 2 }, { 6, 3 }, { 6, 4 }, },
+};
+
+static const uint8_t SOW_LAST[12][49] = {
+    {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 1, 2, 3, 4,
+        5, 6, 7, 8, 9, 10, 11, 1, 2, 3, 4, 5, 6, 7, 8, 9,
+        10, 11, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 1, 2, 3,
+        4,
+    },
+    {
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 2, 3, 4, 5,
+        6, 7, 8, 9, 10, 11, 0, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+        11, 0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 2, 3, 4,
+        5,
+    },
+    {
+        2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 3, 4, 5, 6,
+        7, 8, 9, 10, 11, 0, 1, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+        0, 1, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 3, 4, 5,
+        6,
+    },
+    {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 4, 5, 6, 7,
+        8, 9, 10, 11, 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 0,
+        1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 4, 5, 6,
+        7,
+    },
+    {
+        4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 3, 5, 6, 7, 8,
+        9, 10, 11, 0, 1, 2, 3, 5, 6, 7, 8, 9, 10, 11, 0, 1,
+        2, 3, 5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 3, 5, 6, 7,
+        8,
+    },
+    {
+        5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 3, 4, 6, 7, 8, 9,
+        10, 11, 0, 1, 2, 3, 4, 6, 7, 8, 9, 10, 11, 0, 1, 2,
+        3, 4, 6, 7, 8, 9, 10, 11, 0, 1, 2, 3, 4, 6, 7, 8,
+        9,
+    },
+    {
+        6, 7, 8, 9, 10, 11, 0, 1, 2, 3, 4, 5, 7, 8, 9, 10,
+        11, 0, 1, 2, 3, 4, 5, 7, 8, 9, 10, 11, 0, 1, 2, 3,
+        4, 5, 7, 8, 9, 10, 11, 0, 1, 2, 3, 4, 5, 7, 8, 9,
+        10,
+    },
+    {
+        7, 8, 9, 10, 11, 0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11,
+        0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 0, 1, 2, 3, 4,
+        5, 6, 8, 9, 10, 11, 0, 1, 2, 3, 4, 5, 6, 8, 9, 10,
+        11,
+    },
+    {
+        8, 9, 10, 11, 0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 0,
+        1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 0, 1, 2, 3, 4, 5,
+        6, 7, 9, 10, 11, 0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11,
+        0,
+    },
+    {
+        9, 10, 11, 0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 11, 0, 1,
+        2, 3, 4, 5, 6, 7, 8, 10, 11, 0, 1, 2, 3, 4, 5, 6,
+        7, 8, 10, 11, 0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 11, 0,
+        1,
+    },
+    {
+        10, 11, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 0, 1, 2,
+        3, 4, 5, 6, 7, 8, 9, 11, 0, 1, 2, 3, 4, 5, 6, 7,
+        8, 9, 11, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 0, 1,
+        2,
+    },
+    {
+        11, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 1, 2, 3,
+        4, 5, 6, 7, 8, 9, 10, 0, 1, 2, 3, 4, 5, 6, 7, 8,
+        9, 10, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 1, 2,
+        3,
+    },
+};
+
+#endif /* GAME_SOW_TABLES_H */
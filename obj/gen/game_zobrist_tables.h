@@ -0,0 +1,280 @@
+/* Fichier généré par game/gen_zobrist_tables.c : ne pas modifier */
+
+#ifndef GAME_ZOBRIST_TABLES_H
+#define GAME_ZOBRIST_TABLES_H
+
+static const uint64_t ZOBRIST_PIT[12][49] = {
+    {
+        0x0000000000000000ULL, 0x31DF404FF403D41EULL, 0x5389DCCF55332464ULL,
+        0x9B24FA74FC5EE921ULL, 0xC3EA8C517F2F6896ULL, 0x21E8C9B57F387508ULL,
+        0x16A4CA015258D1BEULL, 0xDC78C1652E353888ULL, 0xAED29CD4739CFF72ULL,
+        0x9DD1407D12FB6869ULL, 0xC27777E017417B5BULL, 0x845E952AFC370FCCULL,
+        0xE718F30D1D0DB7C5ULL, 0xA73AE1E02357D7D2ULL, 0xF4E35BCB94F25AFEULL,
+        0xB2E25F8FE42B3ED9ULL, 0xC45C504A9BDA0991ULL, 0xB359B590BC5E497CULL,
+        0x89F31CC540D5AFD3ULL, 0x7FECF331D3B7CC1DULL, 0x12D3EA81A28D9E85ULL,
+        0x464E733737EFDE83ULL, 0xAF582370924670B2ULL, 0x572BB3124719BEC1ULL,
+        0x15894B8AB2C202B2ULL, 0xB188906789BCF244ULL, 0x15430CB99CDCB9EFULL,
+        0x87BFCA2CA7A00105ULL, 0x44D41DF7C66DC210ULL, 0xA5872D265DB7B9CCULL,
+        0xF0792923974853C4ULL, 0x7413C0254EF24328ULL, 0xF5DCC889274B4C6EULL,
+        0x34F29C7A2B5D36F5ULL, 0x49F49F38E26532BDULL, 0x15EA7DADA145E3F4ULL,
+        0x7F73729BF6DB29AFULL, 0xD415C73C25C4A1A8ULL, 0xEF65BCA339F26F59ULL,
+        0x6DD6728D269E9816ULL, 0xEC99BAB62DECA7C6ULL, 0x5199C6B3CD8138F9ULL,
+        0xC95ED2B255E7A106ULL, 0x270E51E51EB1CCABULL, 0xB22F4FB3CEEB6D0CULL,
+        0x81F23CBBFF59E1BCULL, 0xD5FD612A057664B6ULL, 0xE3AE34B75D3A8817ULL,
+        0xDE2058709411ECD0ULL,
+    },
+    {
+        0x0000000000000000ULL, 0x9193B2529A0C24F7ULL, 0x60DB3A19CF6C26E9ULL,
+        0x329A368551CB68D9ULL, 0xA28CDDCEBE67FF20ULL, 0x1521DC4A158F3B5DULL,
+        0x15D05C0CFD9A7A56ULL, 0x45A7CDDD7DCED29AULL, 0xAD3CE9B418A5A3E7ULL,
+        0x328C93004AC28FC0ULL, 0x659139CDECE01581ULL, 0xE32E16C09710DC2CULL,
+        0xA12557F0E9E0CBA7ULL, 0x58EEFD516D9BBBCCULL, 0x35A44CD29F414231ULL,
+        0x3A6ABDA98A3C63C0ULL, 0x2CC2AFED97B0B7A6ULL, 0x00CD4D30362B5342ULL,
+        0x7FA10B59DA390275ULL, 0x4D06511C673CB299ULL, 0x7EDB6A1BDAC4B142ULL,
+        0xF9EAA1089DA6D52BULL, 0x2A2418142AE627B0ULL, 0xC95AC678D7D09434ULL,
+        0x5C1E78D3C868D9FDULL, 0xEC1A95400F7B2CD2ULL, 0xA07F3061614D2481ULL,
+        0x64E71326B6E90F10ULL, 0xCA25B18FE6ECCE70ULL, 0xF0D83323CF0FD5A9ULL,
+        0x0377E88CF9D81783ULL, 0x255A72ED1EFF7B03ULL, 0x70270D5E36AC33A4ULL,
+        0xBE26792B7B5471D6ULL, 0x89577335631A6659ULL, 0x83721222F60AE41CULL,
+        0x18364670D3FE60AFULL, 0xC20020388B069950ULL, 0x9983251C5E3A01CAULL,
+        0x28313BBBC9F4CAF9ULL, 0xB0587DB20F8BAA31ULL, 0x867D4CC030F43DC8ULL,
+        0xA534AD3E1BB441A1ULL, 0xCA509FA1D3929B6DULL, 0xCED0B6AEF61C9596ULL,
+        0x6E83F35E7B9BA0D7ULL, 0x3F006FADC82F9933ULL, 0x2C1ACF2759CF738EULL,
+        0xDC7AFBDECDAF4C4CULL,
+    },
+    {
+        0x0000000000000000ULL, 0x524C603BBC79BF12ULL, 0x783206892194B4ACULL,
+        0xAA7DC31197727135ULL, 0x5A35A0D87898996CULL, 0x4EC350614325FC6DULL,
+        0x8FC5D8469F3DFFE7ULL, 0x188EE392F6D3B186ULL, 0xA13386EF4C7D6008ULL,
+        0xEE6A284742CBC196ULL, 0xC1A77BB75705EC6AULL, 0xB8B13AFE0F82E12AULL,
+        0xD180536EF5AD7AB3ULL, 0x4399B8F454464658ULL, 0x162B1CB7CDF31770ULL,
+        0x59F50B9EBCC39D90ULL, 0x0B043486A34E7298ULL, 0xF6BB9267041CEBC4ULL,
+        0xB3554A6A50E4F436ULL, 0x8D33C81D3C106BCDULL, 0xB50CADEFF73415CCULL,
+        0x8742925563D007D4ULL, 0x99154D2684A5B9F0ULL, 0x1B7E6655F9E7DCA3ULL,
+        0x8165B93E6957DF25ULL, 0x062576167DBCC885ULL, 0x374568AB010AADBAULL,
+        0xE331E103B775E493ULL, 0x6FB31C87B108A3E7ULL, 0x702C8F08896EE8D4ULL,
+        0xD45BA5424B9DEE30ULL, 0x68CD81D03CD2FD0AULL, 0xFCDF950E80E03297ULL,
+        0x91DEFC435B32562DULL, 0x2C23DE4E3EF1C28BULL, 0x0619E55FF9717A3EULL,
+        0x13D574629D3A71D5ULL, 0xB107B347FDA71790ULL, 0x772BC2045B75EAD7ULL,
+        0x80E4DAC8E9F03504ULL, 0x7C6B9EA9F0B2EEB9ULL, 0x71E362D0EF0EC6BCULL,
+        0x5DE84A6D8774B35FULL, 0xAEB32BF9FA2770E4ULL, 0x634B12D8BA4ED607ULL,
+        0x0BC277E6F5CB55B2ULL, 0xE1B292C041FC6B17ULL, 0x610876455AC0BBE5ULL,
+        0x063BA87D489E8856ULL,
+    },
+    {
+        0x0000000000000000ULL, 0xB461F9A80A568C13ULL, 0x9383B63E9B27A023ULL,
+        0x853C6791BD3450A2ULL, 0x42CB07E2A74DEA29ULL, 0x0FF6834DFCBBB5B1ULL,
+        0x9365E134C4D3890BULL, 0xA08C82440569AD91ULL, 0x29211BB686EF67CBULL,
+        0x98CBCBF41383A409ULL, 0x013B8A5F4634CEB3ULL, 0xAC342C40CE8A9DF7ULL,
+        0x5FC8D0CF90D121A6ULL, 0x9269451B172E73A1ULL, 0x818BDF91C2D1751CULL,
+        0x21ED15FC627197DCULL, 0x8A55435DB704A825ULL, 0x9CE72C774D1A1FBBULL,
+        0xEEAD19E3F670AAFEULL, 0x4BBC84E91EB3E6BAULL, 0x949131CB2BF4C2A3ULL,
+        0x2F41C0AAEEA2F356ULL, 0xBCDB5B8C2C03F6E3ULL, 0x393A95FDC7391030ULL,
+        0x7D0E8C7845271C77ULL, 0x46917EDE9506EAEBULL, 0x6C6596BBF42B58C2ULL,
+        0x03992BBBB6A8256EULL, 0x53B4B00ABBE2701DULL, 0x14C5BE8CB6C31631ULL,
+        0x9B865959F7B48E93ULL, 0x378E650CDF6F3374ULL, 0x7DBE87CF525B0515ULL,
+        0x00FE3B53687E815EULL, 0x79FA1975C569CFA3ULL, 0x39D88FA520B8E18EULL,
+        0x1C17522945AD2071ULL, 0xDF49773D620A221AULL, 0x0838C12730CE8D54ULL,
+        0xF22638405AEE1FF6ULL, 0xB4E306D7F5E15A5EULL, 0xA193138DF7C1D271ULL,
+        0xF5D16B64618427BEULL, 0x8C470E8FC3CE166FULL, 0x7774385BFDC2993FULL,
+        0x0CB5618F8C0126C1ULL, 0x760717AE38BC0F15ULL, 0x5BED7DFE1BE6856AULL,
+        0xDB9332B777C01BC3ULL,
+    },
+    {
+        0x0000000000000000ULL, 0xE85B1B2504E588A2ULL, 0xC3A4858A1D617315ULL,
+        0x49286609438DEDF5ULL, 0x3B0D10E11093ADCBULL, 0x04E7710A06E75E05ULL,
+        0x8C253BAB54466483ULL, 0x37CDAC7E93BCF778ULL, 0x89F7FFF4ECE85E2CULL,
+        0x10A7ABC73F0DA8EDULL, 0x7E9B43E5D7351B15ULL, 0x1933E12AA5A4C957ULL,
+        0x659F2E8B7E772824ULL, 0x0D49D775B9E2DD3CULL, 0x7DDF1846D5B6409AULL,
+        0x3A5B09ED89774154ULL, 0xEC5017D15F9D6ABEULL, 0x2EECA3C107753E17ULL,
+        0xF61978A7A10DAF8CULL, 0x171D5C92F6B02528ULL, 0x6DFB345824783FE3ULL,
+        0x811FFE377920C59AULL, 0x136B3D7E4A05AE9EULL, 0x734731E4D1B4CBCBULL,
+        0x0902C94EBA7B93ECULL, 0xCD7D5360597134F7ULL, 0x2441F781AD5CE267ULL,
+        0x2D67AA2345F25249ULL, 0xAC55BDC6FA030702ULL, 0xF962CD1F1C7BA51EULL,
+        0xCCB530973087A1DCULL, 0x1B119DE274E472E8ULL, 0x30479C9F9632CAD6ULL,
+        0xFF5D23F40F78E1F0ULL, 0x26DDE733E68DBE6FULL, 0xFEEC7BDB80DB66F2ULL,
+        0x489AECAB454A0E12ULL, 0xB996AB87118C7EB9ULL, 0xE3DEF57B89310B4EULL,
+        0x0C8D2B1A6290461AULL, 0x1582728EA214ADE1ULL, 0xCF7D0256CD2EEFA5ULL,
+        0x1E06146B7CD3C487ULL, 0x05735B58DF7772B3ULL, 0x64EF6D7426AB7696ULL,
+        0xB13A0C1EC4824E5CULL, 0x9D3239E027B1F7D2ULL, 0x06879F597F4835DEULL,
+        0x8C0A5DC1E0B8A1ADULL,
+    },
+    {
+        0x0000000000000000ULL, 0x0D95F5FD95422263ULL, 0xC491DC66057F6EC5ULL,
+        0xA0A413EA1829DBCFULL, 0xE8FD4F1F435F4707ULL, 0x5EE4B3CC269870EDULL,
+        0xFB7D253B1807D339ULL, 0xE95459F5C347D6E1ULL, 0x6C936A415823F66BULL,
+        0xA84AC5F976918EBCULL, 0xCCBD98C486532685ULL, 0xC12EBE747DEC4647ULL,
+        0xCE582B0DE1DDA71EULL, 0x3CEFD7F3DB726604ULL, 0x75546DA572A32C8DULL,
+        0xAE8A85C43C285B02ULL, 0xFBA70B5FD26C57EFULL, 0xB426038F5D6D1908ULL,
+        0x5DF7E94690E81D9AULL, 0x4BC1CD1DEDF0376FULL, 0x8B1A9B5BE161B0BEULL,
+        0x30C4A69847F91E97ULL, 0xD4A0FCC2E7B2F279ULL, 0xFC4E6C8CCF796273ULL,
+        0xC6987B71FF157C78ULL, 0x96E6C4B1B107E6C8ULL, 0xC4601B2D0C70871BULL,
+        0x1208A5162C04561BULL, 0xF5773951BA4339D3ULL, 0xCB21B86F49E48D47ULL,
+        0xE347B81F082A1C1FULL, 0x8688FF55563A1FFBULL, 0xFE92489B93BB2418ULL,
+        0xD3E1487B5E69AF4BULL, 0x6F89D794AB270078ULL, 0x6B103E50CC90DB59ULL,
+        0xEBB00133AC8C93B3ULL, 0x884E53E93DF5FA4CULL, 0x1CE89E273884DB04ULL,
+        0xEF1BC34360911A8EULL, 0xEF734BA4CB645DF3ULL, 0x449A44994E56861DULL,
+        0x0DE3BBB679853383ULL, 0x4261DD4BF70AC082ULL, 0xA1BC7D38AAFCD335ULL,
+        0x0495491F162CAF30ULL, 0x98960765BCC3D902ULL, 0x73977B3A277CEE7EULL,
+        0xA52FBC50F37F5152ULL,
+    },
+    {
+        0x0000000000000000ULL, 0x62042EBF980121C8ULL, 0xB808C1B55CBB8B8FULL,
+        0x3840DE43702916BBULL, 0xD655499166A1EFC4ULL, 0xA4A5B1A793CC77D4ULL,
+        0x24537156A61D7172ULL, 0xF110A77358D10805ULL, 0x91F98DB797682CB7ULL,
+        0x22144656DA0E808EULL, 0x5E08EFF12F5C3CD3ULL, 0x182BC02BAB35D2C9ULL,
+        0xF74B23496ED4F204ULL, 0xEBEB099DB8535442ULL, 0x1A14FDB07A80655CULL,
+        0xBE39DABCA8306F85ULL, 0x4D861E871A4C3C8DULL, 0x223A46D81F285D01ULL,
+        0xEC422BDBA81D8BB1ULL, 0x9B5C51AFA9267487ULL, 0xBE96E09B26E770F7ULL,
+        0x0E18592C88996D90ULL, 0x4FB6E1BBFAB03D41ULL, 0x3E408705C8F5E543ULL,
+        0x7A9A820667B5937CULL, 0x9F7ABA84E9D1F124ULL, 0xFBFDA0AFE2A61093ULL,
+        0x39A62B25C216A6E3ULL, 0xD69AA614C68A2A50ULL, 0x304433A5C8D02EFDULL,
+        0xD6E35473313E4637ULL, 0x7B073ACE4A9E04A1ULL, 0x96E9E54C781E4A37ULL,
+        0x7E85EA673BCFD708ULL, 0x54ADD2303BA25E45ULL, 0x4D4A597EF188C370ULL,
+        0x9C24B66458CD16DDULL, 0x1CA19885E863AC44ULL, 0xF8705EB2C5951141ULL,
+        0xD076FDF1BA51D6B0ULL, 0xB70233E41104B8C5ULL, 0x7C0CF4C6369AE2EAULL,
+        0x51A754E84106722FULL, 0xEC6726A20F2C4985ULL, 0x4736A2A96586CC57ULL,
+        0xB47D53F314B72053ULL, 0xB2543578C310D930ULL, 0x828DB4B25BB4183AULL,
+        0x4332626F4D3C62C6ULL,
+    },
+    {
+        0x0000000000000000ULL, 0xCF015B7B27A6C9E0ULL, 0xBAA697FCCD5F387CULL,
+        0xADCFF392BA44B78FULL, 0x14956DD15FF7A9A4ULL, 0x25854ACF7C5AB808ULL,
+        0xF1EDD2AC44347A60ULL, 0xA1B99FEECA730361ULL, 0x6D50BE26D1E25A3DULL,
+        0x7772A11E70BC1851ULL, 0x8E1F008D89CA3783ULL, 0x3B88F164EA087AE5ULL,
+        0xC4F6E855EA64EB21ULL, 0xDACCB05825DC18E5ULL, 0x5AEF46CCD739EC2FULL,
+        0x44830E4255DE8FC7ULL, 0xE758119E4411AF1BULL, 0x0310336D8D5A9792ULL,
+        0x7FD78C8A693769CBULL, 0x7FB4AC9E6BDF9F7EULL, 0x9C36EEF1A7367840ULL,
+        0x6FB8E63FBB18E80DULL, 0x14D4799DC7B96EFCULL, 0x8CC3FC9145C9F6FDULL,
+        0xAB7E521C60E3B68FULL, 0x2373B12AF3185B3BULL, 0xCCBE493F0E6A6B18ULL,
+        0x18B461834810732DULL, 0x095FE0233987640AULL, 0x010AC539A7075684ULL,
+        0x28BCF5EBC714E1D4ULL, 0x9BA98EB4B477749AULL, 0x21C70167D8F0F455ULL,
+        0xB2CD9A3FED7923C8ULL, 0x25E561384EB0FD6CULL, 0x229CD3D0247DC884ULL,
+        0x3959C60C158D165AULL, 0x309DABA579DCC81CULL, 0x61450DC1DF10D31CULL,
+        0x7535FFC9D6AC18D1ULL, 0x08AE188A38A058BAULL, 0x789D17A2128EF793ULL,
+        0x19D90C7FF1CF7E66ULL, 0x0410FBB1C80C35FEULL, 0x0A5C150813EAF92CULL,
+        0xAB7C02FBA9E6D276ULL, 0x1A0076F1251284BAULL, 0xCE301DFCC31FB299ULL,
+        0x030E6ECBFB3F62DCULL,
+    },
+    {
+        0x0000000000000000ULL, 0x32CAE46625A23696ULL, 0x1227F853056803CDULL,
+        0x30E48E5B11C5CFD5ULL, 0x03F7684E959D3695ULL, 0x4EF6A628F63F045DULL,
+        0x7AAFB79B3891071EULL, 0xD0F049A377920602ULL, 0x7984D6A5345F3DDDULL,
+        0x6ABE95AD8D5E428DULL, 0x8C27DFA260CA3D47ULL, 0x968A13DD14B26F56ULL,
+        0x135FD366647233FFULL, 0x19B668F73C172211ULL, 0x718DC21C88C8B2C8ULL,
+        0x703D08EEE58BE3D0ULL, 0xCDFFB8BFCA93D91BULL, 0x535AAF67E97DB343ULL,
+        0x9009052F6F2A8A52ULL, 0xEB5A9A96E7647581ULL, 0x2AB187B1DCD6CAA9ULL,
+        0x64E23BC02105EAD3ULL, 0x866BDB32436BC5CBULL, 0x7BE02D97570C1398ULL,
+        0x50A278D7C9867DA7ULL, 0x9D0CAC0B2450C543ULL, 0x780320639F11F962ULL,
+        0xD2C8A5ED5D80263BULL, 0x239455394C38979DULL, 0x17DD957F71B0A102ULL,
+        0xED4C2C68FEB8CDA5ULL, 0x049BA0C248E7EEB2ULL, 0x9EA9A4F3F83CDAACULL,
+        0xA83B108EBEADEF29ULL, 0x63153835A74C88E9ULL, 0xBA71FA35D8E3187AULL,
+        0x880692B2FF4B345DULL, 0xD92134A2E0297EDAULL, 0x51FEC01F95ABCF32ULL,
+        0x00D60B0DDB988444ULL, 0xB8057E8525F03B47ULL, 0xCE169B2D393F81D1ULL,
+        0xCF0B3F9AB8B414C2ULL, 0xEDF687D261996C55ULL, 0x6C59910E8248AE2EULL,
+        0xD9709103A72A5327ULL, 0xCD8D49ED22F6FD7BULL, 0x4D20C192D2E38378ULL,
+        0xD1339F82A5A4E22DULL,
+    },
+    {
+        0x0000000000000000ULL, 0xAC49D757E7D4AE48ULL, 0x55E14AA6611D3AFCULL,
+        0x03C64820A102DC79ULL, 0x299F1985335B4846ULL, 0x2DFE77FAF43F493DULL,
+        0x3EC39CBF25722406ULL, 0x593687E103C7955DULL, 0xAE549A7AEB139677ULL,
+        0x8CE9DFD9BC369EB3ULL, 0x2CA10CCF9D125646ULL, 0x690FAC22E6630F15ULL,
+        0x2AF023925F318EF3ULL, 0x5D75251249434626ULL, 0x218F069BB4E15302ULL,
+        0xD0183765493C3F9CULL, 0x0298BB55B17DF7C2ULL, 0x8C62C43352E35D95ULL,
+        0x98AE52D3A4D4A5C9ULL, 0x4B60A8AC5DCA39F7ULL, 0xCC6E362CE04F3403ULL,
+        0xBE1EC2B372E045DCULL, 0x558860853A708D60ULL, 0x6C25DEAA4C594890ULL,
+        0x879E5D8EFDBA0609ULL, 0x061E5BD743934983ULL, 0xF86653E75A0A5049ULL,
+        0xDF7EDEEE60D13490ULL, 0x7585D05556CD11BDULL, 0x13888A295BD6DFE7ULL,
+        0xC30B4DD9320A278EULL, 0xD4F0CF876A397714ULL, 0x0E4E860D9054879DULL,
+        0xC996FA8CD6743542ULL, 0xB5AB523C4B714519ULL, 0x3F806EF213774726ULL,
+        0x100266496BB3126FULL, 0x784641390D7EAAFEULL, 0x14043187A3BAAF63ULL,
+        0x4176415FAB66B974ULL, 0x4A7E613719772100ULL, 0x609CE89F84E81FA7ULL,
+        0xD27A0244680C565CULL, 0x505267D97500261DULL, 0xFB699AA3D236CE78ULL,
+        0xA2966BD58986146CULL, 0xBA24EFE6962151A1ULL, 0x66AAEA018EF37D0DULL,
+        0x112D534AEBC58B37ULL,
+    },
+    {
+        0x0000000000000000ULL, 0xE46F7E8BE0B7C041ULL, 0x551F78208C495BC9ULL,
+        0x0DF0E2E25BD3E603ULL, 0xA95864DDB238050EULL, 0x597CAAC45E88C067ULL,
+        0xABF840CE01A46441ULL, 0x640D52F528B8C251ULL, 0x10F0961AE98BEA23ULL,
+        0xD5B66A575AFA7F33ULL, 0x5617FC88FE22F0E9ULL, 0x55F1CE787DFC81BDULL,
+        0x9AB0AD5E374C7E8DULL, 0xE6FD6E616CD298C7ULL, 0xF5780B5A5D484FFDULL,
+        0xA2DCB8F4498E3251ULL, 0x7381832A22D990B7ULL, 0xA58F17D4D2FAE9D1ULL,
+        0xF63A2F4E1FEEE34BULL, 0x165627909FD304D9ULL, 0xEEBB5D32EEB45736ULL,
+        0xB86FBBE2A6FCC2BAULL, 0xC01EB30E74E1418AULL, 0x06ADED547C0FAFE9ULL,
+        0x779DFFC2CE47F30EULL, 0x66188CAD52E9F1B7ULL, 0xCDF923D18BC246BBULL,
+        0x1238CA54EAE39D7AULL, 0xB033A633C7B7F1F2ULL, 0x8AA697FF3840F547ULL,
+        0xCF0D0F3C0487467AULL, 0x4EFFBFAC54D23418ULL, 0x647F03A2C587B2E3ULL,
+        0xFCE4736B5A7CE07BULL, 0x2FA7E253A6BA0D49ULL, 0x175EBADB6C48840EULL,
+        0xC624206B4B4178D4ULL, 0x674EB1476751FB75ULL, 0x3C0396F78ABAA89CULL,
+        0x487318B5898F2054ULL, 0xD17391FD06F2E2DBULL, 0x4B68E727175E58A3ULL,
+        0x7B10A5D825A64451ULL, 0x4503BD915DEB460DULL, 0x0C3C686B9A93FD7BULL,
+        0xF0782C7AE513E352ULL, 0xF16AE73D89B78671ULL, 0xA2F69ED65ED27D6AULL,
+        0x17EE4F776F878386ULL,
+    },
+    {
+        0x0000000000000000ULL, 0xFE20E9082117E7B2ULL, 0x230AA363558D1C5EULL,
+        0x3DB573B5D8982342ULL, 0x5ECCACA792DD9BFDULL, 0xDBA9C426F5622069ULL,
+        0xBEB329B31E6EA9D9ULL, 0xBFB959E2FAC821D1ULL, 0x2BDC820A60AABCF6ULL,
+        0xFC68157D8C62BD19ULL, 0x8A523D35E37BC9F5ULL, 0x258BBA73139F0389ULL,
+        0x377BC912AECF2C4EULL, 0x837253F03FDCD508ULL, 0x54C0F69AA867118BULL,
+        0x838F520FD79ED3AAULL, 0xDA23E4BB10C6B091ULL, 0xC001897EA826E84EULL,
+        0xFDD4ABD8622BD9FFULL, 0x5A099B7B17B7AD49ULL, 0xF7EA36BD81ACD743ULL,
+        0x8DD0B206894E4B67ULL, 0x0B043101B1AFA122ULL, 0x379F3116FDA1ECFAULL,
+        0xF70B834B5AB87324ULL, 0x443E39CCD0AAC785ULL, 0xB4D55EEF2403D652ULL,
+        0xDFAB392AB8562F4DULL, 0x9A624299EB8401C8ULL, 0x7B37BDE74AD181E9ULL,
+        0x8540872803EB13EEULL, 0xD673D4B63779A3AFULL, 0xE1819DF8B8627669ULL,
+        0xB4AACDDB7EDB69E6ULL, 0x67298056FCAE743DULL, 0xC4BA92AEEBCD756AULL,
+        0x8509FD693355DF89ULL, 0xD59FD5F8A04698D5ULL, 0x11EB7DAA65B82988ULL,
+        0x45AAC51C9FC83F3CULL, 0xA695C13C1C19C703ULL, 0x4A4FA581058FD43BULL,
+        0xF5362D6F8C607405ULL, 0x134B5FB5EFDED572ULL, 0x9BDB27FB44C081FFULL,
+        0xFCB08464D10EDA7BULL, 0x12FB52CF04238686ULL, 0x13BA4B12B7BD2963ULL,
+        0x0E266A1EE3E9B027ULL,
+    },
+};
+
+static const uint64_t ZOBRIST_SCORE[2][49] = {
+    {
+        0x0000000000000000ULL, 0xA91CFE44AB9C314CULL, 0xD4F766CFF720FF19ULL,
+        0x35FE10D42147B610ULL, 0x7FA09208D4819408ULL, 0xD9BB44FE7296139FULL,
+        0x6CF75E2BB2947662ULL, 0xB5B8F55F50F082D6ULL, 0xA33D45F5D8B774F7ULL,
+        0xB3898547414F32AFULL, 0xB9EF7EBEBF0D5510ULL, 0x7CC148D29EAE5B99ULL,
+        0x2F3CAFEDB0E61B75ULL, 0x34C9BF5E1A20B95BULL, 0x1C75B35E5749CC91ULL,
+        0xA2733F5AE16DEEF2ULL, 0x0C3C5F98B2F2E690ULL, 0x1F62D1DF76C7D558ULL,
+        0x44F51C56DBE949F2ULL, 0x9E148252BA2B1B4DULL, 0x397FF71244CAED09ULL,
+        0x508E8560E6B54BA7ULL, 0xF127786D7DCCC5D0ULL, 0xEDA70AA131A4BF17ULL,
+        0x88DFAD58943FEE10ULL, 0x8B6C0D758F7A12C2ULL, 0x69725AA3A4FDB5C2ULL,
+        0x747A7104D2CAFC01ULL, 0xA4E3DDB31E934BBBULL, 0x8625E1BC96FBC80BULL,
+        0xD42BC3273836926BULL, 0xA0AB3478DC07DA79ULL, 0xA1C055DD67FD4EDFULL,
+        0x4FAA2F3B61389CCEULL, 0xC52D29A85E43F369ULL, 0xF44CE9C56E41CB93ULL,
+        0x548A2246AA7F8740ULL, 0x28F342ACD3C49390ULL, 0x30F62801F0A69793ULL,
+        0x1BEA198A1DEB703CULL, 0xB1F010233CD155FBULL, 0xF7B7EAF9502108A0ULL,
+        0x1F1C8D3CEDE71D4EULL, 0xC345F62D6EB9A1D0ULL, 0xFBFE333EC8E0FE05ULL,
+        0x8201DF3F061669F3ULL, 0x884B4DC4A4CAF835ULL, 0xB1F1134931DEC588ULL,
+        0xE82C252AB9B68C3CULL,
+    },
+    {
+        0x0000000000000000ULL, 0xFC2E1E8089051EB0ULL, 0xB91070E2237A90CEULL,
+        0xC8DE5581B0BBC5CCULL, 0x0C9DC812836A1B0DULL, 0x51056370748D01BAULL,
+        0xD3746A898C485878ULL, 0xCD3B8618DCEB0DBEULL, 0x1168B9C57B183BC8ULL,
+        0x64B7E0B130042AA8ULL, 0xB8F3B41CB1591B4DULL, 0x61449E16B4FFC17BULL,
+        0x355CE81141A22731ULL, 0xF376BE57FA23F042ULL, 0x67FC0959727CC13FULL,
+        0x97A5430C7E2C4187ULL, 0x1F840CD044DCAC50ULL, 0x1478DE7261CD660BULL,
+        0x7DAD80ACBDA83065ULL, 0xBA5F9F67894A8AA1ULL, 0x87284B0F79D9327AULL,
+        0xFA8F9B29234E4EC9ULL, 0xD35AF83D79C7700EULL, 0xB5B63BE456279685ULL,
+        0x4707FC2F6F210B45ULL, 0x89E6ABEE73EA923BULL, 0xC776E9C24421E429ULL,
+        0x32EC08900C0FC458ULL, 0x9079136737FABDAAULL, 0xA9BC41F233B74E16ULL,
+        0x9309CFC084839351ULL, 0xBAFFCB20374C20F7ULL, 0xA56DE8C5638DDE45ULL,
+        0x628AA14CC3AE7D3BULL, 0x4EF6A6728DB0B375ULL, 0x1A8EF5CF47C0B6D4ULL,
+        0x215D3862360AF36CULL, 0x37C6664F97E728D2ULL, 0xEC2E3A2305BB7270ULL,
+        0x7AB6AA9BA40768C8ULL, 0x256F7CA05A562FB5ULL, 0x67EE9A9718BF7F48ULL,
+        0x2EE7E9DB70D32200ULL, 0x8561A39BA5082A1DULL, 0xFBA5628B42CC7D52ULL,
+        0xF8C9C22A524ED233ULL, 0x6886F67A0829EAC5ULL, 0xAFA3801E2A3A22B6ULL,
+        0x57185ED6E0005944ULL,
+    },
+};
+
+static const uint64_t ZOBRIST_SIDE = 0x7A5A39E1C4EAE8ACULL;
+
+#endif /* GAME_ZOBRIST_TABLES_H */
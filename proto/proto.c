@@ -0,0 +1,363 @@
+/*************************************************************************
+                           Awale -- Protocol (Frames)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Encodage et découpage des trames binaires,
+                           lignes de texte des plateaux (complets et
+                           différentiels), partagés par le serveur, le
+                           client et les bots
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proto.h"
+
+/* =====================================================
+ *                     Encodage
+ * ===================================================== */
+size_t proto_header(uint8_t *dst, int op, size_t len)
+{
+    dst[0] = (uint8_t)(len >> 8);
+    dst[1] = (uint8_t)len;
+    dst[2] = (uint8_t)op;
+    return PROTO_HEADER;
+}
+
+size_t proto_text(uint8_t *dst, const char *line, size_t len)
+{
+    if (len > PROTO_MAX_LEN)
+        len = PROTO_MAX_LEN;
+
+    proto_header(dst, PROTO_OP_TEXT, len);
+    memcpy(dst + PROTO_HEADER, line, len);
+    return PROTO_HEADER + len;
+}
+
+/* Pendules des 2 joueurs, 4 octets chacune (ordre réseau) */
+static void put_clocks(uint8_t *p, const uint32_t clocks[2])
+{
+    for (int k = 0; k < 2; k++) {
+        p[4 * k]     = (uint8_t)(clocks[k] >> 24);
+        p[4 * k + 1] = (uint8_t)(clocks[k] >> 16);
+        p[4 * k + 2] = (uint8_t)(clocks[k] >> 8);
+        p[4 * k + 3] = (uint8_t)clocks[k];
+    }
+}
+
+static void get_clocks(const uint8_t *p, uint32_t clocks[2])
+{
+    for (int k = 0; k < 2; k++)
+        clocks[k] = ((uint32_t)p[4 * k] << 24) | ((uint32_t)p[4 * k + 1] << 16) |
+                    ((uint32_t)p[4 * k + 2] << 8) | p[4 * k + 3];
+}
+
+size_t proto_board(uint8_t *dst, const int pits[12], int s0, int s1, int next,
+                   unsigned seq, const uint32_t *clocks)
+{
+    size_t   len = PROTO_BOARD_LEN + (clocks ? PROTO_CLOCKS_LEN : 0);
+    uint8_t *p   = dst + proto_header(dst, PROTO_OP_BOARD, len);
+
+    for (int k = 0; k < 12; k++)
+        p[k] = (uint8_t)pits[k];
+    p[12] = (uint8_t)s0;
+    p[13] = (uint8_t)s1;
+    p[14] = (uint8_t)next;
+    p[15] = (uint8_t)(seq >> 8);
+    p[16] = (uint8_t)seq;
+
+    if (clocks)
+        put_clocks(p + PROTO_BOARD_LEN, clocks);
+    return PROTO_HEADER + len;
+}
+
+size_t proto_board_delta(uint8_t *dst, unsigned seq, int next, unsigned mask,
+                         const int pits[12], int s0, int s1,
+                         const uint32_t *clocks)
+{
+    uint8_t *p = dst + PROTO_HEADER;
+    size_t   n = PROTO_DELTA_MIN_LEN;
+
+    p[0] = (uint8_t)(seq >> 8);
+    p[1] = (uint8_t)seq;
+    p[2] = (uint8_t)next;
+    p[3] = (uint8_t)(mask >> 8);
+    p[4] = (uint8_t)mask;
+
+    for (int k = 0; k < 12; k++)
+        if (mask & (1u << k))
+            p[n++] = (uint8_t)pits[k];
+
+    if (mask & PROTO_DELTA_SCORES) {
+        p[n++] = (uint8_t)s0;
+        p[n++] = (uint8_t)s1;
+    }
+
+    if (mask & PROTO_DELTA_CLOCKS) {
+        put_clocks(p + n, clocks);
+        n += PROTO_CLOCKS_LEN;
+    }
+
+    proto_header(dst, PROTO_OP_BOARD_DELTA, n);
+    return PROTO_HEADER + n;
+}
+
+unsigned proto_delta_mask(const int old_pits[12], const int old_scores[2],
+                          const int pits[12], const int scores[2])
+{
+    unsigned mask = 0;
+
+    for (int k = 0; k < 12; k++)
+        if (pits[k] != old_pits[k])
+            mask |= 1u << k;
+
+    if (scores[0] != old_scores[0] || scores[1] != old_scores[1])
+        mask |= PROTO_DELTA_SCORES;
+    return mask;
+}
+
+size_t proto_move(uint8_t *dst, int pit)
+{
+    dst[proto_header(dst, PROTO_OP_MOVE, PROTO_MOVE_LEN)] = (uint8_t)pit;
+    return PROTO_MOVE_FRAME;
+}
+
+/* Pseudo sur 16 octets, complété par des '\0' */
+static void put_name(uint8_t *dst, const char *name)
+{
+    size_t len = strnlen(name, 15);
+    memcpy(dst, name, len);
+    memset(dst + len, 0, 16 - len);
+}
+
+size_t proto_game_start(uint8_t *dst, const char *p0, const char *p1)
+{
+    uint8_t *p = dst + proto_header(dst, PROTO_OP_GAME_START, PROTO_GAME_START_LEN);
+
+    put_name(p, p0);
+    put_name(p + 16, p1);
+    return PROTO_GAME_START_FRAME;
+}
+
+size_t proto_game_end(uint8_t *dst, int s0, int s1, int flag)
+{
+    size_t   len = (flag >= 0) ? PROTO_GAME_FLAG_LEN : PROTO_GAME_END_LEN;
+    uint8_t *p   = dst + proto_header(dst, PROTO_OP_GAME_END, len);
+
+    p[0] = (uint8_t)s0;
+    p[1] = (uint8_t)s1;
+    if (flag >= 0)
+        p[2] = (uint8_t)(1 + flag);
+    return PROTO_HEADER + len;
+}
+
+/* =====================================================
+ *                     Décodage
+ * ===================================================== */
+long proto_next(const uint8_t *buf, size_t len, ProtoFrame *out)
+{
+    if (len < PROTO_HEADER)
+        return 0;
+
+    size_t body = ((size_t)buf[0] << 8) | buf[1];
+    if (body > PROTO_MAX_LEN)
+        return -1;
+    if (len < PROTO_HEADER + body)
+        return 0;
+
+    out->op   = buf[2];
+    out->data = buf + PROTO_HEADER;
+    out->len  = body;
+    return (long)(PROTO_HEADER + body);
+}
+
+int proto_decode(const ProtoFrame *f, ProtoMsg *msg)
+{
+    const uint8_t *p = f->data;
+
+    msg->op = f->op;
+
+    switch (f->op) {
+        case PROTO_OP_BOARD:
+            if (f->len != PROTO_BOARD_LEN &&
+                f->len != PROTO_BOARD_LEN + PROTO_CLOCKS_LEN)
+                return -1;
+            for (int k = 0; k < 12; k++) {
+                if (p[k] > 48)
+                    return -1;
+                msg->pits[k] = p[k];
+            }
+            if (p[12] > 48 || p[13] > 48 || p[14] > 1)
+                return -1;
+            msg->scores[0] = p[12];
+            msg->scores[1] = p[13];
+            msg->next      = p[14];
+            msg->seq       = ((unsigned)p[15] << 8) | p[16];
+            msg->timed     = (f->len > PROTO_BOARD_LEN);
+            if (msg->timed)
+                get_clocks(p + PROTO_BOARD_LEN, msg->clocks);
+            return 0;
+
+        case PROTO_OP_BOARD_DELTA: {
+            if (f->len < PROTO_DELTA_MIN_LEN || p[2] > 1)
+                return -1;
+
+            unsigned mask = ((unsigned)p[3] << 8) | p[4];
+            size_t   n    = PROTO_DELTA_MIN_LEN;
+
+            if (mask & ~(PROTO_DELTA_SCORES | PROTO_DELTA_CLOCKS | 0xfffu))
+                return -1;
+
+            msg->seq  = ((unsigned)p[0] << 8) | p[1];
+            msg->next = p[2];
+            msg->mask = mask;
+
+            for (int k = 0; k < 12; k++) {
+                if (!(mask & (1u << k)))
+                    continue;
+                if (n >= f->len || p[n] > 48)
+                    return -1;
+                msg->pits[k] = p[n++];
+            }
+
+            if (mask & PROTO_DELTA_SCORES) {
+                if (n + 2 > f->len || p[n] > 48 || p[n + 1] > 48)
+                    return -1;
+                msg->scores[0] = p[n];
+                msg->scores[1] = p[n + 1];
+                n += 2;
+            }
+
+            if (mask & PROTO_DELTA_CLOCKS) {
+                if (n + PROTO_CLOCKS_LEN > f->len)
+                    return -1;
+                get_clocks(p + n, msg->clocks);
+                n += PROTO_CLOCKS_LEN;
+            }
+            return (n == f->len) ? 0 : -1;
+        }
+
+        case PROTO_OP_MOVE:
+            if (f->len != PROTO_MOVE_LEN || p[0] > 11)
+                return -1;
+            msg->pit = p[0];
+            return 0;
+
+        case PROTO_OP_GAME_START:
+            if (f->len != PROTO_GAME_START_LEN)
+                return -1;
+            for (int k = 0; k < 2; k++) {
+                memcpy(msg->names[k], p + 16 * k, 15);
+                msg->names[k][15] = '\0';
+            }
+            return 0;
+
+        case PROTO_OP_GAME_END:
+            if ((f->len != PROTO_GAME_END_LEN && f->len != PROTO_GAME_FLAG_LEN) ||
+                p[0] > 48 || p[1] > 48)
+                return -1;
+            if (f->len == PROTO_GAME_FLAG_LEN && (p[2] < 1 || p[2] > 2))
+                return -1;
+            msg->scores[0] = p[0];
+            msg->scores[1] = p[1];
+            msg->flag      = (f->len == PROTO_GAME_FLAG_LEN) ? p[2] - 1 : -1;
+            return 0;
+    }
+    return -1;
+}
+
+/* =====================================================
+ *                 Plateaux en texte
+ * ===================================================== */
+size_t proto_board_line(char *dst, const int pits[12], int s0, int s1,
+                        int next, unsigned seq, const uint32_t *clocks)
+{
+    int n = snprintf(dst, PROTO_BOARD_LINE,
+                     "BOARD %d %d %d %d %d %d %d %d %d %d %d %d | Scores: %d-%d "
+                     "| Next: %d | Seq: %u",
+                     pits[0], pits[1], pits[2], pits[3], pits[4], pits[5],
+                     pits[6], pits[7], pits[8], pits[9], pits[10], pits[11],
+                     s0, s1, next, seq & PROTO_SEQ_MASK);
+
+    if (clocks)
+        n += snprintf(dst + n, PROTO_BOARD_LINE - (size_t)n, " | Clock: %u %u",
+                      (unsigned)clocks[0], (unsigned)clocks[1]);
+
+    dst[n++] = '\n';
+    dst[n]   = '\0';
+    return (size_t)n;
+}
+
+size_t proto_delta_line(char *dst, unsigned seq, int next, unsigned mask,
+                        const int pits[12], int s0, int s1,
+                        const uint32_t *clocks)
+{
+    /* Au pire 12 « cc:gg », les scores et les pendules : en deçà de PROTO_BOARD_LINE */
+    int n = snprintf(dst, PROTO_BOARD_LINE, "BOARD_DELTA %u %d",
+                     seq & PROTO_SEQ_MASK, next);
+
+    for (int k = 0; k < 12; k++)
+        if (mask & (1u << k))
+            n += snprintf(dst + n, PROTO_BOARD_LINE - (size_t)n, " %d:%d", k, pits[k]);
+
+    if (mask & PROTO_DELTA_SCORES)
+        n += snprintf(dst + n, PROTO_BOARD_LINE - (size_t)n, " S:%d-%d", s0, s1);
+
+    if (mask & PROTO_DELTA_CLOCKS)
+        n += snprintf(dst + n, PROTO_BOARD_LINE - (size_t)n, " C:%u-%u",
+                      (unsigned)clocks[0], (unsigned)clocks[1]);
+
+    dst[n++] = '\n';
+    dst[n]   = '\0';
+    return (size_t)n;
+}
+
+int proto_parse_delta(const char *line, ProtoMsg *msg)
+{
+    char *end;
+
+    if (strncmp(line, "BOARD_DELTA ", 12) != 0)
+        return -1;
+
+    unsigned long seq = strtoul(line + 12, &end, 10);
+    if (end == line + 12 || seq > PROTO_SEQ_MASK || end[0] != ' ' ||
+        (end[1] != '0' && end[1] != '1'))
+        return -1;
+
+    msg->op   = PROTO_OP_BOARD_DELTA;
+    msg->seq  = (unsigned)seq;
+    msg->next = end[1] - '0';
+    msg->mask = 0;
+
+    const char *p = end + 2;
+    while (*p == ' ') {
+        int      a, b, used;
+        unsigned c0, c1;
+
+        if (sscanf(p, " C:%u-%u%n", &c0, &c1, &used) == 2) {
+            msg->clocks[0] = c0;
+            msg->clocks[1] = c1;
+            msg->mask     |= PROTO_DELTA_CLOCKS;
+        } else if (sscanf(p, " S:%d-%d%n", &a, &b, &used) == 2) {
+            if (a < 0 || a > 48 || b < 0 || b > 48)
+                return -1;
+            msg->scores[0] = a;
+            msg->scores[1] = b;
+            msg->mask     |= PROTO_DELTA_SCORES;
+        } else if (sscanf(p, " %d:%d%n", &a, &b, &used) == 2) {
+            if (a < 0 || a > 11 || b < 0 || b > 48)
+                return -1;
+            msg->pits[a] = b;
+            msg->mask   |= 1u << a;
+        } else {
+            return -1;
+        }
+        p += used;
+    }
+    return (*p == '\0') ? 0 : -1;
+}
@@ -0,0 +1,257 @@
+/*************************************************************************
+                           Awale -- Protocol
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Protocole binaire compact, négocié par HELLO :
+                           - trames préfixées par leur longueur, opcode
+                             sur un octet
+                           - plateau, coup, début et fin de partie à
+                             disposition fixe ; tout le reste en TEXT
+                           - connexion côté client (client, bots)
+*************************************************************************/
+
+#ifndef PROTO_H
+#define PROTO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* ================================================================
+ *  Négociation
+ * ================================================================ */
+
+/*
+ * Le protocole texte reste celui par défaut. Un client qui veut les
+ * trames envoie « HELLO BIN1 » comme toute première ligne ; le serveur
+ * répond « HELLO BIN1 » (accepté) ou « HELLO TEXT » par une ligne de
+ * texte, puis n'envoie plus que des trames. Le client attend cette
+ * réponse avant d'envoyer autre chose ; il parle ensuite en trames lui
+ * aussi.
+ *
+ * « DELTA1 », seul ou avec BIN1, demande les plateaux différentiels
+ * (BOARD_DELTA) ; la réponse le répète s'il est accepté
+ * (« HELLO TEXT DELTA1 », « HELLO BIN1 DELTA1 »).
+ */
+#define PROTO_HELLO      "HELLO"
+#define PROTO_CAP_BIN    "BIN1"
+#define PROTO_CAP_DELTA  "DELTA1"
+
+#define PROTO_TEXT       0
+#define PROTO_BIN        1
+
+/* Capacités demandées par proto_conn_init */
+#define PROTO_WANT_BIN    (1 << 0)
+#define PROTO_WANT_DELTA  (1 << 1)
+
+/* ================================================================
+ *  Trames
+ * ================================================================ */
+
+/*
+ * Trame : longueur de la charge (2 octets, ordre réseau), opcode
+ * (1 octet), charge. Une ligne du protocole texte voyage en TEXT, sans
+ * son '\n'.
+ */
+#define PROTO_HEADER     3
+#define PROTO_MAX_LEN    1024     /* charge la plus longue acceptée */
+
+enum {
+    PROTO_OP_TEXT       = 1,      /* ligne de texte */
+    PROTO_OP_BOARD      = 2,      /* 12 cases, 2 scores, joueur suivant */
+    PROTO_OP_MOVE       = 3,      /* case jouée */
+    PROTO_OP_GAME_START = 4,      /* pseudos des 2 joueurs (16 octets chacun) */
+    PROTO_OP_GAME_END   = 5,      /* 2 scores [, joueur tombé au temps] */
+    PROTO_OP_BOARD_DELTA = 6      /* cases et scores changés depuis le plateau précédent */
+};
+
+/*
+ * Chaque plateau d'une partie porte un numéro (seq, sur 16 bits) ;
+ * BOARD_DELTA ne donne que ce qui a changé depuis le plateau seq - 1.
+ * Un client qui n'a pas ce plateau (arrivée, plateau sauté) demande
+ * l'état complet par la commande PROTO_RESYNC.
+ *
+ * BOARD       : 12 cases, 2 scores, joueur suivant, seq
+ * BOARD_DELTA : seq, joueur suivant, masque (bits 0 à 11 : cases,
+ *               PROTO_DELTA_SCORES : scores, PROTO_DELTA_CLOCKS :
+ *               pendules), puis les cases du masque dans l'ordre, les
+ *               2 scores et les 2 pendules s'ils sont présents
+ *
+ * Une partie à la pendule ajoute à chaque plateau le temps restant des
+ * deux joueurs (ms, 4 octets chacun) : après seq pour BOARD, toujours
+ * présent (PROTO_DELTA_CLOCKS) pour BOARD_DELTA. GAME_END porte alors
+ * un troisième octet, 1 + joueur tombé au temps, si la partie s'est
+ * finie ainsi.
+ */
+#define PROTO_RESYNC          "BOARD"
+#define PROTO_SEQ_MASK        0xffffu
+#define PROTO_DELTA_SCORES    (1u << 12)
+#define PROTO_DELTA_CLOCKS    (1u << 13)
+
+#define PROTO_BOARD_LEN       17
+#define PROTO_CLOCKS_LEN      8
+#define PROTO_MOVE_LEN        1
+#define PROTO_GAME_START_LEN  32
+#define PROTO_GAME_END_LEN    2
+#define PROTO_GAME_FLAG_LEN   3
+#define PROTO_DELTA_MIN_LEN   5
+#define PROTO_DELTA_MAX_LEN   (PROTO_DELTA_MIN_LEN + 12 + 2 + PROTO_CLOCKS_LEN)
+
+/* Taille d'une trame de chaque type (en-tête compris) */
+#define PROTO_BOARD_FRAME       (PROTO_HEADER + PROTO_BOARD_LEN)
+#define PROTO_MOVE_FRAME        (PROTO_HEADER + PROTO_MOVE_LEN)
+#define PROTO_GAME_START_FRAME  (PROTO_HEADER + PROTO_GAME_START_LEN)
+#define PROTO_GAME_END_FRAME    (PROTO_HEADER + PROTO_GAME_END_LEN)
+#define PROTO_GAME_END_MAX_FRAME (PROTO_HEADER + PROTO_GAME_FLAG_LEN)
+#define PROTO_DELTA_MAX_FRAME   (PROTO_HEADER + PROTO_DELTA_MAX_LEN)
+
+/* Ligne de texte d'un plateau, complet ou différentiel ('\n' compris) */
+#define PROTO_BOARD_LINE      160
+
+/*
+ * Trame reçue (pointe dans le tampon de réception) :
+ *  op   : PROTO_OP_*
+ *  data : charge
+ *  len  : taille de la charge
+ */
+typedef struct {
+    int            op;
+    const uint8_t *data;
+    size_t         len;
+} ProtoFrame;
+
+/*
+ * Message décodé :
+ *  text   : TEXT, ligne terminée par '\0'
+ *  pits, scores, next, seq : BOARD et BOARD_DELTA ; scores seuls pour
+ *           GAME_END
+ *  mask   : BOARD_DELTA, cases (et scores, pendules) renseignées
+ *  timed  : BOARD, pendules renseignées
+ *  clocks : temps restant des 2 joueurs (ms)
+ *  flag   : GAME_END, joueur tombé au temps, -1 sinon
+ *  pit    : MOVE
+ *  names  : GAME_START
+ */
+typedef struct {
+    int         op;
+    const char *text;
+    int         pits[12];
+    int         scores[2];
+    int         next;
+    unsigned    seq;
+    unsigned    mask;
+    int         timed;
+    uint32_t    clocks[2];
+    int         flag;
+    int         pit;
+    char        names[2][16];
+} ProtoMsg;
+
+/* ---- Encodage : taille écrite dans dst ---- */
+
+/* En-tête seul, la charge étant déjà en place après lui */
+size_t proto_header(uint8_t *dst, int op, size_t len);
+
+/*
+ * dst doit pouvoir recevoir PROTO_HEADER + len octets. clocks : temps
+ * restant (ms) d'une partie à la pendule, NULL sinon ; flag : joueur
+ * tombé au temps, -1 sinon.
+ */
+size_t proto_text(uint8_t *dst, const char *line, size_t len);
+size_t proto_board(uint8_t *dst, const int pits[12], int s0, int s1, int next,
+                   unsigned seq, const uint32_t *clocks);
+size_t proto_move(uint8_t *dst, int pit);
+size_t proto_game_start(uint8_t *dst, const char *p0, const char *p1);
+size_t proto_game_end(uint8_t *dst, int s0, int s1, int flag);
+
+/*
+ * Cases de pits (scores, pendules) désignées par mask ; au plus
+ * PROTO_DELTA_MAX_FRAME
+ */
+size_t proto_board_delta(uint8_t *dst, unsigned seq, int next, unsigned mask,
+                         const int pits[12], int s0, int s1,
+                         const uint32_t *clocks);
+
+/* Cases et scores qui diffèrent entre deux plateaux (masque BOARD_DELTA) */
+unsigned proto_delta_mask(const int old_pits[12], const int old_scores[2],
+                          const int pits[12], const int scores[2]);
+
+/*
+ * Découpe la prochaine trame de buf : taille consommée, 0 s'il manque
+ * des octets, -1 si la trame dépasse PROTO_MAX_LEN.
+ */
+long proto_next(const uint8_t *buf, size_t len, ProtoFrame *out);
+
+/*
+ * Décode une trame à disposition fixe (pas TEXT) dans msg ; -1 si la
+ * taille ou une valeur est invalide.
+ */
+int  proto_decode(const ProtoFrame *f, ProtoMsg *msg);
+
+/* ---- Plateaux en texte ----
+ *  « BOARD p0 … p11 | Scores: s0-s1 | Next: n | Seq: seq [| Clock: c0 c1] »
+ *  « BOARD_DELTA seq n case:graines … [S:s0-s1] [C:c0-c1] »
+ * Les lignes font au plus PROTO_BOARD_LINE octets ; taille écrite.
+ */
+size_t proto_board_line(char *dst, const int pits[12], int s0, int s1,
+                        int next, unsigned seq, const uint32_t *clocks);
+size_t proto_delta_line(char *dst, unsigned seq, int next, unsigned mask,
+                        const int pits[12], int s0, int s1,
+                        const uint32_t *clocks);
+
+/* Relit une ligne BOARD_DELTA (sans '\n') dans msg ; -1 si invalide */
+int  proto_parse_delta(const char *line, ProtoMsg *msg);
+
+/* ================================================================
+ *  Connexion côté client (client interactif, bots)
+ * ================================================================ */
+
+#define PROTO_CONN_RX    4096
+#define PROTO_CONN_HELD  512
+
+/*
+ * Traite un message reçu (lignes de texte en PROTO_OP_TEXT, trames
+ * décodées sinon). Retourne 0 pour arrêter la lecture.
+ */
+typedef int (*ProtoHandler)(void *ctx, const ProtoMsg *msg);
+
+/*
+ *  fd      : socket connectée au serveur
+ *  mode    : PROTO_TEXT ou PROTO_BIN, une fois la réponse à HELLO reçue
+ *  deltas  : BOARD_DELTA accepté par le serveur
+ *  pending : HELLO envoyé, réponse attendue ; les envois sont retenus
+ *  rx      : octets reçus pas encore découpés
+ *  held    : lignes retenues pendant la négociation
+ */
+typedef struct {
+    int     fd;
+    int     mode;
+    int     deltas;
+    int     pending;
+    uint8_t rx[PROTO_CONN_RX];
+    size_t  rx_len;
+    char    held[PROTO_CONN_HELD];
+    size_t  held_len;
+} ProtoConn;
+
+/*
+ * want : PROTO_WANT_* ; 0 pour le texte seul, sinon HELLO est envoyé
+ * tout de suite avec les capacités demandées.
+ */
+int  proto_conn_init(ProtoConn *pc, int fd, int want);
+
+/*
+ * Envoie une commande (ligne sans '\n') : ligne de texte, trame MOVE
+ * pour « MOVE <case> », trame TEXT sinon.
+ */
+int  proto_conn_send(ProtoConn *pc, const char *line);
+
+/*
+ * Lit la socket une fois et passe chaque message complet à handler.
+ * Retourne -1 si la connexion est fermée ou le flux invalide, 0 si
+ * handler a demandé l'arrêt, 1 sinon.
+ */
+int  proto_conn_read(ProtoConn *pc, ProtoHandler handler, void *ctx);
+
+#endif /* PROTO_H */
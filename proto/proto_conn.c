@@ -0,0 +1,215 @@
+/*************************************************************************
+                           Awale -- Protocol (Client connection)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Connexion vue d'un client ou d'un bot :
+                           négociation HELLO, envoi des commandes en
+                           texte ou en trames, découpage de la réception
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/socket.h>
+
+#include "proto.h"
+
+/* =====================================================
+ *                       Envoi
+ * ===================================================== */
+static int send_all(int fd, const void *buf, size_t len)
+{
+    const char *p = buf;
+
+    while (len > 0) {
+        ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        p   += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/* Encode une commande selon le mode négocié */
+static int send_encoded(ProtoConn *pc, const char *line)
+{
+    size_t len = strlen(line);
+
+    if (pc->mode == PROTO_TEXT) {
+        char buf[PROTO_MAX_LEN + 2];
+        if (len > PROTO_MAX_LEN)
+            len = PROTO_MAX_LEN;
+        memcpy(buf, line, len);
+        buf[len] = '\n';
+        return send_all(pc->fd, buf, len + 1);
+    }
+
+    uint8_t frame[PROTO_HEADER + PROTO_MAX_LEN];
+    int     pit;
+    char    end;
+
+    /* « MOVE <case> » exactement : trame fixe, le reste voyage en TEXT */
+    if (sscanf(line, "MOVE %d%c", &pit, &end) == 1 && pit >= 0 && pit <= 11)
+        return send_all(pc->fd, frame, proto_move(frame, pit));
+
+    return send_all(pc->fd, frame, proto_text(frame, line, len));
+}
+
+int proto_conn_init(ProtoConn *pc, int fd, int want)
+{
+    memset(pc, 0, sizeof(*pc));
+    pc->fd   = fd;
+    pc->mode = PROTO_TEXT;
+
+    if (!want)
+        return 0;
+
+    char hello[64];
+    int  len = snprintf(hello, sizeof(hello), "%s%s%s\n", PROTO_HELLO,
+                        (want & PROTO_WANT_BIN)   ? " " PROTO_CAP_BIN   : "",
+                        (want & PROTO_WANT_DELTA) ? " " PROTO_CAP_DELTA : "");
+
+    pc->pending = 1;
+    return send_all(fd, hello, (size_t)len);
+}
+
+int proto_conn_send(ProtoConn *pc, const char *line)
+{
+    if (!pc->pending)
+        return send_encoded(pc, line);
+
+    /* Négociation en cours : la ligne part avec la réponse */
+    size_t len = strlen(line);
+    if (pc->held_len + len + 1 > sizeof(pc->held))
+        return -1;
+
+    memcpy(pc->held + pc->held_len, line, len + 1);
+    pc->held_len += len + 1;
+    return 0;
+}
+
+/* Réponse à HELLO reçue : les lignes retenues partent dans le bon mode */
+static int conn_negotiated(ProtoConn *pc, const char *reply)
+{
+    pc->pending = 0;
+    pc->mode    = strstr(reply, PROTO_CAP_BIN) ? PROTO_BIN : PROTO_TEXT;
+    pc->deltas  = strstr(reply, PROTO_CAP_DELTA) != NULL;
+
+    for (size_t k = 0; k < pc->held_len; k += strlen(pc->held + k) + 1)
+        if (send_encoded(pc, pc->held + k) < 0)
+            return -1;
+
+    pc->held_len = 0;
+    return 0;
+}
+
+/* =====================================================
+ *                     Réception
+ * ===================================================== */
+
+/*
+ * Ligne de texte : les '\0' et '\r' (restes du protocole texte) sont
+ * retirés, les lignes vides ignorées.
+ */
+static int deliver_text(char *line, size_t len, ProtoHandler handler, void *ctx)
+{
+    size_t w = 0;
+    for (size_t r = 0; r < len; r++)
+        if (line[r] != '\0' && line[r] != '\r')
+            line[w++] = line[r];
+    line[w] = '\0';
+
+    if (w == 0)
+        return 1;
+
+    ProtoMsg msg;
+    msg.op   = PROTO_OP_TEXT;
+    msg.text = line;
+    return handler(ctx, &msg);
+}
+
+/* Une ligne de texte complète en tête de rx ; 0 s'il n'y en a pas */
+static size_t next_line(ProtoConn *pc, ProtoHandler handler, void *ctx, int *rc)
+{
+    uint8_t *nl = memchr(pc->rx, '\n', pc->rx_len);
+    if (!nl)
+        return 0;
+
+    size_t used = (size_t)(nl - pc->rx) + 1;
+    char   line[PROTO_CONN_RX];
+    memcpy(line, pc->rx, used - 1);
+
+    line[used - 1] = '\0';
+    if (pc->pending && strncmp(line, PROTO_HELLO " ", 6) == 0) {
+        *rc = (conn_negotiated(pc, line) < 0) ? -1 : 1;
+        return used;
+    }
+
+    *rc = deliver_text(line, used - 1, handler, ctx);
+    return used;
+}
+
+/* Une trame complète en tête de rx ; 0 s'il n'y en a pas */
+static size_t next_frame(ProtoConn *pc, ProtoHandler handler, void *ctx, int *rc)
+{
+    ProtoFrame f;
+    long used = proto_next(pc->rx, pc->rx_len, &f);
+
+    if (used <= 0) {
+        if (used < 0)
+            *rc = -1;
+        return 0;
+    }
+
+    if (f.op == PROTO_OP_TEXT) {
+        char line[PROTO_MAX_LEN + 1];
+        memcpy(line, f.data, f.len);
+        *rc = deliver_text(line, f.len, handler, ctx);
+        return (size_t)used;
+    }
+
+    /* Opcode inconnu ou trame invalide : ignorée */
+    ProtoMsg msg;
+    *rc = (proto_decode(&f, &msg) == 0) ? handler(ctx, &msg) : 1;
+    return (size_t)used;
+}
+
+int proto_conn_read(ProtoConn *pc, ProtoHandler handler, void *ctx)
+{
+    ssize_t n;
+    do {
+        n = recv(pc->fd, pc->rx + pc->rx_len, sizeof(pc->rx) - pc->rx_len, 0);
+    } while (n < 0 && errno == EINTR);
+
+    if (n <= 0)
+        return -1;
+    pc->rx_len += (size_t)n;
+
+    int    rc = 1;
+    size_t off;
+    for (;;) {
+        off = (pc->mode == PROTO_BIN) ? next_frame(pc, handler, ctx, &rc)
+                                      : next_line(pc, handler, ctx, &rc);
+        if (off) {
+            pc->rx_len -= off;
+            memmove(pc->rx, pc->rx + off, pc->rx_len);
+        }
+        if (!off || rc <= 0)
+            break;
+    }
+
+    /* Ligne démesurée en mode texte : abandonnée */
+    if (rc > 0 && pc->mode == PROTO_TEXT && pc->rx_len == sizeof(pc->rx))
+        pc->rx_len = 0;
+
+    return rc;
+}
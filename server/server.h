@@ -14,19 +14,178 @@
 #ifndef SERVER_H
 #define SERVER_H
 
-#include <sys/select.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sys/types.h>
+#include <sys/uio.h>
 #include "../game/game.h"
+#include "../proto/proto.h"
 
 /* ================================================================
  *  Constantes globales
  * ================================================================ */
 
-#define MAX_CLIENTS   20
-#define MAX_GAMES     (MAX_CLIENTS / 2)
-#define MAX_ACCOUNTS  256
 #define BUF_SIZE      512
 #define DEFAULT_PORT  4444
 
+/*
+ * Entrée de chaque client : tampon circulaire (puissance de 2), lignes
+ * d'au plus INPUT_MAX_LINE octets, et au plus INPUT_LINE_BUDGET
+ * commandes traitées par tour de boucle ; le reste passe au tour
+ * suivant, après les autres clients. Au plus INPUT_LINE_BUDGET lignes
+ * sont aussi en route vers le hub ou un exécuteur : leurs réponses
+ * restent ainsi bornées.
+ */
+#define INPUT_RING_SIZE    1024
+#define INPUT_MAX_LINE     (BUF_SIZE - 1)
+#define INPUT_LINE_BUDGET  32
+
+/*
+ * Sortie de chaque client : file bornée vidée quand la socket est
+ * inscriptible. Au-delà de la moitié du plafond, les commandes du
+ * client attendent et les plateaux envoyés aux observateurs sont
+ * sautés ; au-delà du plafond, le client est déconnecté.
+ */
+#define DEFAULT_OUTPUT_MAX  (256 * 1024)
+#define OUTPUT_IOV          64    /* segments par écriture (writev, io_uring) */
+
+/*
+ * Tampon de sortie compté par références. Un message pour plusieurs
+ * clients (plateau, fin de partie, diffusion) est écrit une fois, puis
+ * chaque file n'en garde qu'un pointeur ; le dernier qui le rend le
+ * libère. Partagé, il n'est plus modifié (cap == len).
+ *  refs : files et threads qui le tiennent
+ *  len  : octets écrits dans data
+ *  cap  : place de data (un morceau privé de file se remplit jusque-là)
+ */
+typedef struct {
+    _Atomic unsigned refs;
+    unsigned         len;
+    unsigned         cap;
+    char             data[];
+} OutBuf;
+
+/* Tranche d'un OutBuf en file : octets data[off, off + len) */
+typedef struct {
+    OutBuf  *buf;
+    unsigned off;
+    unsigned len;
+} OutSeg;
+
+/*
+ * Tables des clients, parties et comptes : taille initiale et plafond,
+ * modifiables par fichier de configuration (-c) ou ligne de commande.
+ * Les tables grandissent à la demande jusqu'au plafond.
+ */
+#define DEFAULT_CLIENTS       64
+#define DEFAULT_MAX_CLIENTS   65536
+#define DEFAULT_GAMES         32
+#define DEFAULT_MAX_GAMES     (DEFAULT_MAX_CLIENTS / 2)
+#define DEFAULT_ACCOUNTS      256
+#define DEFAULT_MAX_ACCOUNTS  (1 << 20)
+#define TABLE_LIMIT           (1 << 24)   /* plafond accepté pour une table */
+
+/*
+ * Délais par défaut, en secondes (0 = jamais) : pseudo et mot de passe
+ * après la connexion, inactivité d'un client connecté hors partie,
+ * READY des deux joueurs, coup attendu dans une partie. TIMEOUT_MAX
+ * borne les valeurs configurées (portée de la roue de minuteurs).
+ */
+#define DEFAULT_LOGIN_TIMEOUT  60
+#define DEFAULT_IDLE_TIMEOUT   1800
+#define DEFAULT_READY_TIMEOUT  120
+#define DEFAULT_GAME_TIMEOUT   600
+#define TIMEOUT_MAX            (7 * 24 * 3600)
+
+/* Résolution des minuteurs (ms) */
+#define TIMER_TICK_MS  10
+
+/*
+ * Débit des commandes de chaque connexion, par classe (chat, lobby,
+ * partie) : seau à jetons de rate_* commandes par seconde (0 = sans
+ * limite), qui en garde au plus RATE_BURST secondes d'avance. Un
+ * réacteur qui a lu plus de RATE_TURN_LOAD lignes dans le tour, ou un
+ * hub qui en a exécuté autant au tour précédent, est en surcharge : le
+ * chat et le lobby sont refusés, les coups passent toujours.
+ */
+#define DEFAULT_RATE_CHAT   5
+#define DEFAULT_RATE_LOBBY  10
+#define DEFAULT_RATE_GAME   50
+#define RATE_MAX            100000
+#define RATE_BURST          2
+#define RATE_TURN_LOAD      1024
+
+/* Classes de débit des commandes ; RATE_NONE n'est jamais limitée */
+enum {
+    RATE_CHAT,
+    RATE_LOBBY,
+    RATE_GAME,
+    RATE_CLASSES,
+    RATE_NONE = -1
+};
+
+/* Pendule d'une partie (CHALLENGE <user> base+incrément) */
+#define CLOCK_BASE_MAX  (180 * 60)   /* temps de base, secondes */
+#define CLOCK_INC_MAX   60           /* incrément par coup, secondes */
+
+/* Boucle d'événements (server [port] [epoll|select|uring]) */
+#define LOOP_EPOLL    0
+#define LOOP_SELECT   1
+#define LOOP_URING    2
+
+/*
+ * io_uring, compilé si SERVER_URING vaut 1 (make URING=0 pour s'en
+ * passer) et choisi seulement si le noyau a tout ce qu'il faut (anneau
+ * de tampons fournis, accept et recv multishot) ; epoll sinon.
+ *  URING_ENTRIES : soumissions par anneau
+ *  URING_BUFS    : tampons de réception fournis au noyau, par réacteur
+ *  URING_BUF_SIZE: taille d'un tampon de réception
+ *  URING_HELD_MAX: tampons gardés par un client qui ne lit plus ; au-delà,
+ *                  sa réception est suspendue
+ *  URING_SENDS   : envois soumis ensemble en fin de tour
+ */
+#ifndef SERVER_URING
+#define SERVER_URING  0
+#endif
+
+#define URING_ENTRIES   1024
+#define URING_BUFS      1024
+#define URING_BUF_SIZE  2048
+#define URING_HELD_MAX  4
+#define URING_SENDS     256
+
+/*
+ * Réacteurs : une boucle d'événements par thread (option -t), chacune
+ * avec sa socket d'écoute SO_REUSEPORT. Le réacteur REACTOR_HUB tient
+ * les sessions (comptes, pseudos, attribution des parties) ; les autres
+ * lui transmettent les lignes reçues et écrivent les réponses qu'il
+ * leur renvoie. Chaque partie est en outre confiée à un réacteur, son
+ * exécuteur, qui est seul à la jouer (voir games_executor).
+ */
+#define REACTOR_HUB   0
+#define REACTOR_MAX   64
+
+/* Adversaire virtuel : CHALLENGE bot */
+#define BOT_NAME      "bot"
+#define BOT_TIME_MS   1000      /* budget de réflexion par coup */
+#define BOT_TT_MB     64        /* table de transposition partagée */
+#define BOT_MCTS_MB   64        /* arène de nœuds d'un bot MCTS */
+
+/*
+ * Threads de recherche d'un bot (bot_threads) : le thread du bot, plus
+ * des auxiliaires pris dans une réserve commune à tous les bots, des
+ * cœurs laissés libres par les réacteurs. k parties contre le bot ne
+ * lancent donc jamais k × cœurs threads.
+ */
+#define DEFAULT_BOT_THREADS  2
+#define BOT_THREADS_MAX      64
+#define BOT_TB_PATH   "awale.tb" /* table de finales (make tablebase), facultative */
+
+/* Moteur du bot : CHALLENGE bot [ab|mcts] */
+#define BOT_ENGINE_AB    0      /* alpha-bêta (défaut) */
+#define BOT_ENGINE_MCTS  1      /* Monte-Carlo, arbre réutilisé d'un coup à l'autre */
+
 /* Fichier où sont stockés tous les comptes */
 #define USERS_FILE    "users/accounts.txt"
 
@@ -34,6 +193,59 @@
  *  Structures de données
  * ================================================================ */
 
+/*
+ * Configuration du serveur (valeurs par défaut, puis fichier -c, puis
+ * options de la ligne de commande) :
+ *  port, backend           : écoute et boucle d'événements (LOOP_*)
+ *  threads                 : nombre de réacteurs (1 avec select)
+ *  clients, max_clients    : taille initiale / plafond de g_clients
+ *  games, max_games        : taille initiale / plafond de g_games
+ *  accounts, max_accounts  : taille initiale / plafond de g_accounts
+ *  out_max                 : plafond de la file de sortie d'un client
+ *  login_timeout, idle_timeout, ready_timeout, game_timeout : délais
+ *                            en secondes (0 = jamais)
+ *  rate_chat, rate_lobby, rate_game : commandes par seconde de chaque
+ *                            connexion, par classe (0 = sans limite)
+ *  bot_threads             : threads de recherche au plus par bot
+ */
+typedef struct {
+    int port;
+    int backend;
+    int threads;
+    int clients;
+    int max_clients;
+    int games;
+    int max_games;
+    int accounts;
+    int max_accounts;
+    int out_max;
+    int login_timeout;
+    int idle_timeout;
+    int ready_timeout;
+    int game_timeout;
+    int rate_chat;
+    int rate_lobby;
+    int rate_game;
+    int bot_threads;
+} ServerConfig;
+
+/*
+ * Minuteur d'une roue (une par réacteur, server_timers.c). Il n'est
+ * armé, annulé et déclenché que par le thread de sa roue ; un minuteur
+ * à zéro est désarmé.
+ *  next, pprev : chaînage dans une case de la roue (pprev NULL : désarmé)
+ *  expires     : échéance, en ticks de TIMER_TICK_MS
+ *  slot        : case de la roue
+ *  fn          : appelé à l'échéance, minuteur désarmé (il peut le réarmer)
+ */
+typedef struct Timer {
+    struct Timer  *next;
+    struct Timer **pprev;
+    uint64_t       expires;
+    unsigned       slot;
+    void         (*fn)(struct Timer *t);
+} Timer;
+
 /*
  * Compte utilisateur persistant :
  *  username : pseudo unique (case-insensitive pour login)
@@ -49,85 +261,766 @@ typedef struct {
 } Account;
 
 /*
- * Client connecté au serveur :
+ * Seau à jetons d'une classe de commandes (server_rate.c) :
+ *  tokens : jetons disponibles, en millièmes
+ *  stamp  : dernière mise à jour (ms, timers_now)
+ */
+typedef struct {
+    uint64_t tokens;
+    uint64_t stamp;
+} RateBucket;
+
+/*
+ * Client connecté au serveur. Les champs de session (name à home) ne
+ * sont lus et écrits que par le thread du hub ; les champs de connexion
+ * (à partir de reactor) par le réacteur qui possède la socket.
+ *
  *  fd            : socket TCP
  *  name          : pseudo authentifié
  *  logged_in     : connexion authentifiée
  *  in_game       : joueur actuellement dans une partie
  *  opponent_index: index de l'adversaire (g_clients[])
  *  player_index  : 0 ou 1 (position dans la partie)
- *  ready         : a envoyé READY
  *  login_stage   : 0=username, 1=password, 2=authentifié
  *  private_mode  : parties observables uniquement par amis
+ *  is_bot        : adversaire virtuel (socketpair vers un thread bot)
+ *  game_index    : partie jouée (g_games[]), -1 sinon
+ *  observing     : partie observée (g_games[]), -1 sinon
+ *  attached      : session ouverte au hub (entre ATTACH et DETACH)
+ *  home          : réacteur de la connexion, vu par le hub
+ *  session_timer : délai de connexion puis d'inactivité (roue du hub)
+ *  session_since : ouverture de la session (ms, timers_now)
+ *  session_seen  : dernière ligne exécutée par le hub (ms)
+ *  challenge_to  : dernier joueur défié, vide sinon (hub)
+ *  challenge_base/challenge_inc : pendule proposée avec ce défi (ms),
+ *                  0 sans pendule
+ *  reactor       : réacteur qui possède la socket
+ *  serial        : numéro de la connexion dans le slot, changé quand le
+ *                  slot est rendu (un message pour une connexion close
+ *                  ne touche pas la suivante)
+ *  play_game/play_gen : partie jouée, vue du réacteur (MOVE et READY
+ *                  vont directement à son exécuteur), -1 sinon
+ *  in_flight     : lignes transmises à un autre thread, pas encore traitées
+ *  rate          : seaux à jetons par classe de commandes (RATE_*)
+ *  rate_turn/turn_lines : tour de boucle et lignes lues dans ce tour
+ *  proto         : PROTO_TEXT ou PROTO_BIN (négocié par HELLO) ; écrit par
+ *                  le réacteur, lu par tout thread qui prépare un message
+ *  deltas        : plateaux différentiels acceptés (HELLO … DELTA1), comme proto
+ *  greeted       : première ligne reçue (HELLO n'est plus accepté)
+ *  lost          : connexion perdue, en attente du hub pour rendre le slot
+ *  dead_next     : liste des slots à rendre en fin de tour
+ *  in_ring       : octets reçus pas encore découpés en lignes
+ *  in_head/in_len: début et taille des données dans in_ring
+ *  in_discard    : fin d'une ligne trop longue à ignorer
+ *  deferred      : dans la liste des clients à reprendre (loop_defer)
+ *  out_segs      : segments à envoyer, file circulaire (allouée tant
+ *                  qu'elle est non vide)
+ *  out_seg_head/out_seg_count/out_seg_cap : début, nombre et capacité
+ *                  (puissance de 2) de la file de segments
+ *  out_len       : octets en file, tous segments confondus
+ *  out_listed    : dans la liste des files à vider en fin de tour
+ *  rx_*          : io_uring seulement, tampons reçus pas encore lus
+ *                  (chaîne de rx_head à rx_tail, rx_off octets déjà lus
+ *                  dans le premier, rx_held tampons), recv multishot en
+ *                  cours (rx_armed) ou en cours d'annulation (rx_cancel),
+ *                  fin du flux (rx_eof, erreur rx_err)
+ *  tx_poll       : io_uring seulement, attente de POLLOUT en cours
+ *  out_stalled   : socket pleine, la file attend qu'elle se libère
+ *  in_paused     : commandes suspendues tant que la file est trop pleine
+ *  closing       : client trop lent, retiré en fin de tour
  *  pending_friend_reqs : demandes d'amis en attente (nom,nom,...)
  */
-typedef struct {
+typedef struct Client {
     int  fd;
     char name[16];
     int  logged_in;
     int  in_game;
     int  opponent_index;
     int  player_index;
-    int  ready;
     int  login_stage;
     int  private_mode;
+    int  is_bot;
+    int  game_index;
+    int  observing;
     char pending_friend_reqs[256];
+    int  attached;
+    int  home;
+    Timer    session_timer;
+    uint64_t session_since;
+    uint64_t session_seen;
+    char     challenge_to[16];
+    unsigned challenge_base;
+    unsigned challenge_inc;
+
+    int              reactor;
+    _Atomic uint32_t serial;
+    int              play_game;
+    unsigned         play_gen;
+    unsigned         in_flight;
+    RateBucket       rate[RATE_CLASSES];
+    unsigned         rate_turn;
+    unsigned         turn_lines;
+    _Atomic int      proto;
+    _Atomic int      deltas;
+    int              greeted;
+    int              lost;
+    struct Client   *dead_next;
+
+    char     in_ring[INPUT_RING_SIZE];
+    unsigned in_head;
+    unsigned in_len;
+    int      in_discard;
+
+    int            deferred;
+    struct Client *defer_next;
+
+    OutSeg        *out_segs;
+    unsigned       out_seg_head;
+    unsigned       out_seg_count;
+    unsigned       out_seg_cap;
+    unsigned       out_len;
+    int            out_listed;
+    int            out_stalled;
+    struct Client *out_next;
+    int            rx_head;
+    int            rx_tail;
+    unsigned       rx_off;
+    unsigned       rx_held;
+    int            rx_armed;
+    int            rx_cancel;
+    int            rx_eof;
+    int            rx_err;
+    int            tx_poll;
+    int            in_paused;
+    int            closing;
 } Client;
 
 /*
- * Session de jeu Awalé :
- *  active         : partie en cours
- *  board[12]      : plateau
- *  p0, p1         : joueurs (struct Player du moteur game/)
+ * Désigne une connexion depuis un autre thread : le message n'est
+ * livré que si le slot porte encore le même serial.
+ *  c      : client
+ *  serial : Client.serial au moment où la référence a été prise
+ *  home   : réacteur de la connexion
+ */
+typedef struct {
+    Client  *c;
+    uint32_t serial;
+    int      home;
+} ClientRef;
+
+/*
+ * Session de jeu Awalé. Le hub attribue les slots et ne lit que
+ * l'en-tête (active à players) ; le reste n'appartient qu'à
+ * l'exécuteur de la partie, qui reçoit les coups par sa boîte aux
+ * lettres (games_execute).
+ *  active         : partie en cours, vue du hub
+ *  p0, p1         : joueurs (struct Player du moteur game/, noms seulement)
+ *  gen            : numéro de la partie dans le slot (recyclé)
+ *  players        : clients des deux joueurs (g_clients[])
+ *  run_gen        : partie en cours côté exécuteur
+ *  over           : partie terminée ou annulée côté exécuteur
+ *  board          : plateau compact (graines + scores)
+ *  seq            : numéro du dernier plateau envoyé (0 : aucun)
+ *  sent_pits/sent_scores : dernier plateau envoyé, base de BOARD_DELTA
  *  to_move        : 0 ou 1 → joueur à jouer
+ *  ready          : READY reçu de chaque joueur
+ *  player         : connexions des 2 joueurs
+ *  names          : pseudos des 2 joueurs (copie de l'exécuteur)
  *  filename       : fichier de log
- *  player_fd0/1   : sockets des 2 joueurs
- *  observers[]    : sockets des observateurs
+ *  observers      : connexions des observateurs (tableau extensible,
+ *                   conservé d'une partie à l'autre dans le slot)
  *  observer_count : nb d'observateurs
+ *  observer_cap   : capacité de observers
+ *  timer          : READY attendu, puis coup attendu (roue de l'exécuteur)
+ *  last_move      : début de la partie, des coups (2 READY), dernier coup (ms)
+ *  timed          : partie à la pendule
+ *  clock_left     : temps restant de chaque joueur (ns), au dernier coup
+ *  clock_inc      : incrément ajouté après chaque coup (ns)
+ *  clock_since    : départ de la pendule du joueur au trait (ns)
  */
 typedef struct {
-    int    active;
-    int    board[12];
-    Player p0;
-    Player p1;
-    int    to_move;
-    char   filename[160];
-    int    player_fd0;
-    int    player_fd1;
-    int    observers[MAX_CLIENTS];
-    int    observer_count;
+    int        active;
+    Player     p0;
+    Player     p1;
+    unsigned   gen;
+    int        players[2];
+
+    unsigned    run_gen;
+    int         over;
+    PackedBoard board;
+    unsigned    seq;
+    int         sent_pits[12];
+    int         sent_scores[2];
+    int         to_move;
+    int         ready[2];
+    ClientRef   player[2];
+    char        names[2][16];
+    char        filename[160];
+    ClientRef  *observers;
+    int         observer_count;
+    int         observer_cap;
+    Timer       timer;
+    uint64_t    last_move;
+    int         timed;
+    int64_t     clock_left[2];
+    uint64_t    clock_inc;
+    uint64_t    clock_since;
 } Game;
 
+/*
+ * Événement adressé à une partie, déposé dans la boîte aux lettres de
+ * son exécuteur (sans verrou, plusieurs producteurs) :
+ *  type   : GAME_EV_*
+ *  game   : slot de la partie (g_games[])
+ *  gen    : partie visée ; un événement d'une partie finie est ignoré
+ *  who    : auteur (START : joueur 0)
+ *  other  : START : joueur 1
+ *  arg    : MOVE : case ; START : joueur qui commence ; CANCEL : prévenir
+ *  ack    : ligne routée par le réacteur de who, qui attend l'accusé
+ *  names  : START : pseudos des joueurs ; CANCEL : auteur dans names[0]
+ *  clock_base/clock_inc : START : pendule (ms), 0 sans pendule
+ */
+enum {
+    GAME_EV_START,
+    GAME_EV_READY,
+    GAME_EV_MOVE,
+    GAME_EV_OBSERVE,
+    GAME_EV_UNOBSERVE,
+    GAME_EV_CANCEL,
+    GAME_EV_BOARD
+};
+
+typedef struct GameEvent {
+    struct GameEvent *next;
+    int               type;
+    int               game;
+    unsigned          gen;
+    ClientRef         who;
+    ClientRef         other;
+    int               arg;
+    int               ack;
+    char              names[2][16];
+    unsigned          clock_base;
+    unsigned          clock_inc;
+} GameEvent;
+
+/*
+ * Compteurs des files de sortie, un jeu par réacteur (commande STATS) :
+ *  queued  : octets en attente, tous clients confondus
+ *  peak    : plus longue file observée pour un client
+ *  stalled : clients dont la socket est pleine en ce moment
+ *  paused  : suspensions des commandes d'un client (file trop pleine)
+ *  dropped : plateaux non envoyés à un observateur lent
+ *  kicked  : clients déconnectés pour file pleine
+ *  syscalls: appels système de la boucle (attente, accept, lecture,
+ *            écriture, réveils)
+ *  rejected: commandes refusées, seau à jetons vide
+ *  shed    : commandes de chat ou de lobby refusées en surcharge
+ *  throttled: clients remis au tour suivant, lignes du tour épuisées
+ */
+typedef struct {
+    _Atomic uint64_t queued;
+    _Atomic uint64_t peak;
+    _Atomic uint64_t stalled;
+    _Atomic uint64_t paused;
+    _Atomic uint64_t dropped;
+    _Atomic uint64_t kicked;
+    _Atomic uint64_t syscalls;
+    _Atomic uint64_t rejected;
+    _Atomic uint64_t shed;
+    _Atomic uint64_t throttled;
+} OutputStats;
+
 /* ================================================================
  *  Données globales
  * ================================================================ */
 
-extern Client  g_clients[MAX_CLIENTS];
-extern Game    g_games[MAX_GAMES];
-extern Account g_accounts[MAX_ACCOUNTS];
-extern int     g_account_count;
-
-extern fd_set  g_master_set;
-extern int     g_max_fd;
+/*
+ * Les index valides vont de 0 à g_client_cap - 1 (resp. g_game_cap,
+ * g_account_count). Un slot client libre a fd == -1, une partie libre
+ * active == 0. g_client_cap grandit depuis n'importe quel réacteur ;
+ * g_accounts et l'attribution des slots de g_games n'appartiennent
+ * qu'au hub.
+ */
+extern Client      *g_clients;
+extern _Atomic int  g_client_cap;
+extern Game    *g_games;
+extern int      g_game_cap;
+extern Account *g_accounts;
+extern int      g_account_count;
 
 /* ================================================================
  *  API principale du serveur
  * ================================================================ */
 
-void server_run(int port);
+void server_run(ServerConfig *cfg);
 
-/* Connexion / déconnexion */
+/*
+ * Connexion / déconnexion (côté réacteur) : accept jusqu'à EAGAIN, ou
+ * socket déjà acceptée (accept multishot d'io_uring)
+ */
 void server_handle_new_connection(int server_fd);
-void server_handle_client_message(int fd);
+void server_add_connection(int fd);
+void server_handle_client_message(Client *c);
+
+/*
+ * Côté hub : ouvre la session d'une connexion acceptée par le réacteur
+ * home, la referme (server_detach), ou la referme et fait fermer la
+ * socket (server_remove_client).
+ */
+void server_attach(Client *c, int home);
+void server_detach(Client *c);
 void server_remove_client(int fd);
 
+/* Exécute une ligne reçue de c (NULL : ligne trop longue). Hub. */
+void server_handle_line(Client *c, char *line);
+
+/* ================================================================
+ *  Commandes (registre, hachage parfait des verbes)
+ * ================================================================ */
+
+/* Construit la table des verbes ; -1 si aucune graine ne convient */
+int  commands_init(void);
+
+/*
+ * Exécute la ligne du client i : étape de connexion, ou commande
+ * permise dans l'état de sa session. Hub.
+ */
+void commands_execute(int i, char *line);
+
+/* Classe de débit de la ligne (RATE_*), RATE_NONE pour une ligne vide */
+int  commands_class(const char *line);
+
+/* ================================================================
+ *  Boucle d'événements
+ * ================================================================ */
+
+/*
+ * Prépare, pour le thread appelant, le backend (LOOP_*) autour de la
+ * socket d'écoute, qui doit être non bloquante, et du descripteur de
+ * réveil de sa boîte aux lettres (wake_fd, -1 si aucun). 0 si succès,
+ * -1 sinon.
+ */
+int  loop_init(int backend, int listen_fd, int wake_fd);
+
+/* Backend du thread appelant */
+int  loop_backend(void);
+
+/*
+ * Inscrit une socket client ; -1 si le backend est plein. Retire celle
+ * de c, avant qu'elle soit fermée.
+ */
+int  loop_add(int fd, Client *c);
+void loop_del(Client *c);
+
+/*
+ * Reprend c après les événements du tour courant (budget de lignes
+ * épuisé) : en edge-triggered, aucun nouvel événement ne viendrait.
+ */
+void loop_defer(Client *c);
+
+/*
+ * Met à jour ce qui est surveillé sur la socket de c d'après
+ * c->in_paused (lecture) et c->out_stalled (écriture). Sans effet avec
+ * epoll, où lecture et écriture sont inscrites une fois pour toutes.
+ */
+void loop_update(Client *c);
+
+/*
+ * Attend et distribue les événements (ne rend la main que sur erreur) ;
+ * l'attente s'arrête à la prochaine échéance de la roue du réacteur.
+ */
+void loop_run(void);
+
+const char *loop_backend_name(int backend);
+
+/* ---- io_uring (server_uring.c) ----
+ * Un anneau par réacteur. Les sockets ne sont plus lues ni écrites
+ * directement : accept et recv multishot remplissent des tampons fournis
+ * au noyau, les envois d'un tour partent ensemble, et un seul
+ * io_uring_enter soumet et attend.
+ */
+
+/* 0 si le noyau accepte tout ce que le backend utilise (thread principal) */
+int     uring_probe(void);
+
+int     uring_init(int listen_fd, int wake_fd);
+int     uring_add(Client *c);
+void    uring_del(Client *c);
+
+/* POLLOUT attendu pour une file bloquée (c->out_stalled) */
+void    uring_update(Client *c);
+
+/*
+ * Soumet ce qui est prêt, attend au moins un événement pendant au plus
+ * timeout ms (-1 : sans limite), avance la roue de minuteurs, puis
+ * distribue les événements. -1 sur erreur de l'anneau.
+ */
+int     uring_wait(int timeout);
+
+/*
+ * Comme recvmsg sur les tampons déjà reçus pour c : octets copiés, 0 en
+ * fin de flux, -1 avec EAGAIN s'il n'y a rien (la réception est alors
+ * relancée si besoin).
+ */
+ssize_t uring_recv(Client *c, const struct iovec *iov, int cnt);
+
+/*
+ * Prépare l'envoi des octets de iov sur la socket de c ; uring_send_flush
+ * soumet tous les envois du tour d'un seul appel et passe chaque
+ * résultat à output_sent. -1 si la série est pleine (la vider d'abord).
+ */
+int     uring_send(Client *c, const struct iovec *iov, int cnt);
+void    uring_send_flush(void);
+
+/* ================================================================
+ *  Minuteurs (roue hiérarchique, une par réacteur)
+ * ================================================================ */
+
+/* Délais de la configuration (timeout_ms) */
+enum {
+    TIMEOUT_LOGIN,
+    TIMEOUT_IDLE,
+    TIMEOUT_READY,
+    TIMEOUT_GAME,
+    TIMEOUT_COUNT
+};
+
+/* Retient les délais de cfg ; avant le lancement des réacteurs */
+void     timers_config(const ServerConfig *cfg);
+
+/* Délai TIMEOUT_* en ms, 0 si désactivé */
+unsigned timeout_ms(int which);
+
+/* Roue du thread appelant (loop_init) */
+void     timers_init(void);
+
+/*
+ * Heure monotone lue au début du tour de boucle, en ms ou en ns : la
+ * lire ne coûte pas d'appel système.
+ */
+uint64_t timers_now(void);
+uint64_t timers_now_ns(void);
+
+/*
+ * Arme t (ou le déplace s'il l'est déjà) pour l'heure when_ms ; fn est
+ * appelé par timers_run au premier tick qui la dépasse. O(1).
+ */
+void     timer_arm(Timer *t, uint64_t when_ms, void (*fn)(Timer *t));
+void     timer_cancel(Timer *t);
+
+/* Délai d'attente de la boucle jusqu'à la prochaine échéance (ms), -1 si aucune */
+int      timers_timeout(void);
+
+/* Relit l'heure et déclenche les minuteurs échus */
+void     timers_run(void);
+
+/* Même chose à l'heure now_ns, jamais en arrière (horloge simulée du bench) */
+void     timers_run_at(uint64_t now_ns);
+
+/* Structure qui contient le minuteur t (membre member) */
+#define timer_owner(t, type, member) \
+    ((type *)(void *)((char *)(t) - offsetof(type, member)))
+
+/* ================================================================
+ *  Débit des commandes (seaux à jetons, lignes par tour)
+ * ================================================================ */
+
+/* Retient les débits de cfg ; avant le lancement des réacteurs */
+void rate_config(const ServerConfig *cfg);
+
+/* Seaux pleins et tour neuf pour une nouvelle connexion (réacteur) */
+void rate_reset(Client *c);
+
+/*
+ * Lignes du tour de c : rate_spent dit si son budget est épuisé (le
+ * client attend alors le tour suivant), rate_count en compte une de
+ * plus. Réacteur de c.
+ */
+int  rate_spent(Client *c);
+void rate_count(Client *c);
+
+/* Une ligne de plus exécutée par le hub dans ce tour */
+void rate_hub_line(void);
+
+/* Fin d'un tour de boucle du réacteur courant */
+void rate_turn(void);
+
+/*
+ * Admet la ligne de c, ou la refuse (réponse d'erreur en file, 0) si
+ * son seau est vide ou si le serveur est surchargé. Réacteur de c,
+ * avant de router la ligne.
+ */
+int  rate_admit(Client *c, const char *line);
+
+/* ================================================================
+ *  Réacteurs et messages entre threads
+ * ================================================================ */
+
+/*
+ * Lance cfg->threads réacteurs, chacun autour de sa socket d'écoute
+ * listen_fds[k] ; le hub tourne dans le thread appelant. Ne rend la
+ * main que sur erreur.
+ */
+void reactor_run(const ServerConfig *cfg, const int *listen_fds);
+
+/* Réacteur du thread appelant ; nombre de réacteurs */
+int  reactor_self(void);
+int  reactor_count(void);
+
+/* Compteurs du réacteur courant ; somme de tous les réacteurs */
+OutputStats *reactor_stats(void);
+void         reactor_stats_sum(OutputStats *sum);
+
+/* Un appel système de plus pour la boucle du thread appelant (réacteur) */
+void         reactor_syscall(void);
+
+/*
+ * Côté réacteur : nouvelle connexion (ouverture de session au hub),
+ * ligne reçue à faire exécuter par le hub (NULL : ligne trop longue),
+ * connexion perdue.
+ */
+void reactor_attach(Client *c);
+void reactor_forward(Client *c, const char *line);
+void reactor_lost(Client *c);
+
+/*
+ * Référence vers la connexion d'un client ouvert au hub (hub), et
+ * message pour cette connexion, écrit par son réacteur. Tout thread
+ * peut écrire à une référence ; le message est perdu si la connexion a
+ * été fermée. flags :
+ *  SEND_LOSSY : peut être sauté si le client est lent
+ *  SEND_FRAME : trame binaire déjà encodée (sinon, texte que le réacteur
+ *               met en trames TEXT pour un client PROTO_BIN)
+ */
+#define SEND_LOSSY  1
+#define SEND_FRAME  2
+
+ClientRef reactor_ref(Client *c);
+void      reactor_send(ClientRef to, const char *msg, size_t len, int flags);
+
+/*
+ * Même rôle sans copie : b est mis tel quel dans la file de to (une
+ * référence de plus, celle de l'appelant lui reste). b est déjà dans la
+ * forme de to (trame, ou texte pour un client PROTO_TEXT).
+ */
+void      reactor_send_buf(ClientRef to, OutBuf *b, int flags);
+
+/*
+ * Vrai si la connexion visée parle en trames ; si elle accepte les
+ * plateaux différentiels (BOARD_DELTA)
+ */
+int       reactor_binary(ClientRef to);
+int       reactor_deltas(ClientRef to);
+
+/* Côté hub : fermeture de la connexion de c */
+void reactor_close(Client *c);
+
+/*
+ * Événement pour une partie, exécuté tout de suite si le thread
+ * appelant est son exécuteur, sinon copié dans la boîte aux lettres de
+ * celui-ci (pile sans verrou, réveil par eventfd quand elle était vide).
+ */
+void reactor_post(int to, const GameEvent *ev);
+
+/*
+ * Côté exécuteur : lie (bound) ou délie la connexion d'un joueur de la
+ * partie (game, gen) chez son réacteur, et signale au hub la fin d'une
+ * partie (posté sans attendre la fin du tour).
+ */
+void reactor_bind(ClientRef to, int game, unsigned gen, int bound);
+void reactor_game_over(int game, unsigned gen);
+
+/* Ligne de to traitée : son réacteur peut en transmettre une autre */
+void reactor_ack(ClientRef to);
+
+/* Boîte aux lettres du thread prête : traite les messages reçus */
+void reactor_drain(void);
+
+/* Fin de tour : poste les lots de messages et rend les slots libérés */
+void reactor_flush(void);
+
+/* ================================================================
+ *  Entrées des clients
+ * ================================================================ */
+
+void    input_reset(Client *c);
+
+/*
+ * Lit la socket dans la place libre du tampon (sans bloquer).
+ * Retourne comme recv : octets lus, 0 à la fermeture, -1 sinon.
+ */
+ssize_t input_fill(Client *c);
+
+/*
+ * Extrait la prochaine ligne complète dans line (sans \r\n).
+ * 1 si une ligne est extraite, 0 s'il n'y en a pas, -1 si une ligne
+ * trop longue a été jetée.
+ */
+int     input_next_line(Client *c, char *line, size_t cap);
+
+/*
+ * Même rôle pour un client PROTO_BIN : trame TEXT ou MOVE rendue sous
+ * forme de commande. -2 si la trame dépasse INPUT_MAX_LINE (flux
+ * invalide : la connexion est fermée).
+ */
+int     input_next_frame(Client *c, char *line, size_t cap);
+
+/* ================================================================
+ *  Sorties des clients
+ * ================================================================ */
+
+/* Plafond de chaque file (ServerConfig.out_max) */
+void output_init(size_t high_water);
+
+/* Libère la file de c (déconnexion) : rend les tampons qu'elle tient */
+void output_reset(Client *c);
+
+/*
+ * Ajoute un message à la file de c (réacteur de c uniquement) ; il part
+ * en fin de tour, regroupé avec les autres réponses. -1 si le plafond
+ * est dépassé : le client est alors marqué closing et retiré en fin de
+ * tour.
+ */
+int  output_push(Client *c, const char *msg, size_t len);
+
+/*
+ * Message pour c selon ses SEND_* : texte mis en trames TEXT si c parle
+ * en trames, trame ou texte tel quel sinon. SEND_LOSSY : abandonné si
+ * la file est déjà à moitié pleine (plateaux des observateurs).
+ */
+void output_send(Client *c, const char *msg, size_t len, int flags);
+
+/*
+ * Met b dans la file de c sans le copier ; la file prend la référence
+ * passée (rendue si le message est abandonné).
+ */
+void output_send_buf(Client *c, OutBuf *b, int flags);
+
+/*
+ * Vrai si les commandes de c doivent attendre que sa file se vide ;
+ * output_pause les suspend alors jusque-là.
+ */
+int  output_throttled(const Client *c);
+void output_pause(Client *c);
+
+/*
+ * Reprend les commandes de c si rien ne les retient plus (file de
+ * sortie vidée, lignes en route accusées).
+ */
+void input_resume(Client *c);
+
+/* Envoie ce que la socket accepte. -1 si la socket est fermée. */
+int  output_flush(Client *c);
+
+/*
+ * Résultat d'un envoi préparé par uring_send (octets envoyés, ou
+ * -errno). -1 si la socket est fermée : l'appelant retire le client.
+ */
+int  output_sent(Client *c, ssize_t n);
+
+/* Socket de c de nouveau inscriptible */
+void output_writable(Client *c);
+
+/* Fin de tour : vide les files touchées, retire les clients trop lents */
+void output_flush_all(void);
+
+/* ---- Tampons partagés ---- */
+
+/* Copie de data, une référence (celle de l'appelant) ; NULL si pas de mémoire */
+OutBuf *outbuf_new(const char *data, size_t len);
+void    outbuf_retain(OutBuf *b);
+void    outbuf_release(OutBuf *b);
+
+/*
+ * Message pour plusieurs destinataires, sérialisé une fois par forme :
+ * texte, et trames pour les clients PROTO_BIN (frame si elle est donnée,
+ * sinon le texte mis en trames TEXT), chacune à la première connexion
+ * qui la demande. Chaque envoi ne coûte ensuite qu'un pointeur en file.
+ * msg et frame doivent rester valides jusqu'à fanout_done.
+ */
+typedef struct {
+    const char    *msg;
+    size_t         len;
+    const uint8_t *frame;
+    size_t         frame_len;
+    OutBuf        *form[2];
+} Fanout;
+
+void fanout_init(Fanout *f, const char *msg, size_t len,
+                 const uint8_t *frame, size_t frame_len);
+void fanout_send(Fanout *f, ClientRef to, int flags);
+void fanout_done(Fanout *f);
+
+/* ================================================================
+ *  Configuration
+ * ================================================================ */
+
+void config_defaults(ServerConfig *cfg);
+
+/*
+ * Lit un fichier « clé = valeur » (# pour les commentaires).
+ * 0 si succès, -1 sinon (message sur stderr).
+ */
+int  config_load(ServerConfig *cfg, const char *path);
+
+/* Vérifie et complète les valeurs. 0 si cohérent, -1 sinon. */
+int  config_check(ServerConfig *cfg);
+
+/* ================================================================
+ *  Tables extensibles
+ * ================================================================ */
+
+/* Alloue les tables à leur taille initiale. 0 si succès, -1 sinon. */
+int  tables_init(const ServerConfig *cfg);
+
+/*
+ * Slots pris et rendus en O(1) (pile des slots libres, protégée par un
+ * verrou : tout réacteur accepte des connexions) ; la table grandit
+ * quand la pile est vide. -1 si le plafond est atteint.
+ * L'adresse d'un Client ne change jamais (la boucle d'événements la
+ * mémorise), ni celle d'une Game (son exécuteur la joue pendant que le
+ * hub agrandit la table) ; g_accounts peut être déplacé.
+ */
+int  client_alloc(void);
+void client_release(int i);
+int  game_alloc(void);
+void game_release(int g);
+
+/* Ajoute un compte vide et retourne son index, -1 si plein. */
+int  account_alloc(void);
+
+/* ================================================================
+ *  Index (tables de hachage à adressage ouvert)
+ * ================================================================ */
+
+/*
+ * Un client est indexé par sa socket dès l'ouverture de sa session, et
+ * par son pseudo une fois authentifié ; un compte l'est par son pseudo
+ * dès que celui-ci est écrit. Les ajouts retournent -1 si la mémoire
+ * manque. Les index n'appartiennent qu'au hub.
+ */
+int  index_add_fd(int ci);
+void index_del_fd(int ci);
+int  index_add_name(int ci);
+void index_del_name(int ci);
+int  index_add_account(int acc);
+
+/* Client de la socket fd, -1 si inconnu. */
+int  client_index_by_fd(int fd);
+
+/* Client authentifié par pseudo (case-insensitive), -1 si absent. */
+int  client_index_by_name(const char *name);
+
+/* Compte par pseudo (case-insensitive), -1 si absent. */
+int  accounts_find(const char *username);
+
 /* ================================================================
  *  Gestion des comptes
  * ================================================================ */
 
 int         accounts_load(const char *path);
 void        accounts_save(const char *path);
-int         accounts_find(const char *username);
 int         accounts_is_friend(int acc_index, const char *username);
 void        accounts_set_bio(int acc_index, const char *bio);
 const char *accounts_get_bio(int acc_index);
@@ -139,12 +1032,18 @@ int         accounts_remove_friend(int acc_index, const char *friend_name);
  *  Fonctions utilitaires
  * ================================================================ */
 
+/*
+ * Met un message dans la file du client de la socket fd (jamais
+ * bloquant), par son réacteur s'il en a un autre. server_send_lossy
+ * peut l'abandonner si le client est lent. Hub (l'exécuteur d'une
+ * partie écrit par reactor_send).
+ */
+void server_send(int fd, const char *msg, size_t len);
+void server_send_lossy(int fd, const char *msg, size_t len);
+
 /* Envoie un message à tous sauf except_fd (ou -1). */
 void server_broadcast(const char *msg, int except_fd);
 
-/* Recherche client par pseudo (case-insensitive). */
-int  client_index_by_name(const char *name);
-
 /* Teste si username est déjà connecté. */
 int  username_logged_in(const char *username);
 
@@ -166,13 +1065,56 @@ size_t strlcpy_safe(char *dst, const char *src, size_t dstsz);
  *  Gestion des parties (game sessions)
  * ================================================================ */
 
-void games_send_board(Game *g);
-int  games_start(int client_a, int client_b);
+/*
+ * Côté hub : chaque commande sur une partie devient un événement pour
+ * son exécuteur. games_start attribue le slot et lie les deux clients
+ * (base_ms/inc_ms : pendule, 0 sans pendule) ;
+ * games_cancel_by_client les délie et rend le slot aussitôt.
+ * games_over est appelé quand l'exécuteur signale la fin de la partie.
+ * games_board renvoie le plateau complet à un joueur ou un observateur
+ * (plateau différentiel manqué).
+ */
+int  games_executor(int g);
+int  games_start(int client_a, int client_b, unsigned base_ms, unsigned inc_ms);
+void games_ready(int client_index);
 void games_process_move(int client_index, int pit);
 int  games_find_by_player_name(const char *name);
 int  games_can_observe(Game *g, const char *observer_name);
-int  games_add_observer(Game *g, int fd);
-void games_remove_observer_fd(int fd);
+void games_observe(int client_index, int g);
+void games_remove_observer(int client_index);
 void games_cancel_by_client(int client_index, int notify);
+void games_over(int g, unsigned gen);
+void games_board(int client_index);
+
+/*
+ * Côté réacteur : envoie directement à l'exécuteur MOVE et READY d'une
+ * connexion liée à une partie. 1 si la ligne est prise en charge.
+ */
+int  games_route(Client *c, const char *line);
+
+/* Côté exécuteur : joue un événement de sa boîte aux lettres */
+void games_execute(const GameEvent *ev);
+
+/* ================================================================
+ *  Adversaire virtuel (bot)
+ * ================================================================ */
+
+/*
+ * Retient bot_threads et fixe la réserve de threads auxiliaires des
+ * bots (cœurs moins réacteurs) ; avant le lancement des réacteurs.
+ */
+void bot_config(const ServerConfig *cfg);
+
+/*
+ * Alloue la table de transposition des bots et projette la table de
+ * finales si elle existe. 0 si succès, -1 sinon.
+ */
+int  bot_init(void);
+
+/*
+ * Crée un bot (engine = BOT_ENGINE_*) relié par socketpair et l'inscrit
+ * comme client authentifié. Retourne son index dans g_clients, ou -1.
+ */
+int  bot_spawn(int engine);
 
 #endif /* SERVER_H */
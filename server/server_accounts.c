@@ -14,18 +14,6 @@
 #include <string.h>
 #include "server.h"
 
-/* ================================================================
- *  Variables globales
- * ================================================================ */
-
-Client  g_clients[MAX_CLIENTS];
-Game    g_games[MAX_GAMES];
-Account g_accounts[MAX_ACCOUNTS];
-int     g_account_count = 0;
-
-fd_set  g_master_set;
-int     g_max_fd = -1;
-
 /* ================================================================
  *  Encodage/Décodage bio
  * ================================================================ */
@@ -58,9 +46,8 @@ int accounts_load(const char *path) {
     if (!f) return 0;
 
     char line[1024];
-    int n = 0;
 
-    while (n < MAX_ACCOUNTS && fgets(line, sizeof(line), f)) {
+    while (fgets(line, sizeof(line), f)) {
 
         line[strcspn(line, "\r\n")] = 0;
         if (!*line) continue;
@@ -89,6 +76,13 @@ int accounts_load(const char *path) {
             friends = (char *)"";
         }
 
+        int n = account_alloc();
+        if (n < 0) {
+            fprintf(stderr, "WARNING : account table full, %s and later accounts ignored\n",
+                    username);
+            break;
+        }
+
         strlcpy_safe(g_accounts[n].username, username,
                      sizeof(g_accounts[n].username));
 
@@ -101,12 +95,17 @@ int accounts_load(const char *path) {
         strlcpy_safe(g_accounts[n].friends, friends,
                      sizeof(g_accounts[n].friends));
 
-        n++;
+        /* Recherche par pseudo : voir server_index.c */
+        if (index_add_account(n) < 0) {
+            fprintf(stderr, "WARNING : account index full, %s and later accounts ignored\n",
+                    username);
+            g_account_count--;
+            break;
+        }
     }
 
     fclose(f);
-    g_account_count = n;
-    return n;
+    return g_account_count;
 }
 
 /* ================================================================
@@ -132,18 +131,6 @@ void accounts_save(const char *path) {
     fclose(f);
 }
 
-/* ================================================================
- *  Recherche compte par nom d'utilisateur
- * ================================================================ */
-
-int accounts_find(const char *username) {
-    for (int i = 0; i < g_account_count; i++) {
-        if (ci_equal(g_accounts[i].username, username))
-            return i;
-    }
-    return -1;
-}
-
 /* ================================================================
  *  Amities
  * ================================================================ */
@@ -0,0 +1,347 @@
+/*************************************************************************
+                           Awale -- Game (Server Bot)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Adversaire virtuel (CHALLENGE bot) :
+                           un thread par partie, relié au serveur par une
+                           socketpair et parlant en trames binaires ;
+                           moteur alpha-bêta ou MCTS
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+#include "server.h"
+#include "../ai/ai.h"
+
+/* Table de transposition partagée par tous les bots (sans verrou) */
+static TransTable g_bot_tt;
+static int        g_bot_ready = 0;
+static int        g_bot_seq   = 0;
+
+/* Threads au plus par bot ; auxiliaires encore libres pour tous les bots */
+static int         g_bot_threads = DEFAULT_BOT_THREADS;
+static _Atomic int g_bot_spare;
+
+/*
+ * État d'un bot :
+ *  sock   : extrémité de la socketpair côté bot
+ *  conn   : connexion au serveur (trames négociées par HELLO)
+ *  name   : pseudo du bot (bot#N, '#' est interdit aux vrais comptes)
+ *  index  : 0 ou 1 dans la partie, -1 avant GAME_START
+ *  engine : BOT_ENGINE_AB ou BOT_ENGINE_MCTS
+ *  mcts   : moteur MCTS propre à la partie (arbre gardé entre les coups)
+ *  threads: threads du pool MCTS, pris dans la réserve pour la partie
+ */
+typedef struct {
+    int       sock;
+    ProtoConn conn;
+    char      name[16];
+    int       index;
+    int       engine;
+    Mcts     *mcts;
+    int       threads;
+} Bot;
+
+/* =====================================================
+ *                    Initialisation
+ * ===================================================== */
+void bot_config(const ServerConfig *cfg)
+{
+    int spare = ai_default_threads() - cfg->threads;
+
+    g_bot_threads = cfg->bot_threads;
+    atomic_store_explicit(&g_bot_spare, spare > 0 ? spare : 0, memory_order_relaxed);
+}
+
+/*
+ * Threads pour une recherche : le thread du bot, plus au plus
+ * g_bot_threads - 1 auxiliaires pris dans la réserve (bot_release les
+ * rend). Toujours au moins 1, même réserve vide.
+ */
+static int bot_reserve(void)
+{
+    int spare = atomic_load_explicit(&g_bot_spare, memory_order_relaxed);
+    int take;
+
+    do {
+        take = g_bot_threads - 1;
+        if (take > spare)
+            take = spare;
+        if (take <= 0)
+            return 1;
+    } while (!atomic_compare_exchange_weak_explicit(&g_bot_spare, &spare, spare - take,
+                                                    memory_order_relaxed,
+                                                    memory_order_relaxed));
+    return 1 + take;
+}
+
+static void bot_release(int threads)
+{
+    if (threads > 1)
+        atomic_fetch_add_explicit(&g_bot_spare, threads - 1, memory_order_relaxed);
+}
+
+int bot_init(void)
+{
+    if (g_bot_ready)
+        return 0;
+
+    if (tt_init(&g_bot_tt, BOT_TT_MB, 1) < 0) {
+        perror("bot tt");
+        return -1;
+    }
+
+    /* Sans table de finales, les bots cherchent simplement plus loin */
+    if (tb_open(BOT_TB_PATH) == 0)
+        printf("Tablebase %s: positions up to %d seeds\n",
+               BOT_TB_PATH, tb_max_seeds());
+
+    g_bot_ready = 1;
+    return 0;
+}
+
+/* =====================================================
+ *                 Réflexion et envoi du coup
+ * ===================================================== */
+static void bot_play(Bot *b, const int board[12], int s0, int s1)
+{
+    PackedBoard pb;
+    packBoard(&pb, board, s0, s1);
+    pb.toMove = b->index;
+    pb.key    = pbComputeKey(&pb);
+
+    AiLimits lim = { 0, BOT_TIME_MS, 1 };
+    int move;
+
+    if (b->engine == BOT_ENGINE_MCTS) {
+        MctsResult res;
+        if ((move = mcts_search(b->mcts, &pb, &lim, 0, &res)) < 0)
+            return;
+
+        printf("[%s] move %d mcts win %.1f%% playouts %llu nodes %zu%s threads %d "
+               "time %.3fs (%.0f playouts/s)\n",
+               b->name, res.move, 100.0 * res.win_rate,
+               (unsigned long long)res.playouts, res.nodes,
+               res.reused ? " (reused)" : "", res.threads,
+               (double)res.elapsed_ns / 1e9, res.pps);
+    } else {
+        AiResult res;
+
+        lim.threads = bot_reserve();
+        move = ai_search(&pb, &g_bot_tt, &lim, &res);
+        bot_release(lim.threads);
+        if (move < 0)
+            return;
+
+        printf("[%s] move %d depth %d score %d nodes %llu threads %d time %.3fs (%.2f Mnps)\n",
+               b->name, res.move, res.depth, res.score,
+               (unsigned long long)res.nodes, res.threads,
+               (double)res.elapsed_ns / 1e9, res.nps / 1e6);
+    }
+    fflush(stdout);
+
+    char msg[32];
+    snprintf(msg, sizeof(msg), "MOVE %d", move);
+    proto_conn_send(&b->conn, msg);
+}
+
+static void bot_start(Bot *b, const char *p0)
+{
+    b->index = (strcmp(p0, b->name) == 0) ? 0 : 1;
+    proto_conn_send(&b->conn, "READY");
+}
+
+static void bot_board(Bot *b, const int pits[12], int s0, int s1, int next)
+{
+    if (b->index >= 0 && next == b->index)
+        bot_play(b, pits, s0, s1);
+}
+
+/*
+ * Ligne de texte reçue du serveur (protocole texte si le serveur a
+ * refusé les trames). Retourne 0 quand la partie est terminée.
+ */
+static int bot_handle_line(Bot *b, const char *line)
+{
+    if (strncmp(line, "GAME_START ", 11) == 0) {
+        char p0[16], p1[16];
+        if (sscanf(line, "GAME_START %15s vs %15s", p0, p1) == 2)
+            bot_start(b, p0);
+        else
+            proto_conn_send(&b->conn, "READY");
+        return 1;
+    }
+
+    if (strncmp(line, "BOARD ", 6) == 0) {
+        int p[12], s0, s1, next;
+
+        if (sscanf(line,
+                   "BOARD %d %d %d %d %d %d %d %d %d %d %d %d | Scores: %d-%d | Next: %d",
+                   &p[0], &p[1], &p[2], &p[3], &p[4], &p[5],
+                   &p[6], &p[7], &p[8], &p[9], &p[10], &p[11],
+                   &s0, &s1, &next) == 15)
+        {
+            bot_board(b, p, s0, s1, next);
+        }
+        return 1;
+    }
+
+    if (strncmp(line, "GAME_END", 8) == 0 ||
+        strncmp(line, "GAME_CANCELED", 13) == 0)
+        return 0;
+
+    return 1;
+}
+
+/* Message reçu du serveur ; 0 quand la partie est terminée */
+static int bot_handle_msg(void *ctx, const ProtoMsg *msg)
+{
+    Bot *b = ctx;
+
+    switch (msg->op) {
+        case PROTO_OP_TEXT:
+            return bot_handle_line(b, msg->text);
+        case PROTO_OP_GAME_START:
+            bot_start(b, msg->names[0]);
+            return 1;
+        case PROTO_OP_BOARD:
+            bot_board(b, msg->pits, msg->scores[0], msg->scores[1], msg->next);
+            return 1;
+        case PROTO_OP_GAME_END:
+            return 0;
+    }
+    return 1;
+}
+
+/* =====================================================
+ *                     Thread du bot
+ * ===================================================== */
+static void *bot_thread(void *arg)
+{
+    Bot *b = arg;
+
+    if (proto_conn_init(&b->conn, b->sock, PROTO_WANT_BIN) == 0)
+        while (proto_conn_read(&b->conn, bot_handle_msg, b) > 0)
+            ;
+
+    /* La fermeture est vue comme une déconnexion par la boucle d'événements */
+    close(b->sock);
+    mcts_destroy(b->mcts);
+    bot_release(b->threads);
+    free(b);
+    return NULL;
+}
+
+/* =====================================================
+ *                   Créer un adversaire
+ * ===================================================== */
+int bot_spawn(int engine)
+{
+    if (!g_bot_ready && bot_init() < 0)
+        return -1;
+
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0)
+        return -1;
+
+    Bot *b = calloc(1, sizeof(*b));
+    if (!b) {
+        close(sv[0]);
+        close(sv[1]);
+        return -1;
+    }
+
+    b->sock   = sv[1];
+    b->index  = -1;
+    b->engine = engine;
+    snprintf(b->name, sizeof(b->name), "%s#%d", BOT_NAME, ++g_bot_seq);
+
+    /* Le pool MCTS vit toute la partie : ses auxiliaires aussi */
+    if (engine == BOT_ENGINE_MCTS) {
+        b->threads = bot_reserve();
+        if ((b->mcts = mcts_create(b->threads, BOT_MCTS_MB)) == NULL) {
+            bot_release(b->threads);
+            close(sv[0]);
+            close(sv[1]);
+            free(b);
+            return -1;
+        }
+    }
+
+    pthread_t tid;
+    if (pthread_create(&tid, NULL, bot_thread, b) != 0) {
+        close(sv[0]);
+        close(sv[1]);
+        mcts_destroy(b->mcts);
+        bot_release(b->threads);
+        free(b);
+        return -1;
+    }
+    pthread_detach(tid);
+
+    /* Côté serveur, la socketpair est non bloquante comme toute socket client */
+    fcntl(sv[0], F_SETFL, fcntl(sv[0], F_GETFL) | O_NONBLOCK);
+
+    /* Le thread du bot voit la fermeture de sv[0] et se termine */
+    int slot = client_alloc();
+    if (slot < 0) {
+        close(sv[0]);
+        return -1;
+    }
+
+    /* Côté serveur, le bot est un client déjà authentifié, servi par le hub */
+    Client *c = &g_clients[slot];
+    c->fd             = sv[0];
+    c->logged_in      = 1;
+    c->login_stage    = 2;
+    c->in_game        = 0;
+    c->private_mode   = 0;
+    c->is_bot         = 1;
+    c->opponent_index = -1;
+    c->player_index   = -1;
+    c->game_index     = -1;
+    c->observing      = -1;
+    c->pending_friend_reqs[0] = '\0';
+    c->challenge_to[0] = '\0';
+    c->home           = REACTOR_HUB;
+    c->reactor        = REACTOR_HUB;
+    c->in_paused      = 0;
+    c->closing        = 0;
+    c->lost           = 0;
+    c->play_game      = -1;
+    c->in_flight      = 0;
+    c->greeted        = 0;
+    atomic_store_explicit(&c->proto, PROTO_TEXT, memory_order_relaxed);
+    atomic_store_explicit(&c->deltas, 0, memory_order_relaxed);
+    input_reset(c);
+    rate_reset(c);
+    copy_bounded(c->name, sizeof(c->name), b->name);
+
+    if (index_add_fd(slot) < 0) {
+        close(sv[0]);
+        c->fd        = -1;
+        c->logged_in = 0;
+        c->is_bot    = 0;
+        client_release(slot);
+        return -1;
+    }
+    c->attached = 1;
+
+    if (index_add_name(slot) < 0 || loop_add(sv[0], c) < 0) {
+        /* Retrait complet : index, socket et slot */
+        server_remove_client(sv[0]);
+        return -1;
+    }
+
+    return slot;
+}
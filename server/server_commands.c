@@ -0,0 +1,1181 @@
+/*************************************************************************
+                           Awale -- Game (Server Commands)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Connexion des clients et registre des commandes :
+                           verbe découpé en un passage, table de hachage
+                           parfaite, un gestionnaire par commande avec les
+                           états de session où elle est permise
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "server.h"
+
+/* =====================================================
+ *                  Authentification
+ * ===================================================== */
+
+/* Comparaison de mot de passe limitée (évite les warnings de %s). */
+static int password_match(const char *a, const char *b)
+{
+    return strncmp(a, b, 31) == 0;
+}
+
+static int is_valid_username(const char *username)
+{
+    if (!username || !*username) return 0;
+    if (strlen(username) > 15) return 0;
+
+    /* Réservé à l'adversaire virtuel (CHALLENGE bot) */
+    if (strcasecmp(username, BOT_NAME) == 0) return 0;
+    
+    for (size_t i = 0; username[i]; i++) {
+        char c = username[i];
+        if (!((c >= 'a' && c <= 'z') ||
+              (c >= 'A' && c <= 'Z') ||
+              (c >= '0' && c <= '9') ||
+              c == '_' || c == '-'))
+            return 0;
+    }
+    return 1;
+}
+
+/*
+ * Fin de l'authentification : le client devient joignable par son
+ * pseudo. Retourne 0 (et renvoie à l'étape du pseudo) si l'index est
+ * plein.
+ */
+static int server_login(int i)
+{
+    if (index_add_name(i) < 0) {
+        const char *msg = "ERROR : Server full !\nEnter your username :\n";
+        server_send(g_clients[i].fd, msg, strlen(msg));
+        g_clients[i].login_stage = 0;
+        g_clients[i].name[0] = '\0';
+        return 0;
+    }
+
+    g_clients[i].logged_in   = 1;
+    g_clients[i].login_stage = 2;
+    return 1;
+}
+
+/* Tant que le client n'est pas connecté, chaque ligne est une étape du login */
+static void cmd_login(int i, char *buf)
+{
+    int fd = g_clients[i].fd;
+
+    /* ---------- Étape 0 : USERNAME ---------- */
+    if (g_clients[i].login_stage == 0)
+    {
+        if (buf[0] == '\0') {
+            const char *m = "Enter your username :\n";
+            server_send(fd, m, strlen(m));
+            return;
+        }
+
+        /* Valider le format du username */
+        if (!is_valid_username(buf)) {
+            const char *msg = 
+                "ERROR : Invalid username (alphanumeric, - and _ only, max 15 chars)\n";
+            server_send(fd, msg, strlen(msg));
+            const char *prompt = "Enter your username :\n";
+            server_send(fd, prompt, strlen(prompt));
+            return;
+        }
+
+        /* Vérifier si le username existe déjà */
+        if (username_logged_in(buf)) {
+            char msg[128];
+            snprintf(msg, sizeof(msg),
+                     "ERROR : User %s is already logged in !\n", buf);
+            server_send(fd, msg, strlen(msg));
+            const char *prompt = "Enter your username :\n";
+            server_send(fd, prompt, strlen(prompt));
+            return;
+        }
+
+        /* On mets le username en minuscule */
+        char normalized[16];
+        to_lowercase(normalized, buf, sizeof(normalized));
+        copy_bounded(g_clients[i].name,
+                     sizeof(g_clients[i].name),
+                     normalized);
+
+        int acc = accounts_find(g_clients[i].name);
+
+        if (acc >= 0) {
+            char msg[128];
+            snprintf(msg, sizeof(msg),
+                     "Nice to meet you again, %s !\nEnter your password :\n",
+                     g_clients[i].name);
+            server_send(fd, msg, strlen(msg));
+        } else {
+            char msg[128];
+            snprintf(msg, sizeof(msg),
+                     "Welcome, %s !\nPlease set your password :\n",
+                     g_clients[i].name);
+            server_send(fd, msg, strlen(msg));
+        }
+
+        g_clients[i].login_stage = 1;
+        return;
+    }
+
+    /* ---------- Étape 1 : Mot de passe ---------- */
+    int acc = accounts_find(g_clients[i].name);
+
+    if (acc >= 0)
+    {
+        if (password_match(g_accounts[acc].password, buf))
+        {
+            if (username_logged_in(g_clients[i].name)) {
+                const char *msg =
+                    "ERROR : Already logged in on another session !\n";
+                server_send(fd, msg, strlen(msg));
+
+                g_clients[i].login_stage = 0;
+                g_clients[i].name[0] = '\0';
+
+                const char *prompt = "Enter your username :\n";
+                server_send(fd, prompt, strlen(prompt));
+                return;
+            }
+
+            if (!server_login(i))
+                return;
+
+            const char *ok = "Logged in successfully !\n";
+            server_send(fd, ok, strlen(ok));
+        }
+        else {
+            const char *msg =
+                "ERROR : Wrong password\nEnter your username again :\n";
+            server_send(fd, msg, strlen(msg));
+
+            g_clients[i].login_stage = 0;
+            g_clients[i].name[0] = '\0';
+        }
+
+        return;
+    }
+    else
+    {
+        int acc = account_alloc();
+        if (acc < 0) {
+            const char *msg = "ERROR : Account storage full !\n";
+            server_send(fd, msg, strlen(msg));
+            g_clients[i].login_stage = 0;
+            g_clients[i].name[0] = '\0';
+            return;
+        }
+
+        /* Création d'un nouveau compte */
+        copy_bounded(g_accounts[acc].username,
+                     sizeof(g_accounts[acc].username),
+                     g_clients[i].name);
+
+        copy_bounded(g_accounts[acc].password,
+                     sizeof(g_accounts[acc].password),
+                     buf);
+
+        if (index_add_account(acc) < 0) {
+            g_account_count--;
+            const char *msg = "ERROR : Account storage full !\n";
+            server_send(fd, msg, strlen(msg));
+            g_clients[i].login_stage = 0;
+            g_clients[i].name[0] = '\0';
+            return;
+        }
+
+        accounts_save(USERS_FILE);
+
+        if (!server_login(i))
+            return;
+
+        const char *ok = "New account created and logged in !\n";
+        server_send(fd, ok, strlen(ok));
+        return;
+    }
+}
+
+/* =====================================================
+ *              Commandes du menu principal
+ * ===================================================== */
+
+/* ---- HELP ---- */
+static void cmd_help(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+    (void)args;
+
+    const char *m =
+        "Commands: LIST, GAMES, CHALLENGE, ACCEPT, REFUSE, MOVE, "
+        "CANCEL_GAME, OBSERVE, OUT_OBSERVER, SAY, MESSAGE, "
+        "BIO, SHOWBIO, MY_FRIENDS, FRIEND, ACCEPT_FRIEND, DECLINE_FRIEND, UNFRIEND, PRIVATE, "
+        "STATS, QUIT.\n";
+    server_send(fd, m, strlen(m));
+}
+
+/* ---- LIST ---- */
+static void cmd_list(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+    (void)args;
+
+    char msg[512];
+    msg[0] = '\0';
+    append_bounded(msg, sizeof(msg), "ONLINE:");
+
+    int cap = atomic_load_explicit(&g_client_cap, memory_order_acquire);
+    for (int j = 0; j < cap; j++) {
+
+        /* Seul un slot ouvert au hub a une socket stable */
+        if (g_clients[j].logged_in &&
+            j != i &&
+            !g_clients[j].in_game &&
+            !g_clients[j].is_bot)
+        {
+            append_bounded(msg, sizeof(msg), " ");
+            append_bounded(msg, sizeof(msg), g_clients[j].name);
+        }
+    }
+
+    if (strcmp(msg, "ONLINE:") == 0)
+        append_bounded(msg, sizeof(msg), " (no other players online)");
+
+    append_bounded(msg, sizeof(msg), "\n");
+    server_send(fd, msg, strlen(msg));
+}
+
+/* ---- GAMES ---- */
+static void cmd_games(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+    (void)args;
+
+    char msg[512];
+    msg[0] = '\0';
+    append_bounded(msg, sizeof(msg), "ONGOING GAMES:\n");
+    int count = 0;
+
+    for (int g = 0; g < g_game_cap; g++) {
+        if (!g_games[g].active)
+            continue;
+
+        char line[128];
+        snprintf(line, sizeof(line),
+                 "  ID %d: %s vs %s\n",
+                 g, g_games[g].p0.name, g_games[g].p1.name);
+
+        append_bounded(msg, sizeof(msg), line);
+        count++;
+    }
+
+    if (!count)
+        append_bounded(msg, sizeof(msg), "  (no active games)\n");
+
+    server_send(fd, msg, strlen(msg));
+}
+
+/* ---- OBSERVE <id> ---- */
+static void cmd_observe(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    int id;
+    if (sscanf(args, "%d", &id) != 1) {
+        const char *msg = "ERROR : Usage: OBSERVE <id> !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    if (id < 0 || id >= g_game_cap || !g_games[id].active) {
+        const char *msg = "ERROR : Invalid game ID !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    if (!games_can_observe(&g_games[id], g_clients[i].name)) {
+        const char *msg =
+            "ERROR : Game is private. You are not allowed to observe !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    /* L'exécuteur de la partie répond et envoie le plateau */
+    games_observe(i, id);
+}
+
+/* ---- OUT_OBSERVER ---- */
+static void cmd_out_observer(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+    (void)args;
+
+    games_remove_observer(i);
+    const char *msg = "Left observation mode. Back to menu.\n";
+    server_send(fd, msg, strlen(msg));
+}
+
+/* ---- PRIVATE ON|OFF ---- */
+static void cmd_private(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    char mode[8] = {0};
+    sscanf(args, "%7s", mode);
+
+    if (strcasecmp(mode, "ON") == 0) {
+        g_clients[i].private_mode = 1;
+        const char *msg =
+            "Private mode ON: only your friends may observe your games.\n";
+        server_send(fd, msg, strlen(msg));
+    } else {
+        g_clients[i].private_mode = 0;
+        const char *msg =
+            "Private mode OFF: everyone may observe your games.\n";
+        server_send(fd, msg, strlen(msg));
+    }
+}
+
+/* ---- BIO <texte> ---- */
+static void cmd_bio(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    int acc = accounts_find(g_clients[i].name);
+    if (acc < 0) {
+        const char *msg = "ERROR : Account not found !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    const char *src = args;
+    while (*src == ' ' || *src == '\t')
+        src++;
+
+    if (*src == '\0') {
+        const char *msg = "ERROR : Bio cannot be empty !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    char cleaned[512];
+    size_t k = 0;
+    int lines = 0;
+
+    while (*src && k + 1 < sizeof(cleaned)) {
+        char c = *src++;
+
+        if (c == '\r') continue;
+        if (c == '\t') c = ' ';
+        if (c == '|')  c = '/';
+        if (c == '\\' && *src == 'n') {
+            c = '\n';
+            src++;
+        }
+        if (c == '\n') {
+            if (++lines >= 10)
+                c = ' ';
+        }
+        cleaned[k++] = c;
+    }
+    cleaned[k] = '\0';
+
+    accounts_set_bio(acc, cleaned);
+    accounts_save(USERS_FILE);
+
+    const char *ok = "Bio updated\n";
+    server_send(fd, ok, strlen(ok));
+}
+
+/* ---- SHOWBIO <user> ---- */
+static void cmd_showbio(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    char target[16];
+    if (sscanf(args, "%15s", target) != 1) {
+        const char *msg = "ERROR : Usage: SHOWBIO <user> !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    int acc = accounts_find(target);
+    if (acc < 0) {
+        const char *msg = "ERROR : User not found !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    const char *bio = accounts_get_bio(acc);
+
+    char msg[700];
+    snprintf(msg, sizeof(msg),
+             "\n--- BIO of %s ---\n%s\n-----------------\n",
+             g_accounts[acc].username,
+             (bio && bio[0]) ? bio : "(no bio)");
+    server_send(fd, msg, strlen(msg));
+}
+
+/* ---- MY_FRIENDS ---- */
+static void cmd_my_friends(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+    (void)args;
+
+    int me = accounts_find(g_clients[i].name);
+    if (me < 0) {
+        const char *msg = "ERROR : Account not found !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    /* Vérifier si le joueur a une liste d'amis */
+    if (!g_accounts[me].friends[0]) {
+        const char *msg = "MY_FRIENDS:\n  (no friends yet)\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    char msg[512];
+    msg[0] = '\0';
+    append_bounded(msg, sizeof(msg), "MY_FRIENDS:");
+
+    char friends_copy[256];
+    strlcpy_safe(friends_copy, g_accounts[me].friends, sizeof(friends_copy));
+
+    char *tok = strtok(friends_copy, ",");
+    int count = 0;
+    while (tok && count < 50) {  /* Safety limit */
+        append_bounded(msg, sizeof(msg), " ");
+        append_bounded(msg, sizeof(msg), tok);
+        tok = strtok(NULL, ",");
+        count++;
+    }
+
+    append_bounded(msg, sizeof(msg), "\n");
+    server_send(fd, msg, strlen(msg));
+}
+
+/* ---- FRIEND <user> ---- */
+static void cmd_friend(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    char target[16];
+    if (sscanf(args, "%15s", target) != 1) {
+        const char *msg = "ERROR : Usage: FRIEND <user> !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    if (ci_equal(target, g_clients[i].name)) {
+        const char *msg = "ERROR : You cannot friend yourself !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    int me  = accounts_find(g_clients[i].name);
+    int you = accounts_find(target);
+
+    if (me < 0 || you < 0) {
+        const char *msg = "ERROR : Unknown user !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    if (accounts_is_friend(me, target)) {
+        const char *msg = "Already friends\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    /* Trouver le joueur à qui envoyer la demande */
+    int target_idx = client_index_by_name(target);
+    if (target_idx < 0) {
+        const char *msg = "Friend request sent (user offline)\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    char req_msg[64];
+    snprintf(req_msg, sizeof(req_msg), "FRIEND_REQUEST %s\n", g_clients[i].name);
+    
+    /* On ajoute au demandes en cours */
+    size_t cur_len = strlen(g_clients[target_idx].pending_friend_reqs);
+    if (cur_len > 0 && cur_len + strlen(g_clients[i].name) + 2 < sizeof(g_clients[target_idx].pending_friend_reqs)) {
+        append_bounded(g_clients[target_idx].pending_friend_reqs,
+                       sizeof(g_clients[target_idx].pending_friend_reqs), ",");
+        append_bounded(g_clients[target_idx].pending_friend_reqs,
+                       sizeof(g_clients[target_idx].pending_friend_reqs), g_clients[i].name);
+    } else if (cur_len == 0 && strlen(g_clients[i].name) < sizeof(g_clients[target_idx].pending_friend_reqs)) {
+        copy_bounded(g_clients[target_idx].pending_friend_reqs,
+                     sizeof(g_clients[target_idx].pending_friend_reqs), g_clients[i].name);
+    }
+
+    server_send(g_clients[target_idx].fd, req_msg, strlen(req_msg));
+
+    const char *ok = "Friend request sent\n";
+    server_send(fd, ok, strlen(ok));
+}
+
+/* ---- UNFRIEND <user> ---- */
+static void cmd_unfriend(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    char target[16];
+    if (sscanf(args, "%15s", target) != 1) {
+        const char *msg = "ERROR : Usage: UNFRIEND <user> !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    if (ci_equal(target, g_clients[i].name)) {
+        const char *msg = "ERROR : You cannot unfriend yourself !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    int me = accounts_find(g_clients[i].name);
+    int them = accounts_find(target);
+
+    if (me < 0) {
+        const char *msg = "ERROR : Account not found !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+    
+    int removed_me = accounts_remove_friend(me, target);
+    
+    if (them >= 0) {
+        accounts_remove_friend(them, g_clients[i].name);
+    }
+
+    accounts_save(USERS_FILE);
+
+    if (removed_me) {
+        const char *msg = "Friend removed !\n";
+        server_send(fd, msg, strlen(msg));
+    } else {
+        const char *msg = "No such friend\n";
+        server_send(fd, msg, strlen(msg));
+    }
+}
+
+/* ---- ACCEPT_FRIEND <user> ---- */
+static void cmd_accept_friend(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    char requester[16];
+    if (sscanf(args, "%15s", requester) != 1) {
+        const char *msg = "ERROR : Usage: ACCEPT_FRIEND <user> !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    int me = accounts_find(g_clients[i].name);
+    int them = accounts_find(requester);
+
+    if (me < 0 || them < 0) {
+        const char *msg = "ERROR : Unknown user !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    int ok1 = 0, full1 = 0;
+    accounts_add_friend(me, requester, &ok1, &full1);
+
+    int ok2 = 0, full2 = 0;
+    accounts_add_friend(them, g_clients[i].name, &ok2, &full2);
+
+    if (full1 || full2) {
+        const char *msg = "ERROR : Friends list full !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    accounts_save(USERS_FILE);
+
+    char reqs[256];
+    strcpy(reqs, g_clients[i].pending_friend_reqs);
+    g_clients[i].pending_friend_reqs[0] = '\0';
+
+    char *tok = strtok(reqs, ",");
+    while (tok) {
+        if (strcasecmp(tok, requester) != 0) {
+            if (g_clients[i].pending_friend_reqs[0]) {
+                strcat(g_clients[i].pending_friend_reqs, ",");
+            }
+            strcat(g_clients[i].pending_friend_reqs, tok);
+        }
+        tok = strtok(NULL, ",");
+    }
+
+    const char *msg = "Friend request accepted !\n";
+    server_send(fd, msg, strlen(msg));
+
+    int requester_idx = client_index_by_name(requester);
+    if (requester_idx >= 0) {
+        char notify[64];
+        snprintf(notify, sizeof(notify), "FRIEND_ACCEPTED %s\n", g_clients[i].name);
+        server_send(g_clients[requester_idx].fd, notify, strlen(notify));
+    }
+}
+
+/* ---- DECLINE_FRIEND <user> ---- */
+static void cmd_decline_friend(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    char requester[16];
+    if (sscanf(args, "%15s", requester) != 1) {
+        const char *msg = "ERROR : Usage: DECLINE_FRIEND <user> !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    char reqs[256];
+    strcpy(reqs, g_clients[i].pending_friend_reqs);
+    g_clients[i].pending_friend_reqs[0] = '\0';
+
+    char *tok = strtok(reqs, ",");
+    while (tok) {
+        if (strcasecmp(tok, requester) != 0) {
+            if (g_clients[i].pending_friend_reqs[0]) {
+                strcat(g_clients[i].pending_friend_reqs, ",");
+            }
+            strcat(g_clients[i].pending_friend_reqs, tok);
+        }
+        tok = strtok(NULL, ",");
+    }
+
+    const char *msg = "Friend request declined\n";
+    server_send(fd, msg, strlen(msg));
+
+    int requester_idx = client_index_by_name(requester);
+    if (requester_idx >= 0) {
+        char notify[64];
+        snprintf(notify, sizeof(notify), "FRIEND_DECLINED %s\n", g_clients[i].name);
+        server_send(g_clients[requester_idx].fd, notify, strlen(notify));
+    }
+}
+
+/*
+ * Pendule « base+incrément » : base en minutes (ou en secondes avec
+ * « s », 30s+2), incrément en secondes. 0 si valide, -1 sinon.
+ */
+static int clock_parse(const char *text, unsigned *base_ms, unsigned *inc_ms)
+{
+    char *end;
+
+    if (*text < '0' || *text > '9')
+        return -1;
+
+    unsigned long base = strtoul(text, &end, 10);
+    if (*end == 's') {
+        end++;
+    } else {
+        if (base > CLOCK_BASE_MAX / 60)
+            return -1;
+        base *= 60;
+    }
+
+    if (*end != '+' || end[1] < '0' || end[1] > '9')
+        return -1;
+
+    unsigned long inc = strtoul(end + 1, &end, 10);
+    if (*end != '\0' || base == 0 || base > CLOCK_BASE_MAX || inc > CLOCK_INC_MAX)
+        return -1;
+
+    *base_ms = (unsigned)base * 1000u;
+    *inc_ms  = (unsigned)inc * 1000u;
+    return 0;
+}
+
+/* ---- CHALLENGE <user> [base+incrément] ---- */
+static void cmd_challenge(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    char target[16];
+    if (sscanf(args, "%15s", target) != 1) {
+        const char *msg = "ERROR : Usage: CHALLENGE <user> [base+increment] !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    if (ci_equal(target, g_clients[i].name)) {
+        const char *msg = "ERROR : You cannot challenge yourself !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    /* Adversaire virtuel : la partie commence tout de suite */
+    if (ci_equal(target, BOT_NAME)) {
+        char engine[8] = "ab";
+        sscanf(args, "%*15s %7s", engine);
+
+        if (!ci_equal(engine, "ab") && !ci_equal(engine, "mcts")) {
+            const char *msg = "ERROR : Usage: CHALLENGE bot [ab|mcts] !\n";
+            server_send(fd, msg, strlen(msg));
+            return;
+        }
+
+        int bot = bot_spawn(ci_equal(engine, "mcts") ? BOT_ENGINE_MCTS
+                                                     : BOT_ENGINE_AB);
+        if (bot < 0 || games_start(i, bot, 0, 0) < 0) {
+            if (bot >= 0)
+                server_remove_client(g_clients[bot].fd);
+            const char *msg = "ERROR : No bot available !\n";
+            server_send(fd, msg, strlen(msg));
+        }
+        return;
+    }
+
+    /* Pendule facultative, retenue jusqu'à l'ACCEPT du joueur défié */
+    char     clock[24];
+    unsigned base = 0, inc = 0;
+
+    if (sscanf(args, "%*15s %23s", clock) == 1 &&
+        clock_parse(clock, &base, &inc) < 0) {
+        const char *msg = "ERROR : Usage: CHALLENGE <user> [base+increment] !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    int idx = client_index_by_name(target);
+    if (idx < 0) {
+        const char *msg = "ERROR : No such user !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    if (g_clients[idx].in_game) {
+        char msg[128];
+        snprintf(msg, sizeof(msg),
+                 "ERROR : %s is already in a game !\n", target);
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    copy_bounded(g_clients[i].challenge_to, sizeof(g_clients[i].challenge_to),
+                 g_clients[idx].name);
+    g_clients[i].challenge_base = base;
+    g_clients[i].challenge_inc  = inc;
+
+    char msg[64];
+    if (base == 0)
+        snprintf(msg, sizeof(msg), "CHALLENGE_FROM %s\n", g_clients[i].name);
+    else if (base % 60000u == 0)
+        snprintf(msg, sizeof(msg), "CHALLENGE_FROM %s %u+%u\n",
+                 g_clients[i].name, base / 60000u, inc / 1000u);
+    else
+        snprintf(msg, sizeof(msg), "CHALLENGE_FROM %s %us+%u\n",
+                 g_clients[i].name, base / 1000u, inc / 1000u);
+    server_send(g_clients[idx].fd, msg, strlen(msg));
+
+    const char *ok = "Challenge sent\n";
+    server_send(fd, ok, strlen(ok));
+}
+
+/* ---- REFUSE <user> ---- */
+static void cmd_refuse(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    char target[16];
+    if (sscanf(args, "%15s", target) != 1) {
+        const char *msg = "ERROR : Usage: REFUSE <user> !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    int idx = client_index_by_name(target);
+    if (idx < 0) {
+        const char *msg = "ERROR : No such user !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    char msg[64];
+    snprintf(msg, sizeof(msg),
+             "REFUSED_BY %s\n", g_clients[i].name);
+    server_send(g_clients[idx].fd, msg, strlen(msg));
+
+    const char *ok = "Challenge refused\n";
+    server_send(fd, ok, strlen(ok));
+}
+
+/* ---- ACCEPT <user> ---- */
+static void cmd_accept(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    char target[16];
+    if (sscanf(args, "%15s", target) != 1) {
+        const char *msg = "ERROR : Usage: ACCEPT <user> !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    int idx = client_index_by_name(target);
+    if (idx < 0) {
+        const char *msg = "ERROR : No such user !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    if (g_clients[idx].in_game) {
+        char msg[128];
+        snprintf(msg, sizeof(msg),
+                 "ERROR : %s is already in a game !\n", target);
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    /* La pendule du défi lancé par idx, s'il visait ce joueur */
+    unsigned base = 0, inc = 0;
+    if (ci_equal(g_clients[idx].challenge_to, g_clients[i].name)) {
+        base = g_clients[idx].challenge_base;
+        inc  = g_clients[idx].challenge_inc;
+        g_clients[idx].challenge_to[0] = '\0';
+    }
+
+    games_start(i, idx, base, inc);
+}
+
+/* ---- READY ---- */
+static void cmd_ready(int i, char *args)
+{
+    (void)args;
+
+    games_ready(i);
+}
+
+/* ---- MOVE <pit> ---- */
+static void cmd_move(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    int pit;
+    if (sscanf(args, "%d", &pit) != 1) {
+        const char *msg = "ERROR : Usage: MOVE <0-11> !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    games_process_move(i, pit);
+}
+
+/* ---- BOARD (plateau complet, après un plateau différentiel manqué) ---- */
+static void cmd_board(int i, char *args)
+{
+    (void)args;
+
+    games_board(i);
+}
+
+/* ---- CANCEL_GAME ---- */
+static void cmd_cancel_game(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+    (void)args;
+
+    games_cancel_by_client(i, 1);
+
+    const char *ok = "Game canceled. Back to menu.\n";
+    server_send(fd, ok, strlen(ok));
+}
+
+/* ---- MESSAGE <user> <message> ---- */
+static void cmd_message(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    char target[16];
+    char body[480];
+    memset(body, 0, sizeof(body));
+
+    if (sscanf(args, "%15s %479[^\n]", target, body) < 2) {
+        const char *msg =
+            "ERROR : Usage: MESSAGE <user> <message> !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    if (ci_equal(target, g_clients[i].name)) {
+        const char *msg = "ERROR : You cannot message yourself !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    body[479] = '\0';
+
+    int idx = client_index_by_name(target);
+    if (idx < 0) {
+        const char *msg = "ERROR : User not found !\n";
+        server_send(fd, msg, strlen(msg));
+        return;
+    }
+
+    size_t body_len = strlen(body);
+    if (body_len > 440) body_len = 440;
+
+    char pm[BUF_SIZE];
+    snprintf(pm, sizeof(pm),
+             "PM from %s: %.*s\n",
+             g_clients[i].name, (int)body_len, body);
+
+    server_send(g_clients[idx].fd, pm, strlen(pm));
+
+    const char *ok = "Message sent\n";
+    server_send(fd, ok, strlen(ok));
+}
+
+/* ---- SAY <message> ---- */
+static void cmd_say(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+
+    const char *text = args;
+    size_t msg_len = strlen(text);
+    if (msg_len > 450) msg_len = 450;
+
+    char msg[BUF_SIZE];
+    snprintf(msg, sizeof(msg),
+             "CHAT %s: %.*s\n",
+             g_clients[i].name, (int)msg_len, text);
+
+    server_broadcast(msg, fd);
+}
+
+/* ---- STATS ---- */
+static void cmd_stats(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+    (void)args;
+
+    OutputStats st;
+    reactor_stats_sum(&st);
+
+    char msg[384];
+    snprintf(msg, sizeof(msg),
+             "STATS out_queued=%llu out_peak=%llu out_stalled=%llu "
+             "out_paused=%llu out_dropped=%llu out_kicked=%llu "
+             "loop_syscalls=%llu rate_rejected=%llu rate_shed=%llu "
+             "rate_throttled=%llu\n",
+             (unsigned long long)st.queued, (unsigned long long)st.peak,
+             (unsigned long long)st.stalled, (unsigned long long)st.paused,
+             (unsigned long long)st.dropped, (unsigned long long)st.kicked,
+             (unsigned long long)st.syscalls, (unsigned long long)st.rejected,
+             (unsigned long long)st.shed, (unsigned long long)st.throttled);
+    server_send(fd, msg, strlen(msg));
+}
+
+/* ---- QUIT ---- */
+static void cmd_quit(int i, char *args)
+{
+    int fd = g_clients[i].fd;
+    (void)args;
+
+    server_remove_client(fd);
+}
+
+/* =====================================================
+ *                 Registre des commandes
+ * ===================================================== */
+
+/* États de session (Command.states) */
+#define CMD_MENU       (1u << 0)    /* connecté, hors partie */
+#define CMD_PLAYING    (1u << 1)    /* joue une partie */
+#define CMD_OBSERVING  (1u << 2)    /* observe une partie */
+#define CMD_IDLE       (CMD_MENU | CMD_OBSERVING)
+#define CMD_ANY        (CMD_MENU | CMD_PLAYING | CMD_OBSERVING)
+
+/* Forme de la ligne (Command.flags) */
+#define CMD_ARGS       (1u << 0)    /* "VERBE <arguments>", sinon le verbe seul */
+#define CMD_NOCASE     (1u << 1)    /* verbe reconnu quelle que soit la casse */
+
+/*
+ *  verb   : premier mot de la ligne
+ *  run    : gestionnaire ; args pointe après l'espace qui suit le verbe
+ *  states : états de session où la commande est permise
+ *  rate   : classe de débit (RATE_*), vérifiée par le réacteur
+ *  denied : réponse dans les autres états
+ */
+typedef struct {
+    const char *verb;
+    void      (*run)(int i, char *args);
+    unsigned    flags;
+    unsigned    states;
+    int         rate;
+    const char *denied;
+} Command;
+
+static const Command g_commands[] = {
+    { "HELP",           cmd_help,           CMD_NOCASE, CMD_ANY,     RATE_LOBBY, NULL },
+    { "LIST",           cmd_list,           0,          CMD_ANY,     RATE_LOBBY, NULL },
+    { "GAMES",          cmd_games,          0,          CMD_ANY,     RATE_LOBBY, NULL },
+    { "OBSERVE",        cmd_observe,        CMD_ARGS,   CMD_IDLE,    RATE_LOBBY,
+      "ERROR : You cannot observe while in a game !\n" },
+    { "OUT_OBSERVER",   cmd_out_observer,   0,          CMD_ANY,     RATE_LOBBY, NULL },
+    { "PRIVATE",        cmd_private,        CMD_ARGS,   CMD_ANY,     RATE_LOBBY, NULL },
+    { "BIO",            cmd_bio,            CMD_ARGS,   CMD_ANY,     RATE_LOBBY, NULL },
+    { "SHOWBIO",        cmd_showbio,        CMD_ARGS,   CMD_ANY,     RATE_LOBBY, NULL },
+    { "MY_FRIENDS",     cmd_my_friends,     0,          CMD_ANY,     RATE_LOBBY, NULL },
+    { "FRIEND",         cmd_friend,         CMD_ARGS,   CMD_ANY,     RATE_CHAT,  NULL },
+    { "UNFRIEND",       cmd_unfriend,       CMD_ARGS,   CMD_ANY,     RATE_CHAT,  NULL },
+    { "ACCEPT_FRIEND",  cmd_accept_friend,  CMD_ARGS,   CMD_ANY,     RATE_CHAT,  NULL },
+    { "DECLINE_FRIEND", cmd_decline_friend, CMD_ARGS,   CMD_ANY,     RATE_CHAT,  NULL },
+    { "CHALLENGE",      cmd_challenge,      CMD_ARGS,   CMD_IDLE,    RATE_CHAT,
+      "ERROR : You cannot challenge while in a game !\n" },
+    { "REFUSE",         cmd_refuse,         CMD_ARGS,   CMD_IDLE,    RATE_CHAT,
+      "ERROR : You cannot refuse while in a game !\n" },
+    { "ACCEPT",         cmd_accept,         CMD_ARGS,   CMD_IDLE,    RATE_GAME,
+      "ERROR : You cannot accept while in a game !\n" },
+    { "READY",          cmd_ready,          0,          CMD_ANY,     RATE_GAME,  NULL },
+    { "MOVE",           cmd_move,           CMD_ARGS,   CMD_ANY,     RATE_GAME,  NULL },
+    { "BOARD",          cmd_board,          0,          CMD_PLAYING | CMD_OBSERVING, RATE_GAME,
+      "ERROR : Not in game !\n" },
+    { "CANCEL_GAME",    cmd_cancel_game,    0,          CMD_PLAYING, RATE_GAME,
+      "ERROR : You are not in a game !\n" },
+    { "MESSAGE",        cmd_message,        CMD_ARGS,   CMD_ANY,     RATE_CHAT,  NULL },
+    { "SAY",            cmd_say,            CMD_ARGS,   CMD_ANY,     RATE_CHAT,  NULL },
+    { "STATS",          cmd_stats,          0,          CMD_ANY,     RATE_LOBBY, NULL },
+    { "QUIT",           cmd_quit,           0,          CMD_ANY,     RATE_NONE,  NULL },
+};
+
+#define CMD_COUNT  ((int)(sizeof(g_commands) / sizeof(g_commands[0])))
+
+/*
+ * Hachage parfait : commands_init cherche une graine pour laquelle
+ * chaque verbe tombe seul dans sa case. Une ligne coûte alors un
+ * passage sur son verbe et une seule comparaison, quelle que soit la
+ * commande, connue ou non.
+ */
+#define CMD_SLOTS     64            /* puissance de 2, > 2 × CMD_COUNT */
+#define CMD_VERB_MAX  15
+
+static const Command *g_slots[CMD_SLOTS];
+static uint32_t       g_seed;
+
+/* FNV-1a, casse ignorée : HELP s'accepte aussi en minuscules */
+static uint32_t verb_step(uint32_t h, unsigned char c)
+{
+    if (c >= 'a' && c <= 'z')
+        c = (unsigned char)(c - 'a' + 'A');
+    return (h ^ c) * 16777619u;
+}
+
+static unsigned verb_slot(uint32_t h)
+{
+    return (h ^ (h >> 16)) & (CMD_SLOTS - 1);
+}
+
+int commands_init(void)
+{
+    for (g_seed = 2166136261u; g_seed != 0; g_seed++) {
+        memset(g_slots, 0, sizeof(g_slots));
+
+        int k;
+        for (k = 0; k < CMD_COUNT; k++) {
+            uint32_t h = g_seed;
+            for (const char *p = g_commands[k].verb; *p; p++)
+                h = verb_step(h, (unsigned char)*p);
+
+            unsigned s = verb_slot(h);
+            if (g_slots[s])
+                break;
+            g_slots[s] = &g_commands[k];
+        }
+
+        if (k == CMD_COUNT)
+            return 0;
+    }
+    return -1;
+}
+
+/* Session de c, vue par Command.states */
+static unsigned session_state(const Client *c)
+{
+    if (c->in_game)
+        return CMD_PLAYING;
+    return (c->observing >= 0) ? CMD_OBSERVING : CMD_MENU;
+}
+
+/*
+ * Commande de la ligne, NULL si aucune ; *len reçoit la longueur du
+ * verbe. Un seul passage sur le verbe : longueur et empreinte.
+ */
+static const Command *commands_find(const char *line, size_t *len)
+{
+    uint32_t h = g_seed;
+    size_t   n = 0;
+    while (line[n] && line[n] != ' ' && n <= CMD_VERB_MAX)
+        h = verb_step(h, (unsigned char)line[n++]);
+
+    *len = n;
+    if (n > CMD_VERB_MAX)
+        return NULL;
+
+    const Command *cmd = g_slots[verb_slot(h)];
+    if (!cmd)
+        return NULL;
+
+    int same = (cmd->flags & CMD_NOCASE)
+             ? strncasecmp(line, cmd->verb, n) == 0
+             : strncmp(line, cmd->verb, n) == 0;
+    int args = (line[n] == ' ');
+
+    if (!same || cmd->verb[n] != '\0' || args != !!(cmd->flags & CMD_ARGS))
+        return NULL;
+    return cmd;
+}
+
+/* Verbe inconnu (ou ligne de connexion) : compté comme le lobby */
+int commands_class(const char *line)
+{
+    if (line[0] == '\0')
+        return RATE_NONE;
+
+    size_t         len;
+    const Command *cmd = commands_find(line, &len);
+    return cmd ? cmd->rate : RATE_LOBBY;
+}
+
+void commands_execute(int i, char *line)
+{
+    if (!g_clients[i].logged_in) {
+        cmd_login(i, line);
+        return;
+    }
+
+    size_t         len;
+    const Command *cmd = commands_find(line, &len);
+
+    /* ---- UNKNOWN ---- */
+    if (!cmd) {
+        const char *msg = "ERROR : Unknown command !\n";
+        server_send(g_clients[i].fd, msg, strlen(msg));
+        return;
+    }
+
+    if (!(cmd->states & session_state(&g_clients[i]))) {
+        server_send(g_clients[i].fd, cmd->denied, strlen(cmd->denied));
+        return;
+    }
+
+    cmd->run(i, line + len + (cmd->flags & CMD_ARGS ? 1 : 0));
+}
@@ -0,0 +1,217 @@
+/*************************************************************************
+                           Awale -- Game (Server Config)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Configuration du serveur : valeurs par défaut
+                           et lecture d'un fichier « clé = valeur »
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+#include "server.h"
+
+/* =====================================================
+ *                  Valeurs par défaut
+ * ===================================================== */
+void config_defaults(ServerConfig *cfg)
+{
+    cfg->port         = DEFAULT_PORT;
+    cfg->backend      = LOOP_EPOLL;
+    cfg->threads      = 1;
+    cfg->clients      = DEFAULT_CLIENTS;
+    cfg->max_clients  = DEFAULT_MAX_CLIENTS;
+    cfg->games        = DEFAULT_GAMES;
+    cfg->max_games    = 0;      /* 0 = max_clients / 2 */
+    cfg->accounts     = DEFAULT_ACCOUNTS;
+    cfg->max_accounts = DEFAULT_MAX_ACCOUNTS;
+    cfg->out_max      = DEFAULT_OUTPUT_MAX;
+    cfg->login_timeout = DEFAULT_LOGIN_TIMEOUT;
+    cfg->idle_timeout  = DEFAULT_IDLE_TIMEOUT;
+    cfg->ready_timeout = DEFAULT_READY_TIMEOUT;
+    cfg->game_timeout  = DEFAULT_GAME_TIMEOUT;
+    cfg->rate_chat     = DEFAULT_RATE_CHAT;
+    cfg->rate_lobby    = DEFAULT_RATE_LOBBY;
+    cfg->rate_game     = DEFAULT_RATE_GAME;
+    cfg->bot_threads   = DEFAULT_BOT_THREADS;
+}
+
+/* =====================================================
+ *                  Fichier de configuration
+ * ===================================================== */
+
+/* Enlève les blancs en tête et en fin */
+static char *trim(char *s)
+{
+    while (isspace((unsigned char)*s))
+        s++;
+
+    char *end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1]))
+        *--end = '\0';
+
+    return s;
+}
+
+/* Clés entières reconnues */
+static int *config_field(ServerConfig *cfg, const char *key)
+{
+    if (strcasecmp(key, "port") == 0)         return &cfg->port;
+    if (strcasecmp(key, "threads") == 0)      return &cfg->threads;
+    if (strcasecmp(key, "clients") == 0)      return &cfg->clients;
+    if (strcasecmp(key, "max_clients") == 0)  return &cfg->max_clients;
+    if (strcasecmp(key, "games") == 0)        return &cfg->games;
+    if (strcasecmp(key, "max_games") == 0)    return &cfg->max_games;
+    if (strcasecmp(key, "accounts") == 0)     return &cfg->accounts;
+    if (strcasecmp(key, "max_accounts") == 0) return &cfg->max_accounts;
+    if (strcasecmp(key, "out_max") == 0)      return &cfg->out_max;
+    if (strcasecmp(key, "login_timeout") == 0) return &cfg->login_timeout;
+    if (strcasecmp(key, "idle_timeout") == 0)  return &cfg->idle_timeout;
+    if (strcasecmp(key, "ready_timeout") == 0) return &cfg->ready_timeout;
+    if (strcasecmp(key, "game_timeout") == 0)  return &cfg->game_timeout;
+    if (strcasecmp(key, "rate_chat") == 0)     return &cfg->rate_chat;
+    if (strcasecmp(key, "rate_lobby") == 0)    return &cfg->rate_lobby;
+    if (strcasecmp(key, "rate_game") == 0)     return &cfg->rate_game;
+    if (strcasecmp(key, "bot_threads") == 0)   return &cfg->bot_threads;
+    return NULL;
+}
+
+int config_load(ServerConfig *cfg, const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+
+    char line[256];
+    int  lineno = 0;
+    int  rc     = 0;
+
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+
+        char *hash = strchr(line, '#');
+        if (hash)
+            *hash = '\0';
+
+        char *key = trim(line);
+        if (!*key)
+            continue;
+
+        char *eq = strchr(key, '=');
+        if (!eq) {
+            fprintf(stderr, "%s:%d: expected key = value\n", path, lineno);
+            rc = -1;
+            continue;
+        }
+        *eq = '\0';
+
+        char *value = trim(eq + 1);
+        key = trim(key);
+
+        if (strcasecmp(key, "backend") == 0) {
+            if (strcasecmp(value, "epoll") == 0)
+                cfg->backend = LOOP_EPOLL;
+            else if (strcasecmp(value, "select") == 0)
+                cfg->backend = LOOP_SELECT;
+            else if (strcasecmp(value, "uring") == 0)
+                cfg->backend = LOOP_URING;
+            else {
+                fprintf(stderr, "%s:%d: unknown backend %s\n", path, lineno, value);
+                rc = -1;
+            }
+            continue;
+        }
+
+        int *field = config_field(cfg, key);
+        char *end;
+        long v = strtol(value, &end, 10);
+
+        if (!field) {
+            fprintf(stderr, "%s:%d: unknown key %s\n", path, lineno, key);
+            rc = -1;
+        } else if (end == value || *end || v < 0 || v > TABLE_LIMIT) {
+            fprintf(stderr, "%s:%d: invalid value for %s\n", path, lineno, key);
+            rc = -1;
+        } else {
+            *field = (int)v;
+        }
+    }
+
+    fclose(f);
+    return rc;
+}
+
+/* =====================================================
+ *                      Cohérence
+ * ===================================================== */
+int config_check(ServerConfig *cfg)
+{
+    if (cfg->port <= 0 || cfg->port > 65535) {
+        fprintf(stderr, "ERROR : Invalid port number. Must be between 1 and 65535.\n");
+        return -1;
+    }
+
+    if (cfg->threads < 1 || cfg->threads > REACTOR_MAX) {
+        fprintf(stderr, "ERROR : Thread count must be between 1 and %d.\n", REACTOR_MAX);
+        return -1;
+    }
+
+    /* select() ne sert qu'aux mesures comparatives, sur un seul thread */
+    if (cfg->backend == LOOP_SELECT && cfg->threads > 1) {
+        fprintf(stderr, "ERROR : The select backend runs on a single thread.\n");
+        return -1;
+    }
+
+    if (cfg->max_games == 0)
+        cfg->max_games = cfg->max_clients / 2;
+
+    if (cfg->max_clients < 2 || cfg->max_clients > TABLE_LIMIT ||
+        cfg->max_games < 1 || cfg->max_games > TABLE_LIMIT ||
+        cfg->max_accounts < 1 || cfg->max_accounts > TABLE_LIMIT) {
+        fprintf(stderr, "ERROR : Table limits must be between 1 and %d.\n", TABLE_LIMIT);
+        return -1;
+    }
+
+    /* Sous la moitié du plafond, la file doit encore accepter une réponse complète */
+    if (cfg->out_max < 4 * BUF_SIZE) {
+        fprintf(stderr, "ERROR : Output limit must be at least %d bytes.\n", 4 * BUF_SIZE);
+        return -1;
+    }
+
+    if (cfg->login_timeout > TIMEOUT_MAX || cfg->idle_timeout > TIMEOUT_MAX ||
+        cfg->ready_timeout > TIMEOUT_MAX || cfg->game_timeout > TIMEOUT_MAX) {
+        fprintf(stderr, "ERROR : Timeouts must be at most %d seconds.\n", TIMEOUT_MAX);
+        return -1;
+    }
+
+    if (cfg->rate_chat < 0 || cfg->rate_chat > RATE_MAX ||
+        cfg->rate_lobby < 0 || cfg->rate_lobby > RATE_MAX ||
+        cfg->rate_game < 0 || cfg->rate_game > RATE_MAX) {
+        fprintf(stderr, "ERROR : Rates must be between 0 and %d commands per second.\n", RATE_MAX);
+        return -1;
+    }
+
+    if (cfg->bot_threads < 1 || cfg->bot_threads > BOT_THREADS_MAX) {
+        fprintf(stderr, "ERROR : Bot threads must be between 1 and %d.\n", BOT_THREADS_MAX);
+        return -1;
+    }
+
+    /* Une taille initiale au-delà du plafond est ramenée au plafond */
+    if (cfg->clients > cfg->max_clients)   cfg->clients  = cfg->max_clients;
+    if (cfg->games > cfg->max_games)       cfg->games    = cfg->max_games;
+    if (cfg->accounts > cfg->max_accounts) cfg->accounts = cfg->max_accounts;
+    if (cfg->clients < 1)                  cfg->clients  = 1;
+    if (cfg->games < 1)                    cfg->games    = 1;
+    if (cfg->accounts < 1)                 cfg->accounts = 1;
+
+    return 0;
+}
@@ -6,6 +6,9 @@
     e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
     description          : Gérer une session du jeu :
                            start, moves, observers, cancellation.
+                           Le hub attribue les parties, chacune est jouée
+                           par son exécuteur à partir des événements de
+                           sa boîte aux lettres.
 *************************************************************************/
 
 #define _GNU_SOURCE
@@ -13,152 +16,608 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <strings.h>     
+#include <strings.h>
 #include <time.h>
 #include <unistd.h>
 #include <sys/socket.h>
 
 #include "server.h"
 
+/*
+ * Avec plusieurs réacteurs, les parties sont réparties sur tous sauf le
+ * hub, déjà chargé des sessions ; avec un seul, le hub les joue.
+ */
+int games_executor(int g)
+{
+    int n = reactor_count();
+    return (n > 1) ? 1 + g % (n - 1) : REACTOR_HUB;
+}
+
 /* =====================================================
- *          Envoyer l’état du plateau 
+ *                 Côté hub : sessions
  * ===================================================== */
-void games_send_board(Game *g)
+
+/* Événement d'un client pour sa partie, rempli par le hub */
+static void games_event(GameEvent *ev, int type, int ci, int g)
 {
-    char msg[256];
-    snprintf(msg, sizeof(msg),
-             "BOARD %d %d %d %d %d %d %d %d %d %d %d %d | Scores: %d-%d | Next: %d\n",
-             g->board[0], g->board[1], g->board[2], g->board[3],
-             g->board[4], g->board[5], g->board[6], g->board[7],
-             g->board[8], g->board[9], g->board[10], g->board[11],
-             g->p0.score, g->p1.score, g->to_move);
+    memset(ev, 0, sizeof(*ev));
+    ev->type = type;
+    ev->game = g;
+    ev->gen  = g_games[g].gen;
+    ev->who  = reactor_ref(&g_clients[ci]);
+}
 
-    size_t len = strlen(msg);
+/* =====================================================
+ *              Chercher jeu par joueur
+ * ===================================================== */
+int games_find_by_player_name(const char *name)
+{
+    /* Un joueur est toujours connecté : son client porte la partie */
+    int ci = client_index_by_name(name);
+    if (ci < 0 || !g_clients[ci].in_game)
+        return -1;
 
-    if (g->player_fd0 > 0)
-        send(g->player_fd0, msg, len, 0);
+    return g_clients[ci].game_index;
+}
 
-    if (g->player_fd1 > 0)
-        send(g->player_fd1, msg, len, 0);
+/*
+ * Détache un joueur de sa partie (retour au menu). Ses coups allaient
+ * directement à l'exécuteur : son inactivité compte à partir d'ici.
+ */
+static void games_unbind(int ci)
+{
+    if (ci < 0)
+        return;
 
-    for (int z = 0; z < g->observer_count; z++) {
-        int fd = g->observers[z];
-        if (fd > 0)
-            send(fd, msg, len, 0);
-    }
+    g_clients[ci].session_seen   = timers_now();
+    g_clients[ci].in_game        = 0;
+    g_clients[ci].opponent_index = -1;
+    g_clients[ci].game_index     = -1;
 }
 
 /* =====================================================
- *              Chercher jeu par joueur
+ *                    Lancer une partie
  * ===================================================== */
-int games_find_by_player_name(const char *name)
+int games_start(int client_a, int client_b, unsigned base_ms, unsigned inc_ms)
 {
-    if (!name || !*name)
+    int g_idx = game_alloc();
+    if (g_idx < 0)
         return -1;
 
-    for (int k = 0; k < MAX_GAMES; k++) {
+    Game *g = &g_games[g_idx];
 
-        if (!g_games[k].active)
-            continue;
+    /* En-tête du hub ; le reste est préparé par l'exécuteur */
+    g->active = 1;
+    g->gen++;
+    g->players[0] = client_a;
+    g->players[1] = client_b;
 
-        if (strcasecmp(g_games[k].p0.name, name) == 0 ||
-            strcasecmp(g_games[k].p1.name, name) == 0)
-        {
-            return k;
-        }
+    /* Définir un username */
+    copy_bounded(g->p0.name, sizeof(g->p0.name), g_clients[client_a].name);
+    copy_bounded(g->p1.name, sizeof(g->p1.name), g_clients[client_b].name);
+
+    g->p0.number = 0;
+    g->p1.number = 1;
+
+    /* Bind des clients*/
+    g_clients[client_a].in_game        = 1;
+    g_clients[client_b].in_game        = 1;
+    g_clients[client_a].opponent_index = client_b;
+    g_clients[client_b].opponent_index = client_a;
+    g_clients[client_a].player_index   = 0;
+    g_clients[client_b].player_index   = 1;
+    g_clients[client_a].game_index     = g_idx;
+    g_clients[client_b].game_index     = g_idx;
+
+    GameEvent ev;
+    games_event(&ev, GAME_EV_START, client_a, g_idx);
+    ev.other = reactor_ref(&g_clients[client_b]);
+    ev.arg   = rand() % 2;
+    ev.clock_base = base_ms;
+    ev.clock_inc  = inc_ms;
+    copy_bounded(ev.names[0], sizeof(ev.names[0]), g->p0.name);
+    copy_bounded(ev.names[1], sizeof(ev.names[1]), g->p1.name);
+
+    reactor_post(games_executor(g_idx), &ev);
+    return g_idx;
+}
+
+/* =====================================================
+ *               READY et MOVE (hub)
+ * ===================================================== */
+
+/*
+ * Un joueur déjà lié chez son réacteur n'arrive pas ici (games_route) :
+ * seules les commandes envoyées avant la liaison passent par le hub.
+ */
+void games_ready(int client_index)
+{
+    if (!g_clients[client_index].in_game) {
+        server_send(g_clients[client_index].fd, "ERROR : Not in game !\n", 22);
+        return;
     }
 
-    return -1;
+    int g_idx = g_clients[client_index].game_index;
+
+    GameEvent ev;
+    games_event(&ev, GAME_EV_READY, client_index, g_idx);
+    reactor_post(games_executor(g_idx), &ev);
+}
+
+void games_process_move(int client_index, int pit)
+{
+    if (!g_clients[client_index].in_game) {
+        server_send(g_clients[client_index].fd, "ERROR : Not in game\n", 21);
+        return;
+    }
+
+    int g_idx = g_clients[client_index].game_index;
+
+    if (g_idx < 0) {
+        server_send(g_clients[client_index].fd, "ERROR : Internal game not found\n", 30);
+        return;
+    }
+
+    GameEvent ev;
+    games_event(&ev, GAME_EV_MOVE, client_index, g_idx);
+    ev.arg = pit;
+    reactor_post(games_executor(g_idx), &ev);
 }
 
 /* =====================================================
- *                Fin du jeu et broadcast
+ *                  Mode observateur
  * ===================================================== */
-static void games_end(Game *g)
+void games_observe(int client_index, int g)
 {
-    char endmsg[128];
+    /* Une seule partie observée à la fois */
+    games_remove_observer(client_index);
 
-    snprintf(endmsg, sizeof(endmsg),
-             "GAME_END %d %d\n", g->p0.score, g->p1.score);
+    g_clients[client_index].observing = g;
 
-    size_t len = strlen(endmsg);
+    GameEvent ev;
+    games_event(&ev, GAME_EV_OBSERVE, client_index, g);
+    reactor_post(games_executor(g), &ev);
+}
 
-    if (g->player_fd0 > 0)
-        send(g->player_fd0, endmsg, len, 0);
+void games_remove_observer(int client_index)
+{
+    int g = g_clients[client_index].observing;
+    if (g < 0)
+        return;
 
-    if (g->player_fd1 > 0)
-        send(g->player_fd1, endmsg, len, 0);
+    g_clients[client_index].observing = -1;
 
-    for (int z = 0; z < g->observer_count; z++) {
-        int fd = g->observers[z];
-        if (fd > 0)
-            send(fd, endmsg, len, 0);
+    /* Sans effet si la partie est finie : l'exécuteur ne le trouvera pas */
+    GameEvent ev;
+    games_event(&ev, GAME_EV_UNOBSERVE, client_index, g);
+    reactor_post(games_executor(g), &ev);
+}
+
+/* =====================================================
+ *                   Annuler une partie
+ * ===================================================== */
+void games_cancel_by_client(int client_index, int notify)
+{
+    if (!g_clients[client_index].in_game)
+        return;
+
+    int g_idx = g_clients[client_index].game_index;
+
+    if (g_idx < 0)
+        return;
+
+    GameEvent ev;
+    games_event(&ev, GAME_EV_CANCEL, client_index, g_idx);
+    ev.arg = notify;
+    copy_bounded(ev.names[0], sizeof(ev.names[0]), g_clients[client_index].name);
+
+    int opp = g_clients[client_index].opponent_index;
+
+    /* La partie est libérée : l'adversaire ne doit plus y pointer */
+    if (opp >= 0 && g_clients[opp].game_index == g_idx) {
+        games_unbind(opp);
     }
 
-    /* Append to game log */
-    FILE *f = fopen(g->filename, "a");
-    if (f) {
-        fprintf(f, "GAME_END %s: %d   %s: %d\n",
-                g->p0.name, g->p0.score,
-                g->p1.name, g->p1.score);
-        fclose(f);
+    games_unbind(client_index);
+    game_release(g_idx);
+
+    /* Notifications et log par l'exécuteur */
+    reactor_post(games_executor(g_idx), &ev);
+}
+
+/* Plateau complet redemandé par un joueur ou un observateur */
+void games_board(int client_index)
+{
+    Client *c = &g_clients[client_index];
+    int     g = c->in_game ? c->game_index : c->observing;
+
+    if (g < 0) {
+        server_send(c->fd, "ERROR : Not in game !\n", 22);
+        return;
     }
 
-    g->active = 0;
+    GameEvent ev;
+    games_event(&ev, GAME_EV_BOARD, client_index, g);
+    reactor_post(games_executor(g), &ev);
+}
+
+/* Fin de partie signalée par l'exécuteur : les joueurs retournent au menu */
+void games_over(int g, unsigned gen)
+{
+    if (!g_games[g].active || g_games[g].gen != gen)
+        return;
+
+    for (int k = 0; k < 2; k++) {
+        int ci = g_games[g].players[k];
+        if (g_clients[ci].in_game && g_clients[ci].game_index == g)
+            games_unbind(ci);
+    }
+
+    game_release(g);
 }
 
 /* =====================================================
- *                    Lancer une partie
+ *            Côté réacteur : joueurs liés
  * ===================================================== */
-int games_start(int client_a, int client_b)
+int games_route(Client *c, const char *line)
 {
-    int g_idx = -1;
+    if (c->play_game < 0)
+        return 0;
 
-    for (int i = 0; i < MAX_GAMES; i++) {
-        if (!g_games[i].active) {
-            g_idx = i;
-            break;
-        }
+    GameEvent ev;
+    memset(&ev, 0, sizeof(ev));
+
+    if (strcmp(line, "READY") == 0) {
+        ev.type = GAME_EV_READY;
+    } else if (strncmp(line, "MOVE ", 5) == 0 &&
+               sscanf(line + 5, "%d", &ev.arg) == 1) {
+        ev.type = GAME_EV_MOVE;
+    } else {
+        return 0;
     }
-    if (g_idx < 0)
-        return -1;
 
-    Game *g = &g_games[g_idx];
-    memset(g, 0, sizeof(*g));
+    ev.game = c->play_game;
+    ev.gen  = c->play_gen;
+    ev.who.c      = c;
+    ev.who.serial = atomic_load_explicit(&c->serial, memory_order_relaxed);
+    ev.who.home   = c->reactor;
+
+    /* Une ligne jouée par un autre thread compte parmi les lignes en route */
+    int to = games_executor(ev.game);
+    if (to != reactor_self()) {
+        ev.ack = 1;
+        c->in_flight++;
+    }
+
+    reactor_post(to, &ev);
+    return 1;
+}
 
-    g->active         = 1;
+/* =====================================================
+ *          Côté exécuteur : jouer la partie
+ * ===================================================== */
+
+static void exec_send(ClientRef to, const char *msg, size_t len)
+{
+    reactor_send(to, msg, len, 0);
+}
+
+static int ref_equal(ClientRef a, ClientRef b)
+{
+    return a.c == b.c && a.serial == b.serial;
+}
+
+/* Joueur de la référence (0 ou 1), -1 s'il ne joue pas cette partie */
+static int exec_seat(const Game *g, ClientRef who)
+{
+    for (int k = 0; k < 2; k++)
+        if (ref_equal(g->player[k], who))
+            return k;
+    return -1;
+}
+
+/* Partie visée par ev si elle est toujours en cours, NULL sinon */
+static Game *exec_game(const GameEvent *ev)
+{
+    Game *g = &g_games[ev->game];
+    if (g->run_gen != ev->gen || g->over)
+        return NULL;
+    return g;
+}
+
+/* =====================================================
+ *          Envoyer l’état du plateau
+ * ===================================================== */
+
+/*
+ * Plateau à envoyer, sous quatre formes encodées à la demande (au plus
+ * une fois chacune) : complet ou différentiel, en texte ou en trame.
+ * Chaque forme est un tampon partagé par toutes les files qui la
+ * reçoivent.
+ *  delta : BOARD_DELTA permis (un plateau précédent a été envoyé)
+ *  mask  : cases et scores changés depuis ce plateau (et pendules,
+ *          toujours renvoyées)
+ *  clocks: temps restant (ms) d'une partie à la pendule
+ *  buf   : [BOARD_FULL/BOARD_DELTA][PROTO_TEXT/PROTO_BIN], NULL si pas
+ *          encore encodée
+ */
+enum { BOARD_FULL, BOARD_DELTA };
+
+typedef struct {
+    const Game *g;
+    int         pits[12];
+    int         scores[2];
+    int         delta;
+    unsigned    mask;
+    uint32_t    clocks[2];
+    OutBuf     *buf[2][2];
+} BoardMsg;
+
+static int64_t clock_left(const Game *g, int seat);
+
+static void board_prepare(BoardMsg *m, const Game *g)
+{
+    m->g = g;
+    for (int k = 0; k < 12; k++)
+        m->pits[k] = pbPit(&g->board, k);
+    m->scores[0] = g->board.score[0];
+    m->scores[1] = g->board.score[1];
+
+    for (int k = 0; g->timed && k < 2; k++)
+        m->clocks[k] = (uint32_t)(clock_left(g, k) / 1000000);
+
+    m->delta = 0;
+    m->mask  = 0;
+    memset(m->buf, 0, sizeof(m->buf));
+}
+
+/* Forme form du plateau, encodée dans un tampon partagé */
+static OutBuf *board_encode(const BoardMsg *m, int form, int bin)
+{
+    const Game     *g      = m->g;
+    const uint32_t *clocks = g->timed ? m->clocks : NULL;
+
+    if (bin) {
+        uint8_t frame[PROTO_DELTA_MAX_FRAME];
+        size_t  len = (form == BOARD_DELTA)
+            ? proto_board_delta(frame, g->seq, g->to_move, m->mask,
+                                m->pits, m->scores[0], m->scores[1], clocks)
+            : proto_board(frame, m->pits, m->scores[0],
+                          m->scores[1], g->to_move, g->seq, clocks);
+        return outbuf_new((const char *)frame, len);
+    }
+
+    char   text[PROTO_BOARD_LINE];
+    size_t len = (form == BOARD_DELTA)
+        ? proto_delta_line(text, g->seq, g->to_move, m->mask,
+                           m->pits, m->scores[0], m->scores[1], clocks)
+        : proto_board_line(text, m->pits, m->scores[0],
+                           m->scores[1], g->to_move, g->seq, clocks);
+    return outbuf_new(text, len);
+}
+
+static void board_send(BoardMsg *m, ClientRef to, int flags)
+{
+    int form = (m->delta && reactor_deltas(to)) ? BOARD_DELTA : BOARD_FULL;
+    int bin  = reactor_binary(to) ? PROTO_BIN : PROTO_TEXT;
+
+    if (!m->buf[form][bin] && (m->buf[form][bin] = board_encode(m, form, bin)) == NULL)
+        return;
+
+    reactor_send_buf(to, m->buf[form][bin], flags | (bin == PROTO_BIN ? SEND_FRAME : 0));
+}
+
+/* Les files gardent leurs références : celles du plateau sont rendues */
+static void board_done(BoardMsg *m)
+{
+    for (int form = 0; form < 2; form++)
+        for (int bin = 0; bin < 2; bin++)
+            outbuf_release(m->buf[form][bin]);
+}
+
+/*
+ * Nouveau plateau pour les joueurs et les observateurs : différentiel
+ * pour qui l'a négocié, à partir du deuxième plateau de la partie.
+ */
+static void games_send_board(Game *g)
+{
+    BoardMsg m;
+    board_prepare(&m, g);
+
+    if (g->seq > 0) {
+        m.delta = 1;
+        m.mask  = proto_delta_mask(g->sent_pits, g->sent_scores, m.pits, m.scores);
+        if (g->timed)
+            m.mask |= PROTO_DELTA_CLOCKS;
+    }
+
+    g->seq++;
+    memcpy(g->sent_pits, m.pits, sizeof(g->sent_pits));
+    memcpy(g->sent_scores, m.scores, sizeof(g->sent_scores));
+
+    board_send(&m, g->player[0], 0);
+    board_send(&m, g->player[1], 0);
+
+    /*
+     * Un plateau peut être sauté pour un observateur lent : complet, il
+     * reste un état valable ; différentiel, le client voit le trou dans
+     * les numéros et redemande le plateau complet.
+     */
+    for (int z = 0; z < g->observer_count; z++)
+        board_send(&m, g->observers[z], SEND_LOSSY);
+
+    board_done(&m);
+}
+
+/* Plateau complet pour une seule connexion (arrivée, plateau manqué) */
+static void games_send_snapshot(const Game *g, ClientRef to)
+{
+    BoardMsg m;
+    board_prepare(&m, g);
+    board_send(&m, to, 0);
+    board_done(&m);
+}
+
+/* Fin de partie côté exécuteur : les réacteurs et le hub délient les joueurs */
+static void exec_close(Game *g)
+{
+    for (int k = 0; k < 2; k++)
+        reactor_bind(g->player[k], (int)(g - g_games), g->run_gen, 0);
+
+    timer_cancel(&g->timer);
+    g->over           = 1;
     g->observer_count = 0;
+}
 
-    initGame(g->board);
-    resetScores(&g->p0, &g->p1);
+/* =====================================================
+ *                       Pendule
+ * ===================================================== */
 
-    /* Définir un username */
-    copy_bounded(g->p0.name, sizeof(g->p0.name), g_clients[client_a].name);
-    copy_bounded(g->p1.name, sizeof(g->p1.name), g_clients[client_b].name);
+/*
+ * Temps restant de seat (ns) à l'heure du tour de boucle : la pendule
+ * du joueur au trait tourne depuis clock_since une fois les deux READY
+ * reçus. Aucune lecture d'horloge : timers_now_ns suffit.
+ */
+static int64_t clock_left(const Game *g, int seat)
+{
+    int64_t left = g->clock_left[seat];
 
-    g->p0.number = 0;
-    g->p1.number = 1;
+    if (seat == g->to_move && g->ready[0] && g->ready[1])
+        left -= (int64_t)(timers_now_ns() - g->clock_since);
+    return (left > 0) ? left : 0;
+}
 
-    g->to_move   = rand() % 2;
+/* Chute du drapeau du joueur au trait (ms, arrondie au-dessus) */
+static uint64_t clock_deadline(const Game *g)
+{
+    uint64_t end = g->clock_since + (uint64_t)g->clock_left[g->to_move];
+    return (end + 999999u) / 1000000u;
+}
 
-    g->player_fd0 = g_clients[client_a].fd;
-    g->player_fd1 = g_clients[client_b].fd;
+/* =====================================================
+ *                 Délais de la partie
+ * ===================================================== */
 
-    /* Bind des clients*/
-    g_clients[client_a].in_game        = 1;
-    g_clients[client_b].in_game        = 1;
-    g_clients[client_a].opponent_index = client_b;
-    g_clients[client_b].opponent_index = client_a;
-    g_clients[client_a].player_index   = 0;
-    g_clients[client_b].player_index   = 1;
-    g_clients[client_a].ready          = 0;
-    g_clients[client_b].ready          = 0;
+/*
+ * Échéance de la partie (ms), 0 si aucune : READY des deux joueurs
+ * depuis le début, puis un coup depuis le précédent, ou plus tôt la
+ * chute du drapeau d'une partie à la pendule.
+ */
+static uint64_t exec_deadline(const Game *g)
+{
+    int      playing = g->ready[0] && g->ready[1];
+    unsigned ms      = timeout_ms(playing ? TIMEOUT_GAME : TIMEOUT_READY);
+    uint64_t when    = ms ? g->last_move + ms : 0;
+
+    if (g->timed && playing) {
+        uint64_t flag = clock_deadline(g);
+        if (!when || flag < when)
+            when = flag;
+    }
+    return when;
+}
+
+static void exec_expired(Timer *t);
+static void games_end(Game *g, int flag);
+
+static void exec_arm(Game *g)
+{
+    uint64_t when = exec_deadline(g);
+
+    if (when)
+        timer_arm(&g->timer, when, exec_expired);
+    else
+        timer_cancel(&g->timer);
+}
+
+/*
+ * Partie abandonnée : annulée au nom du joueur attendu (READY manquant,
+ * ou trait sans coup), et son slot rendu par le hub comme en fin de
+ * partie.
+ */
+static void exec_abandon(Game *g, int seat)
+{
+    char msg[64];
+    snprintf(msg, sizeof(msg), "GAME_CANCELED %s timeout\n", g->names[seat]);
+
+    Fanout out;
+    fanout_init(&out, msg, strlen(msg), NULL, 0);
+    fanout_send(&out, g->player[0], 0);
+    fanout_send(&out, g->player[1], 0);
+
+    for (int z = 0; z < g->observer_count; z++)
+        fanout_send(&out, g->observers[z], 0);
+
+    fanout_done(&out);
+
+    FILE *f = fopen(g->filename, "a");
+    if (f) {
+        fprintf(f, "GAME_CANCELED by %s (timeout)\n", g->names[seat]);
+        fclose(f);
+    }
+
+    exec_close(g);
+    reactor_game_over((int)(g - g_games), g->run_gen);
+}
+
+/*
+ * Les coups ne touchent que last_move : le minuteur n'est déplacé qu'à
+ * son échéance, si un coup a été joué depuis. Seule la pendule peut
+ * avancer l'échéance, et exec_move le réarme alors.
+ */
+static void exec_expired(Timer *t)
+{
+    Game *g = timer_owner(t, Game, timer);
+
+    if (g->over)
+        return;
+
+    /* Drapeau tombé : la partie se termine, perdue au temps */
+    if (g->timed && g->ready[0] && g->ready[1] && clock_left(g, g->to_move) == 0) {
+        games_end(g, g->to_move);
+        return;
+    }
+
+    if (exec_deadline(g) > timers_now()) {
+        exec_arm(g);
+        return;
+    }
+
+    int seat = (g->ready[0] && g->ready[1]) ? g->to_move : (g->ready[0] ? 1 : 0);
+    exec_abandon(g, seat);
+}
+
+static void exec_start(const GameEvent *ev)
+{
+    Game *g = &g_games[ev->game];
+
+    g->run_gen        = ev->gen;
+    g->over           = 0;
+    g->to_move        = ev->arg;
+    g->ready[0]       = 0;
+    g->ready[1]       = 0;
+    g->player[0]      = ev->who;
+    g->player[1]      = ev->other;
+    g->observer_count = 0;
+    g->seq            = 0;
+    g->last_move      = timers_now();
+    g->timed          = ev->clock_base > 0;
+    g->clock_left[0]  = (int64_t)ev->clock_base * 1000000;
+    g->clock_left[1]  = g->clock_left[0];
+    g->clock_inc      = (uint64_t)ev->clock_inc * 1000000u;
+    g->clock_since    = 0;
+    copy_bounded(g->names[0], sizeof(g->names[0]), ev->names[0]);
+    copy_bounded(g->names[1], sizeof(g->names[1]), ev->names[1]);
+
+    pbInitGame(&g->board);
+    exec_arm(g);
 
     /* Créer un file log du jeu */
     time_t t = time(NULL);
+    struct tm tm;
     char ts[32];
-    size_t ts_len = strftime(ts, sizeof(ts), "%Y-%m-%d_%H-%M-%S", localtime(&t));
-    
+    size_t ts_len = strftime(ts, sizeof(ts), "%Y-%m-%d_%H-%M-%S", localtime_r(&t, &tm));
+
     if (ts_len == 0) {
         snprintf(ts, sizeof(ts), "game_%ld", (long)t);
     }
@@ -166,108 +625,225 @@ int games_start(int client_a, int client_b)
     char tmp[160];
     snprintf(tmp, sizeof(tmp),
              "saved_games/%s_vs_%s_%s.txt",
-             g->p0.name, g->p1.name, ts);
+             g->names[0], g->names[1], ts);
     copy_bounded(g->filename, sizeof(g->filename), tmp);
 
     FILE *f = fopen(g->filename, "w");
     if (f) {
-        fprintf(f, "GAME_START %s vs %s\n", g->p0.name, g->p1.name);
+        fprintf(f, "GAME_START %s vs %s\n", g->names[0], g->names[1]);
         fclose(f);
     }
 
+    /* Liés avant GAME_START : leurs coups viennent ensuite directement ici */
+    for (int k = 0; k < 2; k++)
+        reactor_bind(g->player[k], ev->game, ev->gen, 1);
+
     /* Notifier les joueurs */
     char msg[128];
     snprintf(msg, sizeof(msg),
-             "GAME_START %s vs %s\n", g->p0.name, g->p1.name);
+             "GAME_START %s vs %s\n", g->names[0], g->names[1]);
 
-    send(g->player_fd0, msg, strlen(msg), 0);
-    send(g->player_fd1, msg, strlen(msg), 0);
+    uint8_t frame[PROTO_GAME_START_FRAME];
+    proto_game_start(frame, g->names[0], g->names[1]);
 
-    return g_idx;
+    Fanout out;
+    fanout_init(&out, msg, strlen(msg), frame, sizeof(frame));
+    fanout_send(&out, g->player[0], 0);
+    fanout_send(&out, g->player[1], 0);
+    fanout_done(&out);
+}
+
+static void exec_ready(const GameEvent *ev)
+{
+    Game *g    = exec_game(ev);
+    int   seat = g ? exec_seat(g, ev->who) : -1;
+
+    if (seat < 0) {
+        exec_send(ev->who, "ERROR : Not in game !\n", 22);
+        return;
+    }
+
+    int was_ready = g->ready[seat];
+    g->ready[seat] = 1;
+
+    if (!g->ready[seat ^ 1])
+        return;
+
+    /* Les deux joueurs sont prêts : le délai par coup et la pendule commencent */
+    if (!was_ready) {
+        g->last_move   = timers_now();
+        g->clock_since = timers_now_ns();
+        exec_arm(g);
+    }
+    games_send_board(g);
+}
+
+/* =====================================================
+ *                Fin du jeu et broadcast
+ * ===================================================== */
+
+/* Fin de partie : plateau terminé, ou flag (0 ou 1) tombé au temps, -1 sinon */
+static void games_end(Game *g, int flag)
+{
+    char endmsg[128];
+
+    if (flag >= 0)
+        snprintf(endmsg, sizeof(endmsg), "GAME_END %d %d %s flag\n",
+                 g->board.score[0], g->board.score[1], g->names[flag]);
+    else
+        snprintf(endmsg, sizeof(endmsg),
+                 "GAME_END %d %d\n", g->board.score[0], g->board.score[1]);
+
+    size_t len = strlen(endmsg);
+
+    uint8_t frame[PROTO_GAME_END_MAX_FRAME];
+    size_t  frame_len = proto_game_end(frame, g->board.score[0],
+                                       g->board.score[1], flag);
+
+    /* Écrit une fois par forme, partagé par les joueurs et les observateurs */
+    Fanout out;
+    fanout_init(&out, endmsg, len, frame, frame_len);
+    fanout_send(&out, g->player[0], 0);
+    fanout_send(&out, g->player[1], 0);
+
+    for (int z = 0; z < g->observer_count; z++)
+        fanout_send(&out, g->observers[z], 0);
+
+    fanout_done(&out);
+
+    /* Append to game log */
+    FILE *f = fopen(g->filename, "a");
+    if (f) {
+        fprintf(f, "GAME_END %s: %d   %s: %d%s%s\n",
+                g->names[0], g->board.score[0],
+                g->names[1], g->board.score[1],
+                (flag >= 0) ? "   flag: " : "", (flag >= 0) ? g->names[flag] : "");
+        fclose(f);
+    }
+
+    /* Les joueurs retournent au menu */
+    exec_close(g);
+    reactor_game_over((int)(g - g_games), g->run_gen);
 }
 
 /* =====================================================
  *                     Jouer un coup
  * ===================================================== */
-void games_process_move(int client_index, int pit)
+static void exec_move(const GameEvent *ev)
 {
-    if (!g_clients[client_index].in_game) {
-        send(g_clients[client_index].fd, "ERROR : Not in game\n", 21, 0);
+    Game *g    = exec_game(ev);
+    int   seat = g ? exec_seat(g, ev->who) : -1;
+
+    if (seat < 0) {
+        exec_send(ev->who, "ERROR : Not in game\n", 21);
         return;
     }
 
-    int g_idx = games_find_by_player_name(g_clients[client_index].name);
+    /* Non respect du tour */
+    if (seat != g->to_move) {
+        exec_send(ev->who, "ERROR : Not your turn\n", 23);
+        return;
+    }
 
-    if (g_idx < 0) {
-        send(g_clients[client_index].fd, "ERROR : Internal game not found\n", 30, 0);
+    /* Pendule arrêtée jusqu'aux deux READY : pas de coup avant */
+    if (g->timed && !(g->ready[0] && g->ready[1])) {
+        const char *msg = "ERROR : Waiting for both players to be READY\n";
+        exec_send(ev->who, msg, strlen(msg));
         return;
     }
 
-    Game *g = &g_games[g_idx];
+    /* Temps du coup décompté ; arrivé après la chute du drapeau, avant le minuteur */
+    int64_t left = g->timed ? clock_left(g, seat) : 0;
 
-    /* Non respect du tour */
-    if (g_clients[client_index].player_index != g->to_move) {
-        send(g_clients[client_index].fd, "ERROR : Not your turn\n", 23, 0);
+    if (g->timed && left == 0) {
+        games_end(g, seat);
         return;
     }
 
     /* Jouer un coup */
-    int rc = playMove(g->board,
-                      g_clients[client_index].player_index,
-                      &g->p0, &g->p1,
-                      pit);
+    int rc = pbPlayMove(&g->board, seat, ev->arg);
 
     if (rc != 0) {
-        send(g_clients[client_index].fd, "ERROR : Illegal move\n", 22, 0);
+        exec_send(ev->who, "ERROR : Illegal move\n", 22);
         return;
     }
 
     /* Commande MOVE */
     FILE *f = fopen(g->filename, "a");
     if (f) {
-        fprintf(f, "%s MOVE %d\n",
-                g_clients[client_index].name, pit);
+        fprintf(f, "%s MOVE %d\n", g->names[seat], ev->arg);
         fclose(f);
     }
 
-    g->to_move ^= 1;
+    /* Incrément ajouté au temps déjà décompté : la pendule adverse part */
+    if (g->timed) {
+        g->clock_left[seat] = left + (int64_t)g->clock_inc;
+        g->clock_since      = timers_now_ns();
+    }
+
+    g->to_move  ^= 1;
+    g->last_move = timers_now();
+
+    /* Le drapeau adverse peut tomber avant l'échéance armée */
+    if (g->timed)
+        exec_arm(g);
 
     games_send_board(g);
 
-    if (isGameOver(g->board, &g->p0.score, &g->p1.score))
-        games_end(g);
+    if (pbIsGameOver(&g->board))
+        games_end(g, -1);
 }
 
 /* =====================================================
  *                  Mode observateur
  * ===================================================== */
-int games_add_observer(Game *g, int fd)
+static void exec_observe(const GameEvent *ev)
 {
-    if (g->observer_count >= MAX_CLIENTS)
-        return 0;
+    Game *g = exec_game(ev);
 
-    g->observers[g->observer_count++] = fd;
-    return 1;
-}
+    /* Partie finie entre la commande et son arrivée ici */
+    if (!g) {
+        const char *msg = "ERROR : Invalid game ID !\n";
+        exec_send(ev->who, msg, strlen(msg));
+        return;
+    }
 
-void games_remove_observer_fd(int fd)
-{
-    for (int gi = 0; gi < MAX_GAMES; gi++) {
+    if (g->observer_count == g->observer_cap) {
+        int cap = g->observer_cap ? g->observer_cap * 2 : 4;
+        ClientRef *obs = realloc(g->observers, (size_t)cap * sizeof(ClientRef));
+        if (!obs) {
+            const char *msg = "ERROR : Too many observers !\n";
+            exec_send(ev->who, msg, strlen(msg));
+            return;
+        }
+        g->observers    = obs;
+        g->observer_cap = cap;
+    }
 
-        if (!g_games[gi].active)
-            continue;
+    g->observers[g->observer_count++] = ev->who;
 
-        Game *g = &g_games[gi];
+    char ok[128];
+    snprintf(ok, sizeof(ok),
+             "Now observing game %d: %s vs %s\n",
+             ev->game, g->names[0], g->names[1]);
+    exec_send(ev->who, ok, strlen(ok));
 
-        for (int z = 0; z < g->observer_count; z++) {
+    /* Plateau de départ de l'observateur ; les suivants peuvent être différentiels */
+    games_send_snapshot(g, ev->who);
+}
+
+static void exec_unobserve(const GameEvent *ev)
+{
+    Game *g = &g_games[ev->game];
 
-            if (g->observers[z] == fd) {
-                if (z < g->observer_count - 1) {
-                    g->observers[z] = g->observers[g->observer_count - 1];
-                }
-                g->observer_count--;
-                return;
+    for (int z = 0; z < g->observer_count; z++) {
+
+        if (ref_equal(g->observers[z], ev->who)) {
+            if (z < g->observer_count - 1) {
+                g->observers[z] = g->observers[g->observer_count - 1];
             }
+            g->observer_count--;
+            return;
         }
     }
 }
@@ -275,58 +851,70 @@ void games_remove_observer_fd(int fd)
 /* =====================================================
  *                   Annuler une partie
  * ===================================================== */
-void games_cancel_by_client(int client_index, int notify)
+static void exec_cancel(const GameEvent *ev)
 {
-    if (!g_clients[client_index].in_game)
-        return;
+    Game *g    = exec_game(ev);
+    int   seat = g ? exec_seat(g, ev->who) : -1;
 
-    int g_idx = games_find_by_player_name(g_clients[client_index].name);
-
-    if (g_idx < 0)
+    if (seat < 0)
         return;
 
-    Game *g = &g_games[g_idx];
+    char msg[64];
+    snprintf(msg, sizeof(msg), "GAME_CANCELED %s\n", ev->names[0]);
+    size_t len = strlen(msg);
 
-    int opp = g_clients[client_index].opponent_index;
+    Fanout out;
+    fanout_init(&out, msg, len, NULL, 0);
 
     /* On notifie l'adversaire */
-    if (notify && opp >= 0 && g_clients[opp].fd > 0)
-    {
-        char msg[128];
-        
-        snprintf(msg, sizeof(msg),
-                 "GAME_CANCELED %s\n",
-                 g_clients[client_index].name);
-
-        if (send(g_clients[opp].fd, msg, strlen(msg), 0) > 0)
-        {
-            g_clients[opp].in_game        = 0;
-            g_clients[opp].ready          = 0;
-            g_clients[opp].opponent_index = -1;
-        }
-    }
+    if (ev->arg)
+        fanout_send(&out, g->player[seat ^ 1], 0);
 
     /* Notifier tous les observateur que le jeu est fini */
-    char obs_msg[64];
-    snprintf(obs_msg, sizeof(obs_msg),
-             "GAME_CANCELED %s\n",
-             g_clients[client_index].name);
-
-    for (int z = 0; z < g->observer_count; z++) {
-        int fd = g->observers[z];
-        if (fd > 0)
-            send(fd, obs_msg, strlen(obs_msg), 0);
-    }
+    for (int z = 0; z < g->observer_count; z++)
+        fanout_send(&out, g->observers[z], 0);
 
-    g_clients[client_index].in_game        = 0;
-    g_clients[client_index].ready          = 0;
-    g_clients[client_index].opponent_index = -1;
+    fanout_done(&out);
 
     FILE *f = fopen(g->filename, "a");
     if (f) {
-        fprintf(f, "GAME_CANCELED by %s\n", g_clients[client_index].name);
+        fprintf(f, "GAME_CANCELED by %s\n", ev->names[0]);
         fclose(f);
     }
 
-    g->active = 0;
+    /* Le hub a déjà rendu le slot */
+    exec_close(g);
+}
+
+/* Plateau complet redemandé (joueur ou observateur de la partie) */
+static void exec_board(const GameEvent *ev)
+{
+    Game *g = exec_game(ev);
+    int   in = g && exec_seat(g, ev->who) >= 0;
+
+    for (int z = 0; g && !in && z < g->observer_count; z++)
+        in = ref_equal(g->observers[z], ev->who);
+
+    if (!in) {
+        exec_send(ev->who, "ERROR : Not in game !\n", 22);
+        return;
+    }
+
+    games_send_snapshot(g, ev->who);
+}
+
+void games_execute(const GameEvent *ev)
+{
+    switch (ev->type) {
+        case GAME_EV_START:     exec_start(ev);     break;
+        case GAME_EV_READY:     exec_ready(ev);     break;
+        case GAME_EV_MOVE:      exec_move(ev);      break;
+        case GAME_EV_OBSERVE:   exec_observe(ev);   break;
+        case GAME_EV_UNOBSERVE: exec_unobserve(ev); break;
+        case GAME_EV_CANCEL:    exec_cancel(ev);    break;
+        case GAME_EV_BOARD:     exec_board(ev);     break;
+    }
+
+    if (ev->ack)
+        reactor_ack(ev->who);
 }
@@ -0,0 +1,188 @@
+/*************************************************************************
+                           Awale -- Game (Server Index)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Index à adressage ouvert : socket → client,
+                           pseudo → client connecté, pseudo → compte
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <ctype.h>
+
+#include "server.h"
+
+/*
+ * Un index ne stocke que des numéros (client ou compte) ; la clé est
+ * relue dans l'entrée elle-même. Sondage linéaire, taux de remplissage
+ * au plus 1/2, suppression par décalage arrière (pas de pierres
+ * tombales) : recherche, ajout et retrait en O(1) en moyenne.
+ */
+#define INDEX_MIN_CAP  64
+
+typedef struct {
+    int       *slot;                 /* numéro, -1 = vide */
+    uint32_t   mask;                 /* capacité - 1 (puissance de 2) */
+    int        count;
+    uint32_t (*hash_of)(int id);     /* hachage de la clé de l'entrée id */
+} Index;
+
+/* =====================================================
+ *                      Hachage
+ * ===================================================== */
+static uint32_t hash_int(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+/* FNV-1a sur le pseudo en minuscules : la casse ne compte pas */
+static uint32_t hash_name(const char *s)
+{
+    uint32_t h = 2166136261u;
+    for (; *s; s++) {
+        h ^= (uint32_t)tolower((unsigned char)*s);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static uint32_t client_fd_hash(int ci)      { return hash_int((uint32_t)g_clients[ci].fd); }
+static uint32_t client_name_hash(int ci)    { return hash_name(g_clients[ci].name); }
+static uint32_t account_name_hash(int acc)  { return hash_name(g_accounts[acc].username); }
+
+static Index g_by_fd      = { NULL, 0, 0, client_fd_hash };
+static Index g_by_name    = { NULL, 0, 0, client_name_hash };
+static Index g_by_account = { NULL, 0, 0, account_name_hash };
+
+/* =====================================================
+ *                 Table à adressage ouvert
+ * ===================================================== */
+static void index_place(Index *ix, int id)
+{
+    uint32_t h = ix->hash_of(id) & ix->mask;
+    while (ix->slot[h] != -1)
+        h = (h + 1) & ix->mask;
+    ix->slot[h] = id;
+}
+
+static int index_resize(Index *ix, uint32_t cap)
+{
+    int *slot = malloc((size_t)cap * sizeof(int));
+    if (!slot)
+        return -1;
+    for (uint32_t k = 0; k < cap; k++)
+        slot[k] = -1;
+
+    int     *old     = ix->slot;
+    uint32_t old_cap = ix->slot ? ix->mask + 1 : 0;
+
+    ix->slot = slot;
+    ix->mask = cap - 1;
+    for (uint32_t k = 0; k < old_cap; k++)
+        if (old[k] != -1)
+            index_place(ix, old[k]);
+
+    free(old);
+    return 0;
+}
+
+static int index_add(Index *ix, int id)
+{
+    uint32_t cap = ix->slot ? ix->mask + 1 : 0;
+
+    if ((uint32_t)(ix->count + 1) * 2 > cap &&
+        index_resize(ix, cap ? cap * 2 : INDEX_MIN_CAP) < 0 &&
+        (uint32_t)(ix->count + 1) >= cap)
+        return -1;     /* plein et impossible d'agrandir */
+
+    index_place(ix, id);
+    ix->count++;
+    return 0;
+}
+
+static void index_del(Index *ix, int id)
+{
+    if (!ix->slot)
+        return;
+
+    uint32_t h = ix->hash_of(id) & ix->mask;
+    while (ix->slot[h] != id) {
+        if (ix->slot[h] == -1)
+            return;
+        h = (h + 1) & ix->mask;
+    }
+
+    /* Décalage arrière : chaque suivant remonte s'il le peut */
+    uint32_t hole = h;
+    for (uint32_t k = (h + 1) & ix->mask; ix->slot[k] != -1; k = (k + 1) & ix->mask) {
+        uint32_t home = ix->hash_of(ix->slot[k]) & ix->mask;
+        if (((k - home) & ix->mask) >= ((k - hole) & ix->mask)) {
+            ix->slot[hole] = ix->slot[k];
+            hole = k;
+        }
+    }
+    ix->slot[hole] = -1;
+    ix->count--;
+}
+
+/* =====================================================
+ *                 Socket → client
+ * ===================================================== */
+int index_add_fd(int ci)  { return index_add(&g_by_fd, ci); }
+void index_del_fd(int ci) { index_del(&g_by_fd, ci); }
+
+int client_index_by_fd(int fd)
+{
+    if (fd < 0 || !g_by_fd.slot)
+        return -1;
+
+    uint32_t h = hash_int((uint32_t)fd) & g_by_fd.mask;
+    for (int ci; (ci = g_by_fd.slot[h]) != -1; h = (h + 1) & g_by_fd.mask)
+        if (g_clients[ci].fd == fd)
+            return ci;
+    return -1;
+}
+
+/* =====================================================
+ *              Pseudo → client connecté
+ * ===================================================== */
+int index_add_name(int ci)  { return index_add(&g_by_name, ci); }
+void index_del_name(int ci) { index_del(&g_by_name, ci); }
+
+int client_index_by_name(const char *name)
+{
+    if (!name || !*name || !g_by_name.slot)
+        return -1;
+
+    uint32_t h = hash_name(name) & g_by_name.mask;
+    for (int ci; (ci = g_by_name.slot[h]) != -1; h = (h + 1) & g_by_name.mask)
+        if (ci_equal(g_clients[ci].name, name))
+            return ci;
+    return -1;
+}
+
+/* =====================================================
+ *                  Pseudo → compte
+ * ===================================================== */
+int index_add_account(int acc) { return index_add(&g_by_account, acc); }
+
+int accounts_find(const char *username)
+{
+    if (!username || !*username || !g_by_account.slot)
+        return -1;
+
+    uint32_t h = hash_name(username) & g_by_account.mask;
+    for (int acc; (acc = g_by_account.slot[h]) != -1; h = (h + 1) & g_by_account.mask)
+        if (ci_equal(g_accounts[acc].username, username))
+            return acc;
+    return -1;
+}
@@ -0,0 +1,719 @@
+/*************************************************************************
+                           Awale -- Game (Server I/O)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Tampon d'entrée circulaire de chaque client,
+                           découpage des commandes en lignes, et file de
+                           sortie bornée vidée sans jamais bloquer :
+                           segments de tampons partagés, envoyés par
+                           writev
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "server.h"
+
+#define IN_MASK  (INPUT_RING_SIZE - 1)
+
+/* =====================================================
+ *                  Tampon d'entrée
+ * ===================================================== */
+void input_reset(Client *c)
+{
+    c->in_head    = 0;
+    c->in_len     = 0;
+    c->in_discard = 0;
+}
+
+/*
+ * Un seul recvmsg remplit la place libre, même quand elle est coupée en
+ * deux par la fin du tableau. Avec io_uring, les octets viennent des
+ * tampons déjà reçus (uring_recv).
+ */
+ssize_t input_fill(Client *c)
+{
+    unsigned free_bytes = INPUT_RING_SIZE - c->in_len;
+    unsigned tail       = (c->in_head + c->in_len) & IN_MASK;
+    unsigned first      = INPUT_RING_SIZE - tail;
+
+    if (first > free_bytes)
+        first = free_bytes;
+
+    struct iovec iov[2] = {
+        { c->in_ring + tail, first },
+        { c->in_ring,        free_bytes - first },
+    };
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov    = iov;
+    msg.msg_iovlen = (free_bytes > first) ? 2 : 1;
+
+    ssize_t n;
+    if (loop_backend() == LOOP_URING) {
+        n = uring_recv(c, iov, (int)msg.msg_iovlen);
+    } else {
+        do {
+            reactor_syscall();
+            n = recvmsg(c->fd, &msg, MSG_DONTWAIT);
+        } while (n < 0 && errno == EINTR);
+    }
+
+    if (n > 0)
+        c->in_len += (unsigned)n;
+    return n;
+}
+
+/* Retire n octets en tête */
+static void input_drop(Client *c, unsigned n)
+{
+    c->in_head  = (c->in_head + n) & IN_MASK;
+    c->in_len  -= n;
+}
+
+int input_next_line(Client *c, char *line, size_t cap)
+{
+    for (;;) {
+        /* Position du prochain '\n', en tenant compte du repli */
+        unsigned eol = c->in_len;
+        for (unsigned k = 0; k < c->in_len; k++) {
+            if (c->in_ring[(c->in_head + k) & IN_MASK] == '\n') {
+                eol = k;
+                break;
+            }
+        }
+
+        if (eol == c->in_len) {
+            /* Pas de ligne complète : trop longue si elle remplit déjà la limite */
+            if (c->in_discard) {
+                input_drop(c, c->in_len);
+                return 0;
+            }
+            if (c->in_len > INPUT_MAX_LINE) {
+                input_drop(c, c->in_len);
+                c->in_discard = 1;
+                return -1;
+            }
+            return 0;
+        }
+
+        /* Fin d'une ligne trop longue déjà signalée */
+        if (c->in_discard) {
+            input_drop(c, eol + 1);
+            c->in_discard = 0;
+            continue;
+        }
+
+        if (eol > INPUT_MAX_LINE || eol >= cap) {
+            input_drop(c, eol + 1);
+            return -1;
+        }
+
+        unsigned start = c->in_head;
+        unsigned first = INPUT_RING_SIZE - start;
+        if (first > eol)
+            first = eol;
+
+        memcpy(line, c->in_ring + start, first);
+        memcpy(line + first, c->in_ring, eol - first);
+        line[eol] = '\0';
+
+        input_drop(c, eol + 1);
+
+        /* Comme auparavant : la commande s'arrête au premier \r */
+        line[strcspn(line, "\r")] = '\0';
+        return 1;
+    }
+}
+
+/* Copie n octets à partir de la position off du tampon */
+static void input_peek(const Client *c, unsigned off, void *dst, unsigned n)
+{
+    unsigned start = (c->in_head + off) & IN_MASK;
+    unsigned first = INPUT_RING_SIZE - start;
+    if (first > n)
+        first = n;
+
+    memcpy(dst, c->in_ring + start, first);
+    memcpy((char *)dst + first, c->in_ring, n - first);
+}
+
+int input_next_frame(Client *c, char *line, size_t cap)
+{
+    for (;;) {
+        uint8_t hdr[PROTO_HEADER];
+        if (c->in_len < PROTO_HEADER)
+            return 0;
+        input_peek(c, 0, hdr, PROTO_HEADER);
+
+        unsigned body = ((unsigned)hdr[0] << 8) | hdr[1];
+        if (body > INPUT_MAX_LINE || body >= cap)
+            return -2;
+        if (c->in_len < PROTO_HEADER + body)
+            return 0;
+
+        if (hdr[2] == PROTO_OP_TEXT) {
+            input_peek(c, PROTO_HEADER, line, body);
+            line[body] = '\0';
+            input_drop(c, PROTO_HEADER + body);
+            line[strcspn(line, "\r\n")] = '\0';
+            return 1;
+        }
+
+        if (hdr[2] == PROTO_OP_MOVE && body == PROTO_MOVE_LEN) {
+            uint8_t pit;
+            input_peek(c, PROTO_HEADER, &pit, 1);
+            input_drop(c, PROTO_HEADER + body);
+            snprintf(line, cap, "MOVE %u", pit);
+            return 1;
+        }
+
+        /* Opcode inconnu d'un client : la trame est ignorée */
+        input_drop(c, PROTO_HEADER + body);
+    }
+}
+
+/* =====================================================
+ *                 Tampons partagés
+ * ===================================================== */
+OutBuf *outbuf_new(const char *data, size_t len)
+{
+    OutBuf *b = malloc(sizeof(OutBuf) + len);
+    if (!b)
+        return NULL;
+
+    atomic_init(&b->refs, 1);
+    b->len = (unsigned)len;
+    b->cap = (unsigned)len;
+    memcpy(b->data, data, len);
+    return b;
+}
+
+void outbuf_retain(OutBuf *b)
+{
+    atomic_fetch_add_explicit(&b->refs, 1, memory_order_relaxed);
+}
+
+void outbuf_release(OutBuf *b)
+{
+    if (b && atomic_fetch_sub_explicit(&b->refs, 1, memory_order_acq_rel) == 1)
+        free(b);
+}
+
+/*
+ * Chaque ligne d'un texte devient une trame TEXT ; les '\0' que certains
+ * messages portent en fin de ligne sont retirés. Avec dst NULL, calcule
+ * seulement la taille.
+ */
+static size_t text_frames(uint8_t *dst, const char *msg, size_t len)
+{
+    size_t out = 0;
+    size_t n   = 0;
+
+    for (size_t k = 0; k < len; k++) {
+        char ch = msg[k];
+
+        if (ch != '\n' && ch != '\0' && n < PROTO_MAX_LEN) {
+            if (dst)
+                dst[out + PROTO_HEADER + n] = (uint8_t)ch;
+            n++;
+        }
+
+        if (ch == '\n' || (k + 1 == len && n > 0)) {
+            if (dst)
+                proto_header(dst + out, PROTO_OP_TEXT, n);
+            out += PROTO_HEADER + n;
+            n    = 0;
+        }
+    }
+    return out;
+}
+
+static OutBuf *outbuf_frames(const char *msg, size_t len)
+{
+    size_t  size = text_frames(NULL, msg, len);
+    OutBuf *b    = malloc(sizeof(OutBuf) + size);
+    if (!b)
+        return NULL;
+
+    atomic_init(&b->refs, 1);
+    b->len = (unsigned)text_frames((uint8_t *)b->data, msg, len);
+    b->cap = b->len;
+    return b;
+}
+
+void fanout_init(Fanout *f, const char *msg, size_t len,
+                 const uint8_t *frame, size_t frame_len)
+{
+    f->msg       = msg;
+    f->len       = len;
+    f->frame     = frame;
+    f->frame_len = frame_len;
+    f->form[PROTO_TEXT] = NULL;
+    f->form[PROTO_BIN]  = NULL;
+}
+
+void fanout_send(Fanout *f, ClientRef to, int flags)
+{
+    int bin = reactor_binary(to) ? PROTO_BIN : PROTO_TEXT;
+
+    /* Forme sérialisée à la première connexion qui la demande */
+    if (!f->form[bin]) {
+        if (bin == PROTO_TEXT)
+            f->form[bin] = outbuf_new(f->msg, f->len);
+        else if (f->frame)
+            f->form[bin] = outbuf_new((const char *)f->frame, f->frame_len);
+        else
+            f->form[bin] = outbuf_frames(f->msg, f->len);
+
+        if (!f->form[bin])
+            return;
+    }
+
+    reactor_send_buf(to, f->form[bin], flags | (bin == PROTO_BIN ? SEND_FRAME : 0));
+}
+
+void fanout_done(Fanout *f)
+{
+    outbuf_release(f->form[PROTO_TEXT]);
+    outbuf_release(f->form[PROTO_BIN]);
+}
+
+/* =====================================================
+ *                  File de sortie
+ * ===================================================== */
+
+/*
+ * La file d'un client est une suite de segments, chacun une tranche
+ * d'un OutBuf : tampon partagé avec d'autres files (plateau, diffusion),
+ * ou morceau privé où output_push copie les réponses propres au client.
+ * Un seul writev envoie jusqu'à OUTPUT_IOV segments (server.h).
+ */
+#define OUTPUT_CHUNK  2048
+
+static size_t g_high_water = DEFAULT_OUTPUT_MAX;
+
+/* Clients dont la file a changé pendant le tour (liste chaînée, par réacteur) */
+static _Thread_local Client *g_flush = NULL;
+
+/* Compteurs du réacteur courant : seul son thread les modifie */
+static void stat_add(_Atomic uint64_t *v, uint64_t n)
+{
+    atomic_store_explicit(v, atomic_load_explicit(v, memory_order_relaxed) + n,
+                          memory_order_relaxed);
+}
+
+static void stat_sub(_Atomic uint64_t *v, uint64_t n)
+{
+    atomic_store_explicit(v, atomic_load_explicit(v, memory_order_relaxed) - n,
+                          memory_order_relaxed);
+}
+
+void output_init(size_t high_water)
+{
+    g_high_water = high_water;
+}
+
+static void output_list(Client *c)
+{
+    if (c->out_listed)
+        return;
+
+    c->out_listed = 1;
+    c->out_next   = g_flush;
+    g_flush       = c;
+}
+
+static void output_set_stalled(Client *c, int stalled)
+{
+    if (c->out_stalled == stalled)
+        return;
+
+    c->out_stalled = stalled;
+    if (stalled)
+        stat_add(&reactor_stats()->stalled, 1);
+    else
+        stat_sub(&reactor_stats()->stalled, 1);
+    loop_update(c);
+}
+
+static OutSeg *seg_at(const Client *c, unsigned k)
+{
+    return &c->out_segs[(c->out_seg_head + k) & (c->out_seg_cap - 1)];
+}
+
+void output_reset(Client *c)
+{
+    stat_sub(&reactor_stats()->queued, c->out_len);
+    output_set_stalled(c, 0);
+
+    for (unsigned k = 0; k < c->out_seg_count; k++)
+        outbuf_release(seg_at(c, k)->buf);
+
+    free(c->out_segs);
+    c->out_segs      = NULL;
+    c->out_seg_head  = 0;
+    c->out_seg_count = 0;
+    c->out_seg_cap   = 0;
+    c->out_len       = 0;
+}
+
+/* Client trop lent : sa file est jetée et il part en fin de tour */
+static void output_kick(Client *c)
+{
+    output_reset(c);
+    c->closing = 1;
+    stat_add(&reactor_stats()->kicked, 1);
+    output_list(c);
+}
+
+/* Nouveau segment en fin de file (la file de segments double au besoin) */
+static OutSeg *output_seg_add(Client *c)
+{
+    if (c->out_seg_count == c->out_seg_cap) {
+        unsigned cap  = c->out_seg_cap ? c->out_seg_cap * 2 : 8;
+        OutSeg  *segs = malloc(cap * sizeof(OutSeg));
+        if (!segs)
+            return NULL;
+
+        /* Remis dans l'ordre à partir de 0 */
+        for (unsigned k = 0; k < c->out_seg_count; k++)
+            segs[k] = *seg_at(c, k);
+
+        free(c->out_segs);
+        c->out_segs     = segs;
+        c->out_seg_cap  = cap;
+        c->out_seg_head = 0;
+    }
+
+    return &c->out_segs[(c->out_seg_head + c->out_seg_count++) & (c->out_seg_cap - 1)];
+}
+
+/* Octets ajoutés à la file : compteurs et liste des files à vider */
+static void output_queued(Client *c, size_t len)
+{
+    c->out_len += (unsigned)len;
+
+    OutputStats *st = reactor_stats();
+    stat_add(&st->queued, len);
+    if (c->out_len > atomic_load_explicit(&st->peak, memory_order_relaxed))
+        atomic_store_explicit(&st->peak, c->out_len, memory_order_relaxed);
+
+    output_list(c);
+}
+
+int output_push(Client *c, const char *msg, size_t len)
+{
+    if (c->fd < 0 || c->closing || c->lost)
+        return -1;
+
+    if (c->out_len + len > g_high_water) {
+        output_kick(c);
+        return -1;
+    }
+
+    /* Le morceau privé en fin de file a encore la place : simple copie */
+    OutSeg *tail = c->out_seg_count ? seg_at(c, c->out_seg_count - 1) : NULL;
+    OutBuf *b    = tail ? tail->buf : NULL;
+
+    if (!b || b->cap - b->len < len || tail->off + tail->len != b->len) {
+        size_t cap = (len > OUTPUT_CHUNK) ? len : OUTPUT_CHUNK;
+
+        b = malloc(sizeof(OutBuf) + cap);
+        if (b && (tail = output_seg_add(c)) == NULL) {
+            free(b);
+            b = NULL;
+        }
+        if (!b) {
+            output_kick(c);
+            return -1;
+        }
+
+        atomic_init(&b->refs, 1);
+        b->len = 0;
+        b->cap = (unsigned)cap;
+
+        tail->buf = b;
+        tail->off = 0;
+        tail->len = 0;
+    }
+
+    memcpy(b->data + b->len, msg, len);
+    b->len    += (unsigned)len;
+    tail->len += (unsigned)len;
+
+    output_queued(c, len);
+    return 0;
+}
+
+static void output_push_text(Client *c, const char *msg, size_t len)
+{
+    uint8_t frames[PROTO_HEADER + BUF_SIZE * 2];
+    size_t  size = text_frames(NULL, msg, len);
+
+    if (size <= sizeof(frames)) {
+        text_frames(frames, msg, len);
+        output_push(c, (const char *)frames, size);
+        return;
+    }
+
+    /* Long texte (liste des joueurs…) : un tampon à part, mis en file tel quel */
+    OutBuf *b = outbuf_frames(msg, len);
+    if (b)
+        output_send_buf(c, b, SEND_FRAME);
+    else
+        output_kick(c);
+}
+
+void output_send(Client *c, const char *msg, size_t len, int flags)
+{
+    if (flags & SEND_LOSSY) {
+        if (output_throttled(c)) {
+            stat_add(&reactor_stats()->dropped, 1);
+            return;
+        }
+    }
+
+    if (!(flags & SEND_FRAME) &&
+        atomic_load_explicit(&c->proto, memory_order_relaxed) == PROTO_BIN)
+        output_push_text(c, msg, len);
+    else
+        output_push(c, msg, len);
+}
+
+void output_send_buf(Client *c, OutBuf *b, int flags)
+{
+    if (c->fd < 0 || c->closing || c->lost) {
+        outbuf_release(b);
+        return;
+    }
+
+    if ((flags & SEND_LOSSY) && output_throttled(c)) {
+        stat_add(&reactor_stats()->dropped, 1);
+        outbuf_release(b);
+        return;
+    }
+
+    /* Forme choisie avant que HELLO ait fait passer c aux trames */
+    if (!(flags & SEND_FRAME) &&
+        atomic_load_explicit(&c->proto, memory_order_relaxed) == PROTO_BIN) {
+        output_push_text(c, b->data, b->len);
+        outbuf_release(b);
+        return;
+    }
+
+    OutSeg *seg;
+    if (c->out_len + b->len > g_high_water || (seg = output_seg_add(c)) == NULL) {
+        outbuf_release(b);
+        output_kick(c);
+        return;
+    }
+
+    /* La référence passe à la file : rien n'est copié */
+    seg->buf = b;
+    seg->off = 0;
+    seg->len = b->len;
+
+    output_queued(c, b->len);
+}
+
+int output_throttled(const Client *c)
+{
+    return c->out_len >= g_high_water / 2;
+}
+
+void output_pause(Client *c)
+{
+    c->in_paused = 1;
+    stat_add(&reactor_stats()->paused, 1);
+    loop_update(c);
+}
+
+void input_resume(Client *c)
+{
+    if (!c->in_paused || output_throttled(c) || c->in_flight >= INPUT_LINE_BUDGET)
+        return;
+
+    c->in_paused = 0;
+    loop_update(c);
+    loop_defer(c);
+}
+
+/* n octets envoyés : segments terminés rendus, le premier entamé avancé */
+static void output_consume(Client *c, size_t n)
+{
+    c->out_len -= (unsigned)n;
+    stat_sub(&reactor_stats()->queued, n);
+
+    while (n > 0) {
+        OutSeg *seg = seg_at(c, 0);
+
+        if (n < seg->len) {
+            seg->off += (unsigned)n;
+            seg->len -= (unsigned)n;
+            return;
+        }
+
+        n -= seg->len;
+        outbuf_release(seg->buf);
+        c->out_seg_head = (c->out_seg_head + 1) & (c->out_seg_cap - 1);
+        c->out_seg_count--;
+    }
+}
+
+/* Segments en tête de file, au plus OUTPUT_IOV */
+static int output_iov(const Client *c, struct iovec *iov)
+{
+    int cnt = 0;
+
+    for (unsigned k = 0; k < c->out_seg_count && cnt < OUTPUT_IOV; k++) {
+        OutSeg *seg = seg_at(c, k);
+        iov[cnt].iov_base = seg->buf->data + seg->off;
+        iov[cnt].iov_len  = seg->len;
+        cnt++;
+    }
+    return cnt;
+}
+
+int output_flush(Client *c)
+{
+    while (c->out_len > 0) {
+        struct iovec iov[OUTPUT_IOV];
+        int          cnt = output_iov(c, iov);
+
+        /* SIGPIPE est ignoré : writev sur une socket fermée rend EPIPE */
+        reactor_syscall();
+        ssize_t n = writev(c->fd, iov, cnt);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                /* La suite partira quand la socket sera inscriptible */
+                output_set_stalled(c, 1);
+                return 0;
+            }
+            return -1;
+        }
+
+        output_consume(c, (size_t)n);
+    }
+
+    /* File vide : tout est rendu (une connexion inactive ne garde rien) */
+    output_reset(c);
+    input_resume(c);
+    return 0;
+}
+
+int output_sent(Client *c, ssize_t n)
+{
+    if (n == -EAGAIN || n == -EWOULDBLOCK) {
+        output_set_stalled(c, 1);
+        return 0;
+    }
+    if (n < 0)
+        return -1;
+
+    output_consume(c, (size_t)n);
+
+    if (c->out_len > 0) {
+        /* Envoi partiel : la suite repart au passage suivant */
+        output_list(c);
+        return 0;
+    }
+
+    output_reset(c);
+    input_resume(c);
+    return 0;
+}
+
+void output_writable(Client *c)
+{
+    if (c->fd >= 0 && c->out_len > 0)
+        output_list(c);
+}
+
+/*
+ * io_uring : un envoi préparé par client, tous soumis d'un seul appel.
+ * Les clients à retirer attendent que les envois soient terminés : les
+ * retirer peut toucher d'autres files (GAME_CANCELED, client trop lent
+ * vidé), dont les segments ne doivent pas bouger avant.
+ */
+static void output_flush_batch(void)
+{
+    while (g_flush) {
+        Client *c     = g_flush;
+        Client *later = NULL;
+        g_flush = NULL;
+
+        while (c) {
+            Client *next = c->out_next;
+
+            if (c->fd >= 0 && c->closing) {
+                /* Reste marqué listé : personne d'autre ne le chaîne */
+                c->out_next = later;
+                later       = c;
+                c = next;
+                continue;
+            }
+
+            c->out_listed = 0;
+
+            if (c->fd >= 0 && c->out_len > 0) {
+                struct iovec iov[OUTPUT_IOV];
+
+                if (uring_send(c, iov, output_iov(c, iov)) < 0) {
+                    /* Série pleine : elle part, et c attend le passage suivant */
+                    uring_send_flush();
+                    output_list(c);
+                }
+            }
+            c = next;
+        }
+
+        uring_send_flush();
+
+        while (later) {
+            Client *next = later->out_next;
+            later->out_listed = 0;
+            reactor_lost(later);
+            later = next;
+        }
+    }
+}
+
+/*
+ * Un seul writev par client et par tour, quel que soit le nombre de
+ * réponses accumulées. Retirer un client peut remplir d'autres files
+ * (GAME_CANCELED…) : on recommence jusqu'à ce que la liste reste vide.
+ */
+void output_flush_all(void)
+{
+    if (loop_backend() == LOOP_URING) {
+        output_flush_batch();
+        return;
+    }
+
+    while (g_flush) {
+        Client *c = g_flush;
+        g_flush = NULL;
+
+        while (c) {
+            Client *next = c->out_next;
+            c->out_listed = 0;
+
+            if (c->fd >= 0 && (c->closing || output_flush(c) < 0))
+                reactor_lost(c);
+
+            c = next;
+        }
+    }
+}
@@ -0,0 +1,337 @@
+/*************************************************************************
+                           Awale -- Game (Server Loop)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Boucle d'événements du serveur : epoll en mode
+                           edge-triggered (une par réacteur), io_uring
+                           (server_uring.c), ou select() pour comparaison
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/select.h>
+
+#include "server.h"
+
+/* Événements lus par appel à epoll_wait */
+#define LOOP_MAX_EVENTS  256
+
+/* Chaque réacteur a sa boucle : l'état est propre au thread */
+static _Thread_local int  g_backend   = LOOP_EPOLL;
+static _Thread_local int  g_listen_fd = -1;
+
+/*
+ * select() (un seul réacteur) : ensemble maître (lecture), sockets dont
+ * la file de sortie attend, et client de chaque descripteur
+ */
+static fd_set  g_master_set;
+static fd_set  g_write_set;
+static int     g_max_fd = -1;
+static Client *g_fd_client[FD_SETSIZE];
+
+/*
+ * epoll : chaque événement porte directement son Client (NULL = écoute,
+ * &g_wake_tag = boîte aux lettres du réacteur)
+ */
+static _Thread_local int g_epoll_fd = -1;
+static char              g_wake_tag;
+
+/* Clients à reprendre après les événements du tour (liste chaînée) */
+static _Thread_local Client *g_deferred = NULL;
+
+/* =====================================================
+ *                    Initialisation
+ * ===================================================== */
+int loop_init(int backend, int listen_fd, int wake_fd)
+{
+    g_backend   = backend;
+    g_listen_fd = listen_fd;
+
+    timers_init();
+
+    if (backend == LOOP_URING)
+        return uring_init(listen_fd, wake_fd);
+
+    if (backend == LOOP_SELECT) {
+        if (listen_fd >= FD_SETSIZE)
+            return -1;
+        FD_ZERO(&g_master_set);
+        FD_ZERO(&g_write_set);
+        FD_SET(listen_fd, &g_master_set);
+        g_max_fd = listen_fd;
+        return 0;
+    }
+
+    g_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (g_epoll_fd < 0)
+        return -1;
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = EPOLLIN | EPOLLET;
+    ev.data.ptr = NULL;
+
+    if (epoll_ctl(g_epoll_fd, EPOLL_CTL_ADD, listen_fd, &ev) < 0)
+        return -1;
+
+    if (wake_fd < 0)
+        return 0;
+
+    ev.data.ptr = &g_wake_tag;
+    return epoll_ctl(g_epoll_fd, EPOLL_CTL_ADD, wake_fd, &ev);
+}
+
+int loop_backend(void)
+{
+    return g_backend;
+}
+
+const char *loop_backend_name(int backend)
+{
+    switch (backend) {
+        case LOOP_SELECT: return "select";
+        case LOOP_URING:  return "io_uring";
+    }
+    return "epoll";
+}
+
+/* =====================================================
+ *                Inscription des sockets
+ * ===================================================== */
+int loop_add(int fd, Client *c)
+{
+    if (g_backend == LOOP_URING)
+        return uring_add(c);
+
+    if (g_backend == LOOP_SELECT) {
+        /* select() ne sait pas dépasser FD_SETSIZE */
+        if (fd >= FD_SETSIZE)
+            return -1;
+        g_fd_client[fd] = c;
+        FD_SET(fd, &g_master_set);
+        if (fd > g_max_fd)
+            g_max_fd = fd;
+        return 0;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    /* EPOLLOUT ne se déclenche qu'après un EAGAIN : aucun réveil inutile */
+    ev.events   = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    ev.data.ptr = c;
+
+    return epoll_ctl(g_epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+}
+
+void loop_del(Client *c)
+{
+    int fd = c->fd;
+    if (fd < 0)
+        return;
+
+    if (g_backend == LOOP_URING) {
+        uring_del(c);
+        return;
+    }
+
+    if (g_backend == LOOP_SELECT) {
+        if (fd < FD_SETSIZE) {
+            FD_CLR(fd, &g_master_set);
+            FD_CLR(fd, &g_write_set);
+            g_fd_client[fd] = NULL;
+        }
+        return;
+    }
+
+    epoll_ctl(g_epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+}
+
+void loop_update(Client *c)
+{
+    if (g_backend == LOOP_URING) {
+        uring_update(c);
+        return;
+    }
+
+    if (g_backend != LOOP_SELECT || c->fd < 0 || c->fd >= FD_SETSIZE ||
+        g_fd_client[c->fd] != c)
+        return;
+
+    /* Un client suspendu rendrait select() toujours prêt en lecture */
+    if (c->in_paused)
+        FD_CLR(c->fd, &g_master_set);
+    else
+        FD_SET(c->fd, &g_master_set);
+
+    if (c->out_stalled)
+        FD_SET(c->fd, &g_write_set);
+    else
+        FD_CLR(c->fd, &g_write_set);
+}
+
+/* =====================================================
+ *                   Clients différés
+ * ===================================================== */
+void loop_defer(Client *c)
+{
+    /* Le drapeau n'est remis à zéro qu'en sortie de liste */
+    if (c->deferred)
+        return;
+
+    c->deferred   = 1;
+    c->defer_next = g_deferred;
+    g_deferred    = c;
+}
+
+/*
+ * Reprend les clients différés au tour précédent. Un client peut se
+ * redifférer : il rejoint alors la liste du tour suivant.
+ */
+static void run_deferred(void)
+{
+    Client *c = g_deferred;
+    g_deferred = NULL;
+
+    while (c) {
+        Client *next = c->defer_next;
+        c->deferred = 0;
+        server_handle_client_message(c);
+        c = next;
+    }
+}
+
+/* =====================================================
+ *                    Attente / dispatch
+ * ===================================================== */
+
+/*
+ * Délai d'attente (ms) : aucun si des lignes attendent déjà, sinon
+ * jusqu'au prochain minuteur (-1 : sans limite)
+ */
+static int loop_timeout(void)
+{
+    return g_deferred ? 0 : timers_timeout();
+}
+
+static void run_select(void)
+{
+    while (1)
+    {
+        fd_set read_fds  = g_master_set;
+        fd_set write_fds = g_write_set;
+
+        int ms = loop_timeout();
+        struct timeval tv = { ms / 1000, (ms % 1000) * 1000 };
+
+        reactor_syscall();
+        if (select(g_max_fd + 1, &read_fds, &write_fds, NULL, ms < 0 ? NULL : &tv) < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("select");
+            break;
+        }
+
+        /* Minuteurs échus avant les événements : l'heure du tour est à jour */
+        timers_run();
+
+        for (int fd = 0; fd <= g_max_fd; fd++) {
+            if (FD_ISSET(fd, &write_fds) && g_fd_client[fd])
+                output_writable(g_fd_client[fd]);
+
+            if (!FD_ISSET(fd, &read_fds))
+                continue;
+
+            if (fd == g_listen_fd)
+                server_handle_new_connection(g_listen_fd);
+            else if (g_fd_client[fd])
+                server_handle_client_message(g_fd_client[fd]);
+        }
+
+        run_deferred();
+        output_flush_all();
+        reactor_flush();
+        rate_turn();
+    }
+}
+
+static void run_epoll(void)
+{
+    struct epoll_event events[LOOP_MAX_EVENTS];
+
+    while (1)
+    {
+        reactor_syscall();
+        int n = epoll_wait(g_epoll_fd, events, LOOP_MAX_EVENTS, loop_timeout());
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("epoll_wait");
+            break;
+        }
+
+        timers_run();
+
+        /* Seuls les descripteurs prêts sont visités */
+        for (int k = 0; k < n; k++) {
+            Client *c = events[k].data.ptr;
+
+            if (!c) {
+                server_handle_new_connection(g_listen_fd);
+                continue;
+            }
+
+            if ((void *)c == (void *)&g_wake_tag) {
+                reactor_drain();
+                continue;
+            }
+
+            if (events[k].events & EPOLLOUT)
+                output_writable(c);
+            if (events[k].events & ~(uint32_t)EPOLLOUT)
+                server_handle_client_message(c);
+        }
+
+        /*
+         * Les réponses du tour partent ensemble, un writev() par client,
+         * puis les messages vers les autres réacteurs, un lot chacun
+         */
+        run_deferred();
+        output_flush_all();
+        reactor_flush();
+        rate_turn();
+    }
+}
+
+/*
+ * Les complétions (connexion acceptée, octets reçus, socket de nouveau
+ * inscriptible, réveil) et les minuteurs échus sont traités par
+ * uring_wait ; la fin du tour est la même qu'avec epoll, mais les
+ * envois y partent ensemble.
+ */
+static void run_uring(void)
+{
+    while (uring_wait(loop_timeout()) == 0) {
+        run_deferred();
+        output_flush_all();
+        reactor_flush();
+        rate_turn();
+    }
+    perror("io_uring_enter");
+}
+
+void loop_run(void)
+{
+    if (g_backend == LOOP_SELECT)
+        run_select();
+    else if (g_backend == LOOP_URING)
+        run_uring();
+    else
+        run_epoll();
+}
@@ -6,7 +6,7 @@
     e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
     description          : - TCP listening
                            - Accepter un nouveau client
-                           - Gérer les commandes des clients
+                           - Découper ses lignes et les confier au hub
 *************************************************************************/
 
 #define _GNU_SOURCE
@@ -15,1069 +15,536 @@
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>   
+#include <errno.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/stat.h>
+#include <sys/resource.h>
 #include <time.h>
+#include <signal.h>
 
 #include "server.h"
 
 /* =====================================================
- *                  Authentification
+ *                 Sessions (hub)
  * ===================================================== */
 
-/* Comparaison de mot de passe limitée (évite les warnings de %s). */
-static int password_match(const char *a, const char *b)
+/*
+ * Échéance de la session de c (ms), 0 si aucune : connexion à terminer
+ * depuis l'ouverture, puis inactivité depuis la dernière ligne.
+ */
+static uint64_t session_deadline(const Client *c)
 {
-    return strncmp(a, b, 31) == 0;
-}
+    unsigned login = timeout_ms(TIMEOUT_LOGIN);
+    unsigned idle  = timeout_ms(TIMEOUT_IDLE);
 
-static int is_valid_username(const char *username)
-{
-    if (!username || !*username) return 0;
-    if (strlen(username) > 15) return 0;
-    
-    for (size_t i = 0; username[i]; i++) {
-        char c = username[i];
-        if (!((c >= 'a' && c <= 'z') ||
-              (c >= 'A' && c <= 'Z') ||
-              (c >= '0' && c <= '9') ||
-              c == '_' || c == '-'))
-            return 0;
-    }
-    return 1;
+    if (!c->logged_in && login)
+        return c->session_since + login;
+    return idle ? c->session_seen + idle : 0;
 }
 
-/* =====================================================
- *                 Supprimer un client
- * ===================================================== */
-void server_remove_client(int fd)
-{
-    games_remove_observer_fd(fd);
-
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (g_clients[i].fd == fd) {
-
-            if (g_clients[i].in_game)
-                games_cancel_by_client(i, 1);
-
-            close(fd);
-            FD_CLR(fd, &g_master_set);
+static void session_expired(Timer *t);
 
-            g_clients[i].fd            = -1;
-            g_clients[i].logged_in     = 0;
-            g_clients[i].login_stage   = 0;
-            g_clients[i].in_game       = 0;
-            g_clients[i].ready         = 0;
-            g_clients[i].private_mode  = 0;
-            g_clients[i].opponent_index = -1;
-            g_clients[i].player_index   = -1;
-            g_clients[i].name[0]        = '\0';
-            g_clients[i].pending_friend_reqs[0] = '\0';
+static void session_arm(Client *c)
+{
+    uint64_t when = session_deadline(c);
 
-            break;
-        }
-    }
+    if (when)
+        timer_arm(&c->session_timer, when, session_expired);
+    else
+        timer_cancel(&c->session_timer);
 }
 
-/* =====================================================
- *            Accepter une nouvelle connexion
- * ===================================================== */
-void server_handle_new_connection(int server_fd)
+/*
+ * Les lignes ne touchent que session_seen : le minuteur n'est déplacé
+ * qu'à son échéance, s'il y a eu de l'activité depuis. Un joueur ou un
+ * observateur n'est pas inactif (les coups ne passent pas par le hub,
+ * et la partie a son propre délai).
+ */
+static void session_expired(Timer *t)
 {
-    struct sockaddr_in cli;
-    socklen_t alen = sizeof(cli);
-
-    int newfd = accept(server_fd, (struct sockaddr *)&cli, &alen);
-    if (newfd < 0)
-        return;
-
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-
-        if (g_clients[i].fd == -1) {
+    Client  *c   = timer_owner(t, Client, session_timer);
+    uint64_t now = timers_now();
 
-            g_clients[i].fd            = newfd;
-            g_clients[i].logged_in     = 0;
-            g_clients[i].login_stage   = 0;
-            g_clients[i].in_game       = 0;
-            g_clients[i].ready         = 0;
-            g_clients[i].private_mode  = 0;
-            g_clients[i].opponent_index = -1;
-            g_clients[i].player_index   = -1;
-            g_clients[i].name[0]        = '\0';
-            g_clients[i].pending_friend_reqs[0] = '\0';
+    if (c->logged_in && (c->in_game || c->observing >= 0))
+        c->session_seen = now;
 
-            FD_SET(newfd, &g_master_set);
-            if (newfd > g_max_fd)
-                g_max_fd = newfd;
-
-            const char *msg = "Enter your username :\n";
-            send(newfd, msg, strlen(msg), 0);
-            return;
-        }
+    if (session_deadline(c) > now) {
+        session_arm(c);
+        return;
     }
 
-    send(newfd, "Server full\n", 12, 0);
-    close(newfd);
+    const char *msg = c->logged_in ? "ERROR : Idle timeout !\n"
+                                   : "ERROR : Login timeout !\n";
+    server_send(c->fd, msg, strlen(msg));
+    server_remove_client(c->fd);
 }
 
-/* =====================================================
- *              Gérer le message d'un client
- * ===================================================== */
-void server_handle_client_message(int fd)
+/*
+ * Une connexion acceptée par le réacteur home devient une session :
+ * elle est indexée par sa socket et reçoit l'invite de connexion.
+ */
+void server_attach(Client *c, int home)
 {
-    char buf[BUF_SIZE];
-    int n = recv(fd, buf, sizeof(buf) - 1, 0);
-
-    if (n <= 0) {
-        server_remove_client(fd);
-        return;
-    }
-
-    buf[n] = '\0';
-    buf[strcspn(buf, "\r\n")] = '\0';
-
-    /* Find client index */
-    int i = -1;
-    for (int k = 0; k < MAX_CLIENTS; k++) {
-        if (g_clients[k].fd == fd) {
-            i = k;
-            break;
-        }
-    }
-    if (i == -1) return;
-
-    /* =====================================================
-     *                          LOGIN
-     * ===================================================== */
-    if (!g_clients[i].logged_in)
-    {
-        /* ---------- Étape 0 : USERNAME ---------- */
-        if (g_clients[i].login_stage == 0)
-        {
-            if (buf[0] == '\0') {
-                const char *m = "Enter your username :\n";
-                send(fd, m, strlen(m), 0);
-                return;
-            }
-
-            /* Valider le format du username */
-            if (!is_valid_username(buf)) {
-                const char *msg = 
-                    "ERROR : Invalid username (alphanumeric, - and _ only, max 15 chars)\n";
-                send(fd, msg, strlen(msg), 0);
-                const char *prompt = "Enter your username :\n";
-                send(fd, prompt, strlen(prompt), 0);
-                return;
-            }
-
-            /* Vérifier si le username existe déjà */
-            if (username_logged_in(buf)) {
-                char msg[128];
-                snprintf(msg, sizeof(msg),
-                         "ERROR : User %s is already logged in !\n", buf);
-                send(fd, msg, strlen(msg), 0);
-                const char *prompt = "Enter your username :\n";
-                send(fd, prompt, strlen(prompt), 0);
-                return;
-            }
-
-            /* On mets le username en minuscule */
-            char normalized[16];
-            to_lowercase(normalized, buf, sizeof(normalized));
-            copy_bounded(g_clients[i].name,
-                         sizeof(g_clients[i].name),
-                         normalized);
-
-            int acc = accounts_find(g_clients[i].name);
-
-            if (acc >= 0) {
-                char msg[128];
-                snprintf(msg, sizeof(msg),
-                         "Nice to meet you again, %s !\nEnter your password :\n",
-                         g_clients[i].name);
-                send(fd, msg, strlen(msg), 0);
-            } else {
-                char msg[128];
-                snprintf(msg, sizeof(msg),
-                         "Welcome, %s !\nPlease set your password :\n",
-                         g_clients[i].name);
-                send(fd, msg, strlen(msg), 0);
-            }
-
-            g_clients[i].login_stage = 1;
-            return;
-        }
-
-        /* ---------- Étape 1 : Mot de passe ---------- */
-        int acc = accounts_find(g_clients[i].name);
-
-        if (acc >= 0)
-        {
-            if (password_match(g_accounts[acc].password, buf))
-            {
-                if (username_logged_in(g_clients[i].name)) {
-                    const char *msg =
-                        "ERROR : Already logged in on another session !\n";
-                    send(fd, msg, strlen(msg), 0);
-
-                    g_clients[i].login_stage = 0;
-                    g_clients[i].name[0] = '\0';
-
-                    const char *prompt = "Enter your username :\n";
-                    send(fd, prompt, strlen(prompt), 0);
-                    return;
-                }
-
-                g_clients[i].logged_in   = 1;
-                g_clients[i].login_stage = 2;
-
-                const char *ok = "Logged in successfully !\n";
-                send(fd, ok, strlen(ok), 0);
-            }
-            else {
-                const char *msg =
-                    "ERROR : Wrong password\nEnter your username again :\n";
-                send(fd, msg, strlen(msg), 0);
-
-                g_clients[i].login_stage = 0;
-                g_clients[i].name[0] = '\0';
-            }
-
-            return;
-        }
-        else
-        {
-            if (g_account_count >= MAX_ACCOUNTS) {
-                const char *msg = "ERROR : Account storage full !\n";
-                send(fd, msg, strlen(msg), 0);
-                g_clients[i].login_stage = 0;
-                g_clients[i].name[0] = '\0';
-                return;
-            }
-
-            /* Création d'un nouveau compte */
-            copy_bounded(g_accounts[g_account_count].username,
-                         sizeof(g_accounts[g_account_count].username),
-                         g_clients[i].name);
-
-            copy_bounded(g_accounts[g_account_count].password,
-                         sizeof(g_accounts[g_account_count].password),
-                         buf);
-
-            g_accounts[g_account_count].bio[0]     = '\0';
-            g_accounts[g_account_count].friends[0] = '\0';
-
-            g_account_count++;
-            accounts_save(USERS_FILE);
-
-            g_clients[i].logged_in   = 1;
-            g_clients[i].login_stage = 2;
-
-            const char *ok = "New account created and logged in !\n";
-            send(fd, ok, strlen(ok), 0);
-            return;
-        }
-    }
-
-    /* =====================================================
-     *              Commandes du menu principal
-     * ===================================================== */
-
-    /* ---- HELP ---- */
-    if (strcasecmp(buf, "HELP") == 0) {
-        const char *m =
-            "Commands: LIST, GAMES, CHALLENGE, ACCEPT, REFUSE, MOVE, "
-            "CANCEL_GAME, OBSERVE, OUT_OBSERVER, SAY, MESSAGE, "
-            "BIO, SHOWBIO, MY_FRIENDS, FRIEND, ACCEPT_FRIEND, DECLINE_FRIEND, UNFRIEND, PRIVATE, QUIT.\n";
-        send(fd, m, strlen(m), 0);
+    int i = (int)(c - g_clients);
+
+    c->logged_in      = 0;
+    c->login_stage    = 0;
+    c->in_game        = 0;
+    c->private_mode   = 0;
+    c->is_bot         = 0;
+    c->opponent_index = -1;
+    c->player_index   = -1;
+    c->game_index     = -1;
+    c->observing      = -1;
+    c->name[0]        = '\0';
+    c->pending_friend_reqs[0] = '\0';
+    c->challenge_to[0] = '\0';
+    c->home           = home;
+
+    if (index_add_fd(i) < 0) {
+        const char *msg = "Server full\n";
+        reactor_send(reactor_ref(c), msg, strlen(msg), 0);
+        reactor_close(c);
         return;
     }
+    c->attached = 1;
 
-    /* ---- LIST ---- */
-    if (strcmp(buf, "LIST") == 0) {
-
-        char msg[512];
-        msg[0] = '\0';
-        append_bounded(msg, sizeof(msg), "ONLINE:");
-
-        for (int j = 0; j < MAX_CLIENTS; j++) {
+    c->session_since = timers_now();
+    c->session_seen  = c->session_since;
+    session_arm(c);
 
-            if (g_clients[j].fd != -1 &&
-                g_clients[j].logged_in &&
-                j != i &&
-                !g_clients[j].in_game)
-            {
-                append_bounded(msg, sizeof(msg), " ");
-                append_bounded(msg, sizeof(msg), g_clients[j].name);
-            }
-        }
+    const char *msg = "Enter your username :\n";
+    reactor_send(reactor_ref(c), msg, strlen(msg), 0);
+}
 
-        if (strcmp(msg, "ONLINE:") == 0)
-            append_bounded(msg, sizeof(msg), " (no other players online)");
+/* Referme la session de c : parties, observation, index */
+void server_detach(Client *c)
+{
+    int i = (int)(c - g_clients);
 
-        append_bounded(msg, sizeof(msg), "\n");
-        send(fd, msg, strlen(msg), 0);
+    if (!c->attached)
         return;
-    }
 
-    /* ---- GAMES ---- */
-    if (strcmp(buf, "GAMES") == 0)
-    {
-        char msg[512];
-        msg[0] = '\0';
-        append_bounded(msg, sizeof(msg), "ONGOING GAMES:\n");
-        int count = 0;
+    timer_cancel(&c->session_timer);
+    games_remove_observer(i);
 
-        for (int g = 0; g < MAX_GAMES; g++) {
-            if (!g_games[g].active)
-                continue;
-
-            char line[128];
-            snprintf(line, sizeof(line),
-                     "  ID %d: %s vs %s\n",
-                     g, g_games[g].p0.name, g_games[g].p1.name);
-
-            append_bounded(msg, sizeof(msg), line);
-            count++;
-        }
+    if (c->in_game)
+        games_cancel_by_client(i, 1);
 
-        if (!count)
-            append_bounded(msg, sizeof(msg), "  (no active games)\n");
+    index_del_fd(i);
+    if (c->logged_in)
+        index_del_name(i);
+
+    c->attached       = 0;
+    c->logged_in      = 0;
+    c->login_stage    = 0;
+    c->in_game        = 0;
+    c->private_mode   = 0;
+    c->is_bot         = 0;
+    c->opponent_index = -1;
+    c->player_index   = -1;
+    c->game_index     = -1;
+    c->observing      = -1;
+    c->name[0]        = '\0';
+    c->pending_friend_reqs[0] = '\0';
+}
 
-        send(fd, msg, strlen(msg), 0);
+/* Déconnexion décidée par le hub (QUIT, bot) : la socket suit */
+void server_remove_client(int fd)
+{
+    int i = client_index_by_fd(fd);
+    if (i < 0)
         return;
-    }
-
-    /* ---- OBSERVE <id> ---- */
-    if (strncmp(buf, "OBSERVE ", 8) == 0)
-    {
-        if (g_clients[i].in_game) {
-            const char *msg = "ERROR : You cannot observe while in a game !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        int id;
-        if (sscanf(buf + 8, "%d", &id) != 1) {
-            const char *msg = "ERROR : Usage: OBSERVE <id> !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        if (id < 0 || id >= MAX_GAMES || !g_games[id].active) {
-            const char *msg = "ERROR : Invalid game ID !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        Game *g = &g_games[id];
-
-        if (!games_can_observe(g, g_clients[i].name)) {
-            const char *msg =
-                "ERROR : Game is private. You are not allowed to observe !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        if (!games_add_observer(g, fd)) {
-            const char *msg = "ERROR : Too many observers !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
 
-        char ok[128];
-        snprintf(ok, sizeof(ok),
-                 "Now observing game %d: %s vs %s\n",
-                 id, g->p0.name, g->p1.name);
-        send(fd, ok, strlen(ok), 0);
+    server_detach(&g_clients[i]);
+    reactor_close(&g_clients[i]);
+}
 
-        games_send_board(g);
-        return;
-    }
+/* =====================================================
+ *            Accepter une nouvelle connexion
+ * ===================================================== */
+static void server_reject(int fd)
+{
+    send(fd, "Server full\n", 12, MSG_DONTWAIT | MSG_NOSIGNAL);
+    close(fd);
+}
 
-    /* ---- OUT_OBSERVER ---- */
-    if (strcmp(buf, "OUT_OBSERVER") == 0)
-    {
-        games_remove_observer_fd(fd);
-        const char *msg = "Left observation mode. Back to menu.\n";
-        send(fd, msg, strlen(msg), 0);
+/* Socket acceptée (non bloquante) : slot, boucle d'événements, session */
+void server_add_connection(int newfd)
+{
+    /*
+     * Plusieurs réponses courtes partent à la suite quand les
+     * commandes arrivent groupées : sans TCP_NODELAY, Nagle les
+     * retiendrait jusqu'à l'ACK retardé du client (~40 ms).
+     */
+    int one = 1;
+    setsockopt(newfd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    /* Slot libre en O(1), la table grandit si besoin */
+    int slot = client_alloc();
+    if (slot < 0) {
+        server_reject(newfd);
         return;
     }
 
-    /* ---- PRIVATE ON|OFF ---- */
-    if (strncmp(buf, "PRIVATE ", 8) == 0)
-    {
-        char mode[8] = {0};
-        sscanf(buf + 8, "%7s", mode);
-
-        if (strcasecmp(mode, "ON") == 0) {
-            g_clients[i].private_mode = 1;
-            const char *msg =
-                "Private mode ON: only your friends may observe your games.\n";
-            send(fd, msg, strlen(msg), 0);
-        } else {
-            g_clients[i].private_mode = 0;
-            const char *msg =
-                "Private mode OFF: everyone may observe your games.\n";
-            send(fd, msg, strlen(msg), 0);
-        }
+    /* Le réacteur ne touche qu'aux champs de connexion */
+    Client *c    = &g_clients[slot];
+    c->fd        = newfd;
+    c->reactor   = reactor_self();
+    c->in_paused = 0;
+    c->closing   = 0;
+    c->lost      = 0;
+    c->play_game = -1;
+    c->in_flight = 0;
+    c->greeted   = 0;
+    atomic_store_explicit(&c->proto, PROTO_TEXT, memory_order_relaxed);
+    atomic_store_explicit(&c->deltas, 0, memory_order_relaxed);
+    input_reset(c);
+    rate_reset(c);
+
+    if (loop_add(newfd, c) < 0) {
+        c->fd = -1;
+        client_release(slot);
+        server_reject(newfd);
         return;
     }
 
-    /* =====================================================
-     *                        BIO
-     * ===================================================== */
-    if (strncmp(buf, "BIO ", 4) == 0)
-    {
-        int acc = accounts_find(g_clients[i].name);
-        if (acc < 0) {
-            const char *msg = "ERROR : Account not found !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        const char *src = buf + 4;
-        while (*src == ' ' || *src == '\t')
-            src++;
-
-        if (*src == '\0') {
-            const char *msg = "ERROR : Bio cannot be empty !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        char cleaned[512];
-        size_t k = 0;
-        int lines = 0;
-
-        while (*src && k + 1 < sizeof(cleaned)) {
-            char c = *src++;
-
-            if (c == '\r') continue;
-            if (c == '\t') c = ' ';
-            if (c == '|')  c = '/';
-            if (c == '\\' && *src == 'n') {
-                c = '\n';
-                src++;
-            }
-            if (c == '\n') {
-                if (++lines >= 10)
-                    c = ' ';
-            }
-            cleaned[k++] = c;
-        }
-        cleaned[k] = '\0';
-
-        accounts_set_bio(acc, cleaned);
-        accounts_save(USERS_FILE);
-
-        const char *ok = "Bio updated\n";
-        send(fd, ok, strlen(ok), 0);
-        return;
-    }
+    reactor_attach(c);
+}
 
-    /* ---- SHOWBIO <user> ---- */
-    if (strncmp(buf, "SHOWBIO ", 8) == 0)
-    {
-        char target[16];
-        if (sscanf(buf + 8, "%15s", target) != 1) {
-            const char *msg = "ERROR : Usage: SHOWBIO <user> !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
+void server_handle_new_connection(int server_fd)
+{
+    /* Écoute non bloquante : on accepte tout ce qui attend (edge-triggered) */
+    for (;;) {
+        struct sockaddr_in cli;
+        socklen_t alen = sizeof(cli);
 
-        int acc = accounts_find(target);
-        if (acc < 0) {
-            const char *msg = "ERROR : User not found !\n";
-            send(fd, msg, strlen(msg), 0);
+        /* Socket non bloquante : un client lent ne bloque jamais un send() */
+        reactor_syscall();
+        int newfd = accept4(server_fd, (struct sockaddr *)&cli, &alen,
+                            SOCK_CLOEXEC | SOCK_NONBLOCK);
+        if (newfd < 0)
             return;
-        }
-
-        const char *bio = accounts_get_bio(acc);
 
-        char msg[700];
-        snprintf(msg, sizeof(msg),
-                 "\n--- BIO of %s ---\n%s\n-----------------\n",
-                 g_accounts[acc].username,
-                 (bio && bio[0]) ? bio : "(no bio)");
-        send(fd, msg, strlen(msg), 0);
-        return;
+        server_add_connection(newfd);
     }
+}
 
-    /* ---- MY_FRIENDS ---- */
-    if (strcmp(buf, "MY_FRIENDS") == 0)
-    {
-        int me = accounts_find(g_clients[i].name);
-        if (me < 0) {
-            const char *msg = "ERROR : Account not found !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        /* Vérifier si le joueur a une liste d'amis */
-        if (!g_accounts[me].friends[0]) {
-            const char *msg = "MY_FRIENDS:\n  (no friends yet)\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        char msg[512];
-        msg[0] = '\0';
-        append_bounded(msg, sizeof(msg), "MY_FRIENDS:");
-
-        char friends_copy[256];
-        strlcpy_safe(friends_copy, g_accounts[me].friends, sizeof(friends_copy));
-
-        char *tok = strtok(friends_copy, ",");
-        int count = 0;
-        while (tok && count < 50) {  /* Safety limit */
-            append_bounded(msg, sizeof(msg), " ");
-            append_bounded(msg, sizeof(msg), tok);
-            tok = strtok(NULL, ",");
-            count++;
-        }
-
-        append_bounded(msg, sizeof(msg), "\n");
-        send(fd, msg, strlen(msg), 0);
+/* =====================================================
+ *              Gérer le message d'un client
+ * ===================================================== */
+void server_handle_line(Client *c, char *line)
+{
+    if (!line) {
+        const char *msg = "ERROR : Line too long !\n";
+        server_send(c->fd, msg, strlen(msg));
         return;
     }
 
-    /* ---- FRIEND <user> ---- */
-    if (strncmp(buf, "FRIEND ", 7) == 0)
-    {
-        char target[16];
-        if (sscanf(buf + 7, "%15s", target) != 1) {
-            const char *msg = "ERROR : Usage: FRIEND <user> !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        if (ci_equal(target, g_clients[i].name)) {
-            const char *msg = "ERROR : You cannot friend yourself !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        int me  = accounts_find(g_clients[i].name);
-        int you = accounts_find(target);
-
-        if (me < 0 || you < 0) {
-            const char *msg = "ERROR : Unknown user !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        if (accounts_is_friend(me, target)) {
-            const char *msg = "Already friends\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        /* Trouver le joueur à qui envoyer la demande */
-        int target_idx = client_index_by_name(target);
-        if (target_idx < 0) {
-            const char *msg = "Friend request sent (user offline)\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        char req_msg[64];
-        snprintf(req_msg, sizeof(req_msg), "FRIEND_REQUEST %s\n", g_clients[i].name);
-        
-        /* On ajoute au demandes en cours */
-        size_t cur_len = strlen(g_clients[target_idx].pending_friend_reqs);
-        if (cur_len > 0 && cur_len + strlen(g_clients[i].name) + 2 < sizeof(g_clients[target_idx].pending_friend_reqs)) {
-            strcat(g_clients[target_idx].pending_friend_reqs, ",");
-            strcat(g_clients[target_idx].pending_friend_reqs, g_clients[i].name);
-        } else if (cur_len == 0 && strlen(g_clients[i].name) < sizeof(g_clients[target_idx].pending_friend_reqs)) {
-            strcpy(g_clients[target_idx].pending_friend_reqs, g_clients[i].name);
-        }
+    c->session_seen = timers_now();
+    rate_hub_line();
+    commands_execute((int)(c - g_clients), line);
+}
 
-        send(g_clients[target_idx].fd, req_msg, strlen(req_msg), 0);
+/*
+ * « HELLO <capacités> » en toute première ligne : négociation du
+ * protocole, traitée par le réacteur de la connexion pour que les
+ * octets suivants soient lus dans le bon mode. La réponse part en
+ * texte ; tout ce qui suit est en trames si PROTO_CAP_BIN est accepté.
+ * PROTO_CAP_DELTA, accepté, est répété dans la réponse.
+ */
+static int server_hello(Client *c, char *line)
+{
+    if (strncmp(line, PROTO_HELLO " ", 6) != 0)
+        return 0;
+
+    int   bin   = 0;
+    int   delta = 0;
+    char *save;
+    for (char *cap = strtok_r(line + 6, " ", &save); cap;
+         cap = strtok_r(NULL, " ", &save)) {
+        if (strcmp(cap, PROTO_CAP_BIN) == 0)
+            bin = 1;
+        else if (strcmp(cap, PROTO_CAP_DELTA) == 0)
+            delta = 1;
+    }
+
+    char reply[64];
+    int  len = snprintf(reply, sizeof(reply), "%s %s%s\n", PROTO_HELLO,
+                        bin ? PROTO_CAP_BIN : "TEXT",
+                        delta ? " " PROTO_CAP_DELTA : "");
+    output_push(c, reply, (size_t)len);
+
+    if (bin)
+        atomic_store_explicit(&c->proto, PROTO_BIN, memory_order_relaxed);
+    if (delta)
+        atomic_store_explicit(&c->deltas, 1, memory_order_relaxed);
+    return 1;
+}
 
-        const char *ok = "Friend request sent\n";
-        send(fd, ok, strlen(ok), 0);
+/*
+ * Traite chaque ligne complète du tampon, puis lit la socket jusqu'à
+ * EAGAIN (indispensable en edge-triggered). Une commande coupée entre
+ * deux segments attend la suite ; plusieurs commandes d'un même segment
+ * sont toutes traitées. Au-delà de INPUT_LINE_BUDGET lignes dans le
+ * tour de boucle, le client est repris au tour suivant pour ne pas
+ * affamer les autres ; chaque commande passe par son seau à jetons
+ * (rate_admit) avant d'être routée. Tant que sa file de sortie est trop
+ * pleine, ses commandes attendent : il est repris quand elle s'est
+ * vidée (output_flush). Hors du hub, les lignes lui sont transmises
+ * dans l'ordre d'arrivée ; MOVE et READY d'un joueur vont directement à
+ * l'exécuteur de sa partie. Un client PROTO_BIN envoie des trames,
+ * rendues sous forme de lignes (input_next_frame).
+ */
+void server_handle_client_message(Client *c)
+{
+    int fd = c->fd;
+    if (fd < 0 || c->closing || c->lost || c->in_paused)
         return;
-    }
 
-    /* ---- UNFRIEND <user> ---- */
-    if (strncmp(buf, "UNFRIEND ", 9) == 0)
-    {
-        char target[16];
-        if (sscanf(buf + 9, "%15s", target) != 1) {
-            const char *msg = "ERROR : Usage: UNFRIEND <user> !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
+    int hub = (reactor_self() == REACTOR_HUB);
 
-        if (ci_equal(target, g_clients[i].name)) {
-            const char *msg = "ERROR : You cannot unfriend yourself !\n";
-            send(fd, msg, strlen(msg), 0);
+    while (c->fd == fd && !c->closing && !c->lost) {
+        if (output_throttled(c)) {
+            output_pause(c);
             return;
         }
 
-        int me = accounts_find(g_clients[i].name);
-        int them = accounts_find(target);
-
-        if (me < 0) {
-            const char *msg = "ERROR : Account not found !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-        
-        int removed_me = accounts_remove_friend(me, target);
-        
-        if (them >= 0) {
-            accounts_remove_friend(them, g_clients[i].name);
-        }
-
-        accounts_save(USERS_FILE);
-
-        if (removed_me) {
-            const char *msg = "Friend removed !\n";
-            send(fd, msg, strlen(msg), 0);
-        } else {
-            const char *msg = "No such friend\n";
-            send(fd, msg, strlen(msg), 0);
-        }
-        return;
-    }
-
-    /* ---- ACCEPT_FRIEND <user> ---- */
-    if (strncmp(buf, "ACCEPT_FRIEND ", 14) == 0)
-    {
-        char requester[16];
-        if (sscanf(buf + 14, "%15s", requester) != 1) {
-            const char *msg = "ERROR : Usage: ACCEPT_FRIEND <user> !\n";
-            send(fd, msg, strlen(msg), 0);
+        /* Assez de lignes en route : on attend leurs accusés (reactor_ack) */
+        if (c->in_flight >= INPUT_LINE_BUDGET) {
+            c->in_paused = 1;
+            loop_update(c);
             return;
         }
 
-        int me = accounts_find(g_clients[i].name);
-        int them = accounts_find(requester);
-
-        if (me < 0 || them < 0) {
-            const char *msg = "ERROR : Unknown user !\n";
-            send(fd, msg, strlen(msg), 0);
+        if (rate_spent(c)) {
+            loop_defer(c);
             return;
         }
 
-        int ok1 = 0, full1 = 0;
-        accounts_add_friend(me, requester, &ok1, &full1);
-
-        int ok2 = 0, full2 = 0;
-        accounts_add_friend(them, g_clients[i].name, &ok2, &full2);
+        char line[BUF_SIZE];
+        int  rc = (atomic_load_explicit(&c->proto, memory_order_relaxed) == PROTO_BIN)
+                ? input_next_frame(c, line, sizeof(line))
+                : input_next_line(c, line, sizeof(line));
 
-        if (full1 || full2) {
-            const char *msg = "ERROR : Friends list full !\n";
-            send(fd, msg, strlen(msg), 0);
+        /* Trame démesurée : le flux ne peut plus être découpé */
+        if (rc == -2) {
+            reactor_lost(c);
             return;
         }
 
-        accounts_save(USERS_FILE);
-
-        char reqs[256];
-        strcpy(reqs, g_clients[i].pending_friend_reqs);
-        g_clients[i].pending_friend_reqs[0] = '\0';
-
-        char *tok = strtok(reqs, ",");
-        while (tok) {
-            if (strcasecmp(tok, requester) != 0) {
-                if (g_clients[i].pending_friend_reqs[0]) {
-                    strcat(g_clients[i].pending_friend_reqs, ",");
-                }
-                strcat(g_clients[i].pending_friend_reqs, tok);
-            }
-            tok = strtok(NULL, ",");
-        }
-
-        const char *msg = "Friend request accepted !\n";
-        send(fd, msg, strlen(msg), 0);
-
-        int requester_idx = client_index_by_name(requester);
-        if (requester_idx >= 0) {
-            char notify[64];
-            snprintf(notify, sizeof(notify), "FRIEND_ACCEPTED %s\n", g_clients[i].name);
-            send(g_clients[requester_idx].fd, notify, strlen(notify), 0);
-        }
-
-        return;
-    }
-
-    /* ---- DECLINE_FRIEND <user> ---- */
-    if (strncmp(buf, "DECLINE_FRIEND ", 15) == 0)
-    {
-        char requester[16];
-        if (sscanf(buf + 15, "%15s", requester) != 1) {
-            const char *msg = "ERROR : Usage: DECLINE_FRIEND <user> !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        char reqs[256];
-        strcpy(reqs, g_clients[i].pending_friend_reqs);
-        g_clients[i].pending_friend_reqs[0] = '\0';
-
-        char *tok = strtok(reqs, ",");
-        while (tok) {
-            if (strcasecmp(tok, requester) != 0) {
-                if (g_clients[i].pending_friend_reqs[0]) {
-                    strcat(g_clients[i].pending_friend_reqs, ",");
-                }
-                strcat(g_clients[i].pending_friend_reqs, tok);
+        if (rc != 0 && !c->greeted) {
+            c->greeted = 1;
+            if (rc > 0 && server_hello(c, line)) {
+                rate_count(c);
+                continue;
             }
-            tok = strtok(NULL, ",");
-        }
-
-        const char *msg = "Friend request declined\n";
-        send(fd, msg, strlen(msg), 0);
-
-        int requester_idx = client_index_by_name(requester);
-        if (requester_idx >= 0) {
-            char notify[64];
-            snprintf(notify, sizeof(notify), "FRIEND_DECLINED %s\n", g_clients[i].name);
-            send(g_clients[requester_idx].fd, notify, strlen(notify), 0);
-        }
-
-        return;
-    }
-
-    /* ---- CHALLENGE <user> ---- */
-    if (strncmp(buf, "CHALLENGE ", 10) == 0)
-    {
-        if (g_clients[i].in_game) {
-            const char *msg = "ERROR : You cannot challenge while in a game !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        char target[16];
-        if (sscanf(buf + 10, "%15s", target) != 1) {
-            const char *msg = "ERROR : Usage: CHALLENGE <user> !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
         }
 
-        if (ci_equal(target, g_clients[i].name)) {
-            const char *msg = "ERROR : You cannot challenge yourself !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
+        if (rc != 0) {
+            if (rc > 0)
+                rate_count(c);
+            if (rc > 0 && !rate_admit(c, line))
+                continue;
+            if (rc > 0 && games_route(c, line))
+                continue;
+            if (hub)
+                server_handle_line(c, rc > 0 ? line : NULL);
+            else
+                reactor_forward(c, rc > 0 ? line : NULL);
+            continue;
         }
 
-        int idx = client_index_by_name(target);
-        if (idx < 0) {
-            const char *msg = "ERROR : No such user !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
+        ssize_t n = input_fill(c);
 
-        if (g_clients[idx].in_game) {
-            char msg[128];
-            snprintf(msg, sizeof(msg),
-                     "ERROR : %s is already in a game !\n", target);
-            send(fd, msg, strlen(msg), 0);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
             return;
-        }
-
-        if (g_clients[i].in_game) {
-            const char *msg = "ERROR : You are already in a game !\n";
-            send(fd, msg, strlen(msg), 0);
+        if (n <= 0) {
+            reactor_lost(c);
             return;
         }
-
-        char msg[64];
-        snprintf(msg, sizeof(msg),
-                 "CHALLENGE_FROM %s\n", g_clients[i].name);
-        send(g_clients[idx].fd, msg, strlen(msg), 0);
-
-        const char *ok = "Challenge sent\n";
-        send(fd, ok, strlen(ok), 0);
-        return;
     }
+}
 
-    /* ---- REFUSE <user> ---- */
-    if (strncmp(buf, "REFUSE ", 7) == 0)
-    {
-        if (g_clients[i].in_game) {
-            const char *msg = "ERROR : You cannot refuse while in a game !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        char target[16];
-        if (sscanf(buf + 7, "%15s", target) != 1) {
-            const char *msg = "ERROR : Usage: REFUSE <user> !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        int idx = client_index_by_name(target);
-        if (idx < 0) {
-            const char *msg = "ERROR : No such user !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        char msg[64];
-        snprintf(msg, sizeof(msg),
-                 "REFUSED_BY %s\n", g_clients[i].name);
-        send(g_clients[idx].fd, msg, strlen(msg), 0);
-
-        const char *ok = "Challenge refused\n";
-        send(fd, ok, strlen(ok), 0);
-        return;
-    }
-
-    /* ---- ACCEPT <user> ---- */
-    if (strncmp(buf, "ACCEPT ", 7) == 0)
-    {
-        if (g_clients[i].in_game) {
-            const char *msg = "ERROR : You cannot accept while in a game !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        char target[16];
-        if (sscanf(buf + 7, "%15s", target) != 1) {
-            const char *msg = "ERROR : Usage: ACCEPT <user> !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        int idx = client_index_by_name(target);
-        if (idx < 0) {
-            const char *msg = "ERROR : No such user !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        if (g_clients[i].in_game) {
-            const char *msg = "ERROR : You are already in a game !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        if (g_clients[idx].in_game) {
-            char msg[128];
-            snprintf(msg, sizeof(msg),
-                     "ERROR : %s is already in a game !\n", target);
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
+/* =====================================================
+ *                    Boucle principale
+ * ===================================================== */
 
-        games_start(i, idx);
-        return;
+/* Socket d'écoute non bloquante ; SO_REUSEPORT si elle est partagée */
+static int server_listen(int port, int shared)
+{
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
     }
 
-    /* ---- READY ---- */
-    if (strcmp(buf, "READY") == 0)
-    {
-        if (!g_clients[i].in_game) {
-            const char *msg = "ERROR : Not in game !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        g_clients[i].ready = 1;
-        int opp = g_clients[i].opponent_index;
-
-        if (opp >= 0 && g_clients[opp].ready) {
-            int g_idx = games_find_by_player_name(g_clients[i].name);
-            if (g_idx >= 0)
-                games_send_board(&g_games[g_idx]);
-        }
-        return;
+    int one = 1;
+    if (shared && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0) {
+        perror("SO_REUSEPORT");
+        close(fd);
+        return -1;
     }
 
-    /* ---- MOVE <pit> ---- */
-    if (strncmp(buf, "MOVE ", 5) == 0)
-    {
-        int pit;
-        if (sscanf(buf + 5, "%d", &pit) != 1) {
-            const char *msg = "ERROR : Usage: MOVE <0-11> !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port        = htons(port);
 
-        games_process_move(i, pit);
-        return;
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror("bind");
+        close(fd);
+        return -1;
     }
 
-    /* ---- CANCEL_GAME ---- */
-    if (strcmp(buf, "CANCEL_GAME") == 0)
-    {
-        if (!g_clients[i].in_game) {
-            const char *msg = "ERROR : You are not in a game !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        games_cancel_by_client(i, 1);
-
-        const char *ok = "Game canceled. Back to menu.\n";
-        send(fd, ok, strlen(ok), 0);
-        return;
+    if (listen(fd, SOMAXCONN) < 0) {
+        perror("listen");
+        close(fd);
+        return -1;
     }
 
-    /* ---- MESSAGE <user> <message> ---- */
-    if (strncmp(buf, "MESSAGE ", 8) == 0)
-    {
-        char target[16];
-        char body[480];
-        memset(body, 0, sizeof(body));
-
-        if (sscanf(buf + 8, "%15s %479[^\n]", target, body) < 2) {
-            const char *msg =
-                "ERROR : Usage: MESSAGE <user> <message> !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        if (ci_equal(target, g_clients[i].name)) {
-            const char *msg = "ERROR : You cannot message yourself !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        body[479] = '\0';
-
-        int idx = client_index_by_name(target);
-        if (idx < 0) {
-            const char *msg = "ERROR : User not found !\n";
-            send(fd, msg, strlen(msg), 0);
-            return;
-        }
-
-        size_t body_len = strlen(body);
-        if (body_len > 440) body_len = 440;
-
-        char pm[BUF_SIZE];
-        snprintf(pm, sizeof(pm),
-                 "PM from %s: %.*s\n",
-                 g_clients[i].name, (int)body_len, body);
-
-        send(g_clients[idx].fd, pm, strlen(pm), 0);
+    /* accept() en boucle jusqu'à EAGAIN */
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
 
-        const char *ok = "Message sent\n";
-        send(fd, ok, strlen(ok), 0);
-        return;
-    }
+void server_run(ServerConfig *cfg)
+{
+    mkdir("users", 0777);
+    mkdir("saved_games", 0777);
 
-    if (strncmp(buf, "SAY ", 4) == 0)
-    {
-        const char *text = buf + 4;
-        size_t msg_len = strlen(text);
-        if (msg_len > 450) msg_len = 450;
+    /* Un pair parti (client ou bot) fait échouer send(), pas le serveur */
+    signal(SIGPIPE, SIG_IGN);
 
-        char msg[BUF_SIZE];
-        snprintf(msg, sizeof(msg),
-                 "CHAT %s: %.*s\n",
-                 g_clients[i].name, (int)msg_len, text);
+    output_init((size_t)cfg->out_max);
+    timers_config(cfg);
+    rate_config(cfg);
+    bot_config(cfg);
 
-        server_broadcast(msg, fd);
-        return;
+    /* io_uring absent (build, noyau trop ancien, interdit) : epoll */
+    if (cfg->backend == LOOP_URING && uring_probe() < 0) {
+        fprintf(stderr, "WARNING : io_uring unavailable, using epoll\n");
+        cfg->backend = LOOP_EPOLL;
     }
 
-    /* ---- QUIT ---- */
-    if (strcmp(buf, "QUIT") == 0)
-    {
-        server_remove_client(fd);
-        return;
+    if (tables_init(cfg) < 0) {
+        perror("tables_init");
+        exit(EXIT_FAILURE);
     }
 
-    /* ---- UNKNOWN ---- */
-    {
-        const char *msg = "ERROR : Unknown command !\n";
-        send(fd, msg, strlen(msg), 0);
+    if (commands_init() < 0) {
+        fprintf(stderr, "ERROR : command table\n");
+        exit(EXIT_FAILURE);
     }
-}
-
-/* =====================================================
- *                    Boucle principale
- * ===================================================== */
-void server_run(int port)
-{
-    mkdir("users", 0777);
-    mkdir("saved_games", 0777);
 
     g_account_count = accounts_load(USERS_FILE);
 
     srand((unsigned int)time(NULL));
 
-    int server_fd = socket(AF_INET, SOCK_STREAM, 0);
-    if (server_fd < 0) {
-        perror("socket");
-        exit(EXIT_FAILURE);
-    }
-
-    struct sockaddr_in addr;
-    addr.sin_family      = AF_INET;
-    addr.sin_addr.s_addr = INADDR_ANY;
-    addr.sin_port        = htons(port);
+    if (bot_init() < 0)
+        fprintf(stderr, "WARNING : bot opponent unavailable\n");
 
-    if (bind(server_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
-        perror("bind");
-        close(server_fd);
-        exit(EXIT_FAILURE);
+    /* Autant de descripteurs que le système le permet */
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+        rl.rlim_cur = rl.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &rl);
     }
 
-    if (listen(server_fd, 5) < 0) {
-        perror("listen");
-        close(server_fd);
-        exit(EXIT_FAILURE);
+    /* Une socket d'écoute par réacteur : le noyau répartit les connexions */
+    int listen_fds[REACTOR_MAX];
+    for (int k = 0; k < cfg->threads; k++) {
+        listen_fds[k] = server_listen(cfg->port, cfg->threads > 1);
+        if (listen_fds[k] < 0)
+            exit(EXIT_FAILURE);
     }
 
-    FD_ZERO(&g_master_set);
-    FD_SET(server_fd, &g_master_set);
-    g_max_fd = server_fd;
+    printf("Awale server listening on port %d (%s, %d thread%s, up to %d clients, %d games)...\n",
+           cfg->port, loop_backend_name(cfg->backend), cfg->threads, cfg->threads > 1 ? "s" : "",
+           cfg->max_clients, cfg->max_games);
+    fflush(stdout);
 
-    for (int i = 0; i < MAX_CLIENTS; i++)
-        g_clients[i].fd = -1;
-    for (int g = 0; g < MAX_GAMES; g++)
-        g_games[g].active = 0;
+    reactor_run(cfg, listen_fds);
 
-    printf("Awale server listening on port %d...\n", port);
-
-    while (1)
-    {
-        fd_set read_fds = g_master_set;
-
-        if (select(g_max_fd + 1, &read_fds, NULL, NULL, NULL) < 0) {
-            perror("select");
-            break;
-        }
+    for (int k = 0; k < cfg->threads; k++)
+        close(listen_fds[k]);
+}
 
-        for (int i = 0; i <= g_max_fd; i++) {
-            if (FD_ISSET(i, &read_fds)) {
-                if (i == server_fd)
-                    server_handle_new_connection(server_fd);
-                else
-                    server_handle_client_message(i);
-            }
-        }
-    }
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [-c config] [-m max_clients] [-g max_games] [-a max_accounts]"
+            " [-o out_max] [-t threads] [port] [epoll|select|uring]\n", prog);
+}
 
-    close(server_fd);
+/* Entier positif borné pour les options -m, -g, -a, -o, -t */
+static int parse_limit(const char *s, int *out)
+{
+    char *end;
+    long v = strtol(s, &end, 10);
+    if (end == s || *end || v < 1 || v > TABLE_LIMIT)
+        return -1;
+    *out = (int)v;
+    return 0;
 }
 
 int main(int argc, char *argv[])
 {
-    int port = DEFAULT_PORT;
+    ServerConfig cfg;
+    config_defaults(&cfg);
 
-    if (argc > 1) {
-        int parsed_port = atoi(argv[1]);
-        if (parsed_port > 0 && parsed_port < 65536) {
-            port = parsed_port;
+    /* Le fichier de configuration passe avant les autres options */
+    for (int k = 1; k + 1 < argc; k++) {
+        if (strcmp(argv[k], "-c") == 0 && config_load(&cfg, argv[k + 1]) < 0)
+            return EXIT_FAILURE;
+    }
+
+    int opt;
+    while ((opt = getopt(argc, argv, "c:m:g:a:o:t:")) != -1) {
+        int rc = 0;
+        switch (opt) {
+            case 'c': break;
+            case 'm': rc = parse_limit(optarg, &cfg.max_clients);  break;
+            case 'g': rc = parse_limit(optarg, &cfg.max_games);    break;
+            case 'a': rc = parse_limit(optarg, &cfg.max_accounts); break;
+            case 'o': rc = parse_limit(optarg, &cfg.out_max);      break;
+            case 't': rc = parse_limit(optarg, &cfg.threads);      break;
+            default:  rc = -1;                                     break;
+        }
+        if (rc < 0) {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind < argc)
+        cfg.port = atoi(argv[optind++]);
+
+    /* select() reste disponible pour les mesures comparatives, io_uring en option */
+    if (optind < argc) {
+        if (strcmp(argv[optind], "select") == 0) {
+            cfg.backend = LOOP_SELECT;
+        } else if (strcmp(argv[optind], "epoll") == 0) {
+            cfg.backend = LOOP_EPOLL;
+        } else if (strcmp(argv[optind], "uring") == 0) {
+            cfg.backend = LOOP_URING;
         } else {
-            fprintf(stderr, "ERROR : Invalid port number. Must be between 1 and 65535.\n");
-            fprintf(stderr, "Usage: %s [port]\n", argv[0]);
+            usage(argv[0]);
             return EXIT_FAILURE;
         }
     }
 
-    server_run(port);
+    if (config_check(&cfg) < 0) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    server_run(&cfg);
     return 0;
 }
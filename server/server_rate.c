@@ -0,0 +1,177 @@
+/*************************************************************************
+                           Awale -- Game (Server Rate)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Débit des commandes de chaque connexion : un
+                           seau à jetons par classe (chat, lobby,
+                           partie), un nombre de lignes par tour de
+                           boucle, et en surcharge le chat et le lobby
+                           refusés avant les coups
+*************************************************************************/
+
+#include <string.h>
+
+#include "server.h"
+
+/* Un jeton vaut RATE_UNIT unités : à r commandes/s, le seau gagne r unités par ms */
+#define RATE_UNIT  1000u
+
+/* Débits de la configuration (commandes/s, 0 = sans limite) ; fixés avant les réacteurs */
+static unsigned g_rate[RATE_CLASSES];
+
+/* Le hub a exécuté au moins RATE_TURN_LOAD lignes à son dernier tour */
+static _Atomic int g_hub_busy;
+
+/*
+ * Tour de boucle du réacteur courant : numéro, lignes lues sur ses
+ * sockets, lignes exécutées par le hub (hub seulement).
+ */
+static _Thread_local unsigned t_turn;
+static _Thread_local unsigned t_lines;
+static _Thread_local unsigned t_hub_lines;
+
+/* Compteurs du réacteur courant : seul son thread les modifie */
+static void stat_inc(_Atomic uint64_t *v)
+{
+    atomic_store_explicit(v, atomic_load_explicit(v, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+}
+
+/* =====================================================
+ *                   Configuration
+ * ===================================================== */
+void rate_config(const ServerConfig *cfg)
+{
+    g_rate[RATE_CHAT]  = (unsigned)cfg->rate_chat;
+    g_rate[RATE_LOBBY] = (unsigned)cfg->rate_lobby;
+    g_rate[RATE_GAME]  = (unsigned)cfg->rate_game;
+}
+
+/* Réserve pleine d'un seau : RATE_BURST secondes de débit */
+static uint64_t bucket_cap(int cls)
+{
+    return (uint64_t)g_rate[cls] * RATE_BURST * RATE_UNIT;
+}
+
+void rate_reset(Client *c)
+{
+    uint64_t now = timers_now();
+
+    for (int k = 0; k < RATE_CLASSES; k++) {
+        c->rate[k].tokens = bucket_cap(k);
+        c->rate[k].stamp  = now;
+    }
+
+    c->rate_turn  = t_turn;
+    c->turn_lines = 0;
+}
+
+/* =====================================================
+ *                 Lignes par tour
+ * ===================================================== */
+
+/*
+ * Budget du tour épuisé : c attend le tour suivant (loop_defer). Compté
+ * une fois par tour, même si run_deferred le reprend dans ce tour.
+ */
+int rate_spent(Client *c)
+{
+    if (c->rate_turn != t_turn) {
+        c->rate_turn  = t_turn;
+        c->turn_lines = 0;
+    }
+
+    if (c->turn_lines < INPUT_LINE_BUDGET)
+        return 0;
+
+    if (c->turn_lines == INPUT_LINE_BUDGET) {
+        c->turn_lines++;
+        stat_inc(&reactor_stats()->throttled);
+    }
+    return 1;
+}
+
+void rate_count(Client *c)
+{
+    c->turn_lines++;
+    t_lines++;
+}
+
+void rate_hub_line(void)
+{
+    t_hub_lines++;
+}
+
+/* Fin du tour : le hub publie sa charge pour les autres réacteurs */
+void rate_turn(void)
+{
+    if (reactor_self() == REACTOR_HUB) {
+        int busy = (t_hub_lines >= RATE_TURN_LOAD);
+        if (atomic_load_explicit(&g_hub_busy, memory_order_relaxed) != busy)
+            atomic_store_explicit(&g_hub_busy, busy, memory_order_relaxed);
+    }
+
+    t_turn++;
+    t_lines     = 0;
+    t_hub_lines = 0;
+}
+
+/* =====================================================
+ *                  Seaux à jetons
+ * ===================================================== */
+
+/* Un jeton pris dans le seau, remis à jour avec l'heure du tour */
+static int bucket_take(RateBucket *b, int cls)
+{
+    if (g_rate[cls] == 0)
+        return 1;
+
+    uint64_t now    = timers_now();
+    uint64_t cap    = bucket_cap(cls);
+    uint64_t tokens = b->tokens + (now - b->stamp) * g_rate[cls];
+
+    b->stamp = now;
+    if (tokens > cap)
+        tokens = cap;
+
+    if (tokens < RATE_UNIT) {
+        b->tokens = tokens;
+        return 0;
+    }
+
+    b->tokens = tokens - RATE_UNIT;
+    return 1;
+}
+
+/*
+ * Ligne de c admise (1) ou refusée (0, réponse déjà en file, en trame
+ * TEXT pour un client PROTO_BIN). Appelé par le réacteur de c avant de
+ * router la ligne : une commande refusée ne coûte ni message au hub,
+ * ni diffusion.
+ */
+int rate_admit(Client *c, const char *line)
+{
+    int cls = commands_class(line);
+    if (cls == RATE_NONE)
+        return 1;
+
+    /* Surcharge : le chat et le lobby cèdent la place aux coups */
+    if (cls != RATE_GAME &&
+        (t_lines > RATE_TURN_LOAD ||
+         atomic_load_explicit(&g_hub_busy, memory_order_relaxed))) {
+        const char *msg = "ERROR : Server busy, try again later !\n";
+        output_send(c, msg, strlen(msg), 0);
+        stat_inc(&reactor_stats()->shed);
+        return 0;
+    }
+
+    if (!bucket_take(&c->rate[cls], cls)) {
+        const char *msg = "ERROR : Too many commands, slow down !\n";
+        output_send(c, msg, strlen(msg), 0);
+        stat_inc(&reactor_stats()->rejected);
+        return 0;
+    }
+    return 1;
+}
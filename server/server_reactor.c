@@ -0,0 +1,662 @@
+/*************************************************************************
+                           Awale -- Game (Server Reactors)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Plusieurs boucles d'événements, une par thread :
+                           chaque réacteur possède ses connexions et les
+                           parties qu'il exécute, le hub possède les
+                           sessions ; ils ne communiquent que par lots de
+                           messages et par boîtes aux lettres sans verrou
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+
+#include "server.h"
+
+/*
+ * Un message voyage dans un lot (Batch) : en-tête, puis len octets de
+ * données, le tout aligné sur 8. Un thread remplit un lot par
+ * destinataire pendant son tour et le poste en fin de tour, ou dès
+ * qu'il dépasse BATCH_SIZE : un verrou et un réveil par lot, pas par
+ * message.
+ */
+#define BATCH_SIZE  (64 * 1024)
+
+enum {
+    /* réacteur → hub */
+    MSG_ATTACH,         /* nouvelle connexion */
+    MSG_LINE,           /* ligne reçue (terminée par \0) */
+    MSG_LONG_LINE,      /* ligne trop longue, jetée */
+    MSG_DETACH,         /* connexion perdue */
+    /* hub ou exécuteur → réacteur */
+    MSG_OUTPUT,         /* octets à écrire (count : SEND_*) */
+    MSG_OUTPUT_BUF,     /* OutBuf à mettre en file, une référence (count : SEND_*) */
+    MSG_CLOSE,          /* session refermée : fermer la connexion */
+    MSG_RELEASE,        /* réponse à MSG_DETACH : le slot peut être rendu */
+    MSG_BIND,           /* connexion liée à une partie, ou déliée */
+    MSG_ACK,            /* count lignes transmises ont été traitées */
+    /* exécuteur → hub */
+    MSG_GAME_OVER       /* partie terminée */
+};
+
+typedef struct {
+    Client  *c;
+    uint32_t len;
+    uint32_t serial;    /* MSG_OUTPUT*, MSG_BIND, MSG_ACK : connexion visée */
+    uint32_t count;     /* MSG_ACK ; MSG_OUTPUT : SEND_* */
+    uint8_t  type;
+    uint8_t  from;
+} MsgHeader;
+
+/* Données de MSG_BIND et MSG_GAME_OVER */
+typedef struct {
+    int      game;
+    unsigned gen;
+    int      bound;
+} MsgGame;
+
+typedef struct Batch {
+    struct Batch *next;
+    size_t        len;
+    size_t        last;     /* début du dernier message */
+    size_t        cap;
+    char          data[];
+} Batch;
+
+/*
+ * Boîtes aux lettres : liste de lots protégée par un verrou, et pile
+ * d'événements de parties sans verrou (plusieurs producteurs, un seul
+ * consommateur qui la prend d'un bloc). Réveil par eventfd quand l'une
+ * passe de vide à non vide.
+ */
+typedef struct {
+    int                   id;
+    int                   listen_fd;
+    int                   wake_fd;
+    pthread_mutex_t       lock;
+    Batch                *head;
+    Batch                *tail;
+    _Atomic(GameEvent *)  events;
+    OutputStats           stats;
+    int                   backend;
+} Reactor;
+
+static Reactor g_reactors[REACTOR_MAX];
+static int     g_reactor_count = 1;
+
+static _Thread_local Reactor *t_self = &g_reactors[REACTOR_HUB];
+
+/* Lots en cours de remplissage, un par destinataire */
+static _Thread_local Batch  *t_out[REACTOR_MAX];
+
+/* Slots dont la connexion est fermée, rendus en fin de tour */
+static _Thread_local Client *t_dead = NULL;
+
+int reactor_self(void)
+{
+    return t_self->id;
+}
+
+int reactor_count(void)
+{
+    return g_reactor_count;
+}
+
+OutputStats *reactor_stats(void)
+{
+    return &t_self->stats;
+}
+
+void reactor_stats_sum(OutputStats *sum)
+{
+    memset(sum, 0, sizeof(*sum));
+
+    for (int k = 0; k < g_reactor_count; k++) {
+        OutputStats *st = &g_reactors[k].stats;
+        uint64_t peak = atomic_load_explicit(&st->peak, memory_order_relaxed);
+
+        sum->queued  += atomic_load_explicit(&st->queued,  memory_order_relaxed);
+        sum->stalled += atomic_load_explicit(&st->stalled, memory_order_relaxed);
+        sum->paused  += atomic_load_explicit(&st->paused,  memory_order_relaxed);
+        sum->dropped += atomic_load_explicit(&st->dropped, memory_order_relaxed);
+        sum->kicked  += atomic_load_explicit(&st->kicked,  memory_order_relaxed);
+        sum->syscalls += atomic_load_explicit(&st->syscalls, memory_order_relaxed);
+        sum->rejected += atomic_load_explicit(&st->rejected, memory_order_relaxed);
+        sum->shed     += atomic_load_explicit(&st->shed,     memory_order_relaxed);
+        sum->throttled += atomic_load_explicit(&st->throttled, memory_order_relaxed);
+        if (peak > sum->peak)
+            sum->peak = peak;
+    }
+}
+
+/* Seul le thread du réacteur écrit ses compteurs */
+void reactor_syscall(void)
+{
+    _Atomic uint64_t *v = &t_self->stats.syscalls;
+    atomic_store_explicit(v, atomic_load_explicit(v, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+}
+
+/* =====================================================
+ *                   Lots de messages
+ * ===================================================== */
+
+static size_t msg_size(size_t len)
+{
+    return (sizeof(MsgHeader) + len + 7) & ~(size_t)7;
+}
+
+static void reactor_wake(Reactor *r)
+{
+    uint64_t one = 1;
+    reactor_syscall();
+    if (write(r->wake_fd, &one, sizeof(one)) < 0)
+        perror("reactor wake");
+}
+
+static void batch_post(int to)
+{
+    Batch *b = t_out[to];
+    if (!b)
+        return;
+    t_out[to] = NULL;
+
+    Reactor *r = &g_reactors[to];
+    b->next = NULL;
+
+    pthread_mutex_lock(&r->lock);
+    int was_empty = (r->head == NULL);
+    if (r->tail)
+        r->tail->next = b;
+    else
+        r->head = b;
+    r->tail = b;
+    pthread_mutex_unlock(&r->lock);
+
+    /* Un seul réveil tant que le destinataire n'a pas vidé sa boîte */
+    if (was_empty)
+        reactor_wake(r);
+}
+
+/*
+ * Ajoute un message au lot destiné à to. Un message qui ne trouve pas
+ * de mémoire est perdu : la connexion concernée finira par être vue
+ * fermée ou trop lente.
+ */
+static MsgHeader *msg_append(int to, int type, Client *c, uint32_t serial,
+                             const void *data, size_t len)
+{
+    size_t need = msg_size(len);
+    Batch *b    = t_out[to];
+
+    if (b && b->len + need > b->cap) {
+        batch_post(to);
+        b = NULL;
+    }
+
+    if (!b) {
+        size_t cap = (need > BATCH_SIZE) ? need : BATCH_SIZE;
+        b = malloc(sizeof(Batch) + cap);
+        if (!b) {
+            perror("malloc");
+            return NULL;
+        }
+        b->next = NULL;
+        b->len  = 0;
+        b->cap  = cap;
+        t_out[to] = b;
+    }
+
+    MsgHeader *h = (MsgHeader *)(b->data + b->len);
+    h->c      = c;
+    h->len    = (uint32_t)len;
+    h->serial = serial;
+    h->count  = 0;
+    h->type   = (uint8_t)type;
+    h->from   = (uint8_t)t_self->id;
+    if (len)
+        memcpy(h + 1, data, len);
+
+    b->last = b->len;
+    b->len += need;
+    return h;
+}
+
+/* =====================================================
+ *               Cycle de vie des connexions
+ * ===================================================== */
+
+/*
+ * Ferme la socket de c (après un dernier envoi au mieux) et met le slot
+ * de côté : il n'est rendu qu'en fin de tour, quand c ne figure plus
+ * dans aucune liste de la boucle.
+ */
+static void conn_finish(Client *c)
+{
+    if (c->fd < 0)
+        return;
+
+    c->in_paused = 0;
+    if (!c->closing && !c->lost)
+        output_flush(c);
+    output_reset(c);
+
+    if (!c->lost)
+        loop_del(c);
+    close(c->fd);
+
+    c->fd        = -1;
+    c->closing   = 0;
+    c->lost      = 0;
+    c->play_game = -1;
+    c->in_flight = 0;
+    input_reset(c);
+
+    c->dead_next = t_dead;
+    t_dead       = c;
+}
+
+void reactor_attach(Client *c)
+{
+    if (t_self->id == REACTOR_HUB)
+        server_attach(c, REACTOR_HUB);
+    else
+        msg_append(REACTOR_HUB, MSG_ATTACH, c, 0, NULL, 0);
+}
+
+void reactor_forward(Client *c, const char *line)
+{
+    c->in_flight++;
+
+    if (line)
+        msg_append(REACTOR_HUB, MSG_LINE, c, 0, line, strlen(line) + 1);
+    else
+        msg_append(REACTOR_HUB, MSG_LONG_LINE, c, 0, NULL, 0);
+}
+
+/*
+ * La socket n'est fermée qu'une fois la session refermée par le hub :
+ * jusque-là, son numéro ne peut pas être repris par une autre
+ * connexion, et l'index socket → client du hub reste juste.
+ */
+void reactor_lost(Client *c)
+{
+    if (c->fd < 0 || c->lost)
+        return;
+
+    loop_del(c);
+    c->lost = 1;
+
+    if (t_self->id == REACTOR_HUB) {
+        if (c->attached)
+            server_detach(c);
+        conn_finish(c);
+    } else {
+        msg_append(REACTOR_HUB, MSG_DETACH, c, 0, NULL, 0);
+    }
+}
+
+ClientRef reactor_ref(Client *c)
+{
+    ClientRef r = {
+        c, atomic_load_explicit(&c->serial, memory_order_relaxed), c->home
+    };
+    return r;
+}
+
+/* Vrai si la référence désigne toujours la connexion du slot (son réacteur) */
+static int ref_live(const Client *c, uint32_t serial)
+{
+    return atomic_load_explicit(&c->serial, memory_order_relaxed) == serial;
+}
+
+void reactor_send(ClientRef to, const char *msg, size_t len, int flags)
+{
+    if (to.home == t_self->id) {
+        if (ref_live(to.c, to.serial))
+            output_send(to.c, msg, len, flags);
+        return;
+    }
+
+    MsgHeader *h = msg_append(to.home, MSG_OUTPUT, to.c, to.serial, msg, len);
+    if (h)
+        h->count = (uint32_t)flags;
+}
+
+void reactor_send_buf(ClientRef to, OutBuf *b, int flags)
+{
+    if (to.home == t_self->id) {
+        if (ref_live(to.c, to.serial)) {
+            outbuf_retain(b);
+            output_send_buf(to.c, b, flags);
+        }
+        return;
+    }
+
+    /* Seul le pointeur voyage ; la référence est rendue par la file */
+    outbuf_retain(b);
+    MsgHeader *h = msg_append(to.home, MSG_OUTPUT_BUF, to.c, to.serial, &b, sizeof(b));
+    if (h)
+        h->count = (uint32_t)flags;
+    else
+        outbuf_release(b);
+}
+
+int reactor_binary(ClientRef to)
+{
+    return atomic_load_explicit(&to.c->proto, memory_order_relaxed) == PROTO_BIN;
+}
+
+int reactor_deltas(ClientRef to)
+{
+    return atomic_load_explicit(&to.c->deltas, memory_order_relaxed);
+}
+
+void reactor_close(Client *c)
+{
+    if (c->home == t_self->id)
+        conn_finish(c);
+    else
+        msg_append(c->home, MSG_CLOSE, c, 0, NULL, 0);
+}
+
+/* =====================================================
+ *              Parties (exécuteurs)
+ * ===================================================== */
+
+void reactor_post(int to, const GameEvent *ev)
+{
+    if (to == t_self->id) {
+        games_execute(ev);
+        return;
+    }
+
+    GameEvent *copy = malloc(sizeof(*copy));
+    if (!copy) {
+        perror("malloc");
+        return;
+    }
+    *copy = *ev;
+
+    /* Empilement sans verrou : seul celui qui trouve la pile vide réveille */
+    Reactor   *r    = &g_reactors[to];
+    GameEvent *head = atomic_load_explicit(&r->events, memory_order_relaxed);
+    do {
+        copy->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&r->events, &head, copy,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+    if (!head)
+        reactor_wake(r);
+}
+
+static void bind_apply(Client *c, const MsgGame *b)
+{
+    if (b->bound) {
+        c->play_game = b->game;
+        c->play_gen  = b->gen;
+    } else if (c->play_game == b->game && c->play_gen == b->gen) {
+        /* Une liaison plus récente (autre partie) est conservée */
+        c->play_game = -1;
+    }
+}
+
+void reactor_bind(ClientRef to, int game, unsigned gen, int bound)
+{
+    MsgGame b = { game, gen, bound };
+
+    if (to.home != t_self->id)
+        msg_append(to.home, MSG_BIND, to.c, to.serial, &b, sizeof(b));
+    else if (ref_live(to.c, to.serial))
+        bind_apply(to.c, &b);
+}
+
+static void ack_apply(Client *c, uint32_t count)
+{
+    c->in_flight -= count;
+    input_resume(c);
+}
+
+/* Les accusés consécutifs pour une même connexion tiennent en un message */
+void reactor_ack(ClientRef to)
+{
+    if (to.home == t_self->id) {
+        if (ref_live(to.c, to.serial))
+            ack_apply(to.c, 1);
+        return;
+    }
+
+    Batch *b = t_out[to.home];
+    if (b && b->len) {
+        MsgHeader *h = (MsgHeader *)(b->data + b->last);
+        if (h->type == MSG_ACK && h->c == to.c && h->serial == to.serial) {
+            h->count++;
+            return;
+        }
+    }
+
+    MsgHeader *h = msg_append(to.home, MSG_ACK, to.c, to.serial, NULL, 0);
+    if (h)
+        h->count = 1;
+}
+
+/*
+ * Posté sans attendre la fin du tour : le hub délie les joueurs avant
+ * que GAME_END ne leur parvienne, et leur commande suivante les trouve
+ * libres.
+ */
+void reactor_game_over(int game, unsigned gen)
+{
+    if (t_self->id == REACTOR_HUB) {
+        games_over(game, gen);
+        return;
+    }
+
+    MsgGame b = { game, gen, 0 };
+    msg_append(REACTOR_HUB, MSG_GAME_OVER, NULL, 0, &b, sizeof(b));
+    batch_post(REACTOR_HUB);
+}
+
+/* =====================================================
+ *                 Réception des messages
+ * ===================================================== */
+static void msg_dispatch(MsgHeader *h)
+{
+    Client *c = h->c;
+
+    switch (h->type) {
+        case MSG_ATTACH:
+            server_attach(c, h->from);
+            break;
+
+        case MSG_LINE:
+        case MSG_LONG_LINE: {
+            ClientRef from = {
+                c, atomic_load_explicit(&c->serial, memory_order_relaxed), h->from
+            };
+
+            /* Lignes d'une connexion dont la session est déjà refermée */
+            if (c->attached && c->home == h->from)
+                server_handle_line(c, h->type == MSG_LINE ? (char *)(h + 1) : NULL);
+            reactor_ack(from);
+            break;
+        }
+
+        case MSG_DETACH:
+            if (c->attached && c->home == h->from)
+                server_detach(c);
+            msg_append(h->from, MSG_RELEASE, c, 0, NULL, 0);
+            break;
+
+        case MSG_OUTPUT:
+            if (ref_live(c, h->serial))
+                output_send(c, (const char *)(h + 1), h->len, (int)h->count);
+            break;
+
+        case MSG_OUTPUT_BUF: {
+            OutBuf *b;
+            memcpy(&b, h + 1, sizeof(b));
+            if (ref_live(c, h->serial))
+                output_send_buf(c, b, (int)h->count);
+            else
+                outbuf_release(b);
+            break;
+        }
+
+        case MSG_CLOSE:
+            /* Croisement avec MSG_DETACH : MSG_RELEASE suivra */
+            if (!c->lost)
+                conn_finish(c);
+            break;
+
+        case MSG_RELEASE:
+            conn_finish(c);
+            break;
+
+        case MSG_BIND:
+            if (ref_live(c, h->serial))
+                bind_apply(c, (const MsgGame *)(h + 1));
+            break;
+
+        case MSG_ACK:
+            if (ref_live(c, h->serial))
+                ack_apply(c, h->count);
+            break;
+
+        case MSG_GAME_OVER: {
+            const MsgGame *b = (const MsgGame *)(h + 1);
+            games_over(b->game, b->gen);
+            break;
+        }
+    }
+}
+
+/* Prend toute la pile d'événements, remise dans l'ordre d'arrivée */
+static void events_drain(Reactor *r)
+{
+    GameEvent *ev   = atomic_exchange_explicit(&r->events, NULL, memory_order_acquire);
+    GameEvent *fifo = NULL;
+
+    while (ev) {
+        GameEvent *next = ev->next;
+        ev->next = fifo;
+        fifo     = ev;
+        ev       = next;
+    }
+
+    while (fifo) {
+        GameEvent *next = fifo->next;
+        games_execute(fifo);
+        free(fifo);
+        fifo = next;
+    }
+}
+
+void reactor_drain(void)
+{
+    Reactor *r = t_self;
+    uint64_t n;
+
+    /* Remet le compteur à zéro ; les lots sont pris d'un bloc */
+    reactor_syscall();
+    if (read(r->wake_fd, &n, sizeof(n)) < 0 && errno != EAGAIN)
+        perror("reactor drain");
+
+    pthread_mutex_lock(&r->lock);
+    Batch *b = r->head;
+    r->head = r->tail = NULL;
+    pthread_mutex_unlock(&r->lock);
+
+    while (b) {
+        Batch *next = b->next;
+
+        for (size_t off = 0; off < b->len; ) {
+            MsgHeader *h = (MsgHeader *)(b->data + off);
+            off += msg_size(h->len);
+            msg_dispatch(h);
+        }
+
+        free(b);
+        b = next;
+    }
+
+    events_drain(r);
+}
+
+void reactor_flush(void)
+{
+    for (int to = 0; to < g_reactor_count; to++)
+        batch_post(to);
+
+    Client *c = t_dead;
+    t_dead = NULL;
+
+    while (c) {
+        Client *next = c->dead_next;
+        client_release((int)(c - g_clients));
+        c = next;
+    }
+}
+
+/* =====================================================
+ *                       Threads
+ * ===================================================== */
+static void reactor_loop(Reactor *r)
+{
+    t_self = r;
+
+    if (loop_init(r->backend, r->listen_fd,
+                  g_reactor_count > 1 ? r->wake_fd : -1) < 0) {
+        perror("loop_init");
+        exit(EXIT_FAILURE);
+    }
+
+    loop_run();
+}
+
+static void *reactor_thread(void *arg)
+{
+    reactor_loop(arg);
+    return NULL;
+}
+
+void reactor_run(const ServerConfig *cfg, const int *listen_fds)
+{
+    g_reactor_count = cfg->threads;
+
+    for (int k = 0; k < g_reactor_count; k++) {
+        Reactor *r   = &g_reactors[k];
+        r->id        = k;
+        r->backend   = cfg->backend;
+        r->listen_fd = listen_fds[k];
+        r->wake_fd   = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        pthread_mutex_init(&r->lock, NULL);
+        atomic_init(&r->events, NULL);
+
+        if (r->wake_fd < 0) {
+            perror("eventfd");
+            return;
+        }
+    }
+
+    for (int k = 1; k < g_reactor_count; k++) {
+        pthread_t tid;
+        if (pthread_create(&tid, NULL, reactor_thread, &g_reactors[k]) != 0) {
+            perror("pthread_create");
+            return;
+        }
+        pthread_detach(tid);
+    }
+
+    reactor_loop(&g_reactors[REACTOR_HUB]);
+}
@@ -0,0 +1,238 @@
+/*************************************************************************
+                           Awale -- Game (Server Tables)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Tables des clients, parties et comptes :
+                           dimensionnées au lancement, agrandies à la
+                           demande, slots recyclés par pile de libres
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "server.h"
+
+/* ================================================================
+ *  Variables globales
+ * ================================================================ */
+
+Client      *g_clients       = NULL;
+_Atomic int  g_client_cap    = 0;
+Game    *g_games         = NULL;
+int      g_game_cap      = 0;
+Account *g_accounts      = NULL;
+int      g_account_count = 0;
+
+/* Tout réacteur prend et rend des slots clients : pile sous verrou */
+static pthread_mutex_t g_client_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int  g_client_max   = 0;
+static int *g_client_free  = NULL;    /* pile des slots libres */
+static int  g_client_nfree = 0;
+
+static int  g_game_max     = 0;
+static int *g_game_free    = NULL;
+static int  g_game_nfree   = 0;
+
+static int  g_account_cap  = 0;
+static int  g_account_max  = 0;
+
+/* =====================================================
+ *                    Utilitaires
+ * ===================================================== */
+
+/* Capacité suivante : double, sans dépasser max */
+static int next_cap(int cap, int max)
+{
+    if (cap >= max)
+        return cap;
+    return (cap > max / 2) ? max : (cap ? cap * 2 : 1);
+}
+
+/*
+ * Empile les slots [from, to) du plus grand au plus petit : les index
+ * bas sont repris en premier.
+ */
+static void push_range(int *stack, int *count, int from, int to)
+{
+    for (int i = to - 1; i >= from; i--)
+        stack[(*count)++] = i;
+}
+
+/* =====================================================
+ *                       Clients
+ * ===================================================== */
+
+/*
+ * Les clients vivent dans une plage d'adresses réservée pour
+ * max_clients dès le lancement (MAP_NORESERVE : seules les pages
+ * touchées occupent de la mémoire). Grandir ne déplace donc jamais un
+ * Client, dont l'adresse est mémorisée par epoll. Les nouveaux slots
+ * sont prêts avant que g_client_cap ne les publie.
+ */
+static int clients_grow(int cap)
+{
+    int old = atomic_load_explicit(&g_client_cap, memory_order_relaxed);
+    if (cap <= old)
+        return -1;
+
+    int *stack = realloc(g_client_free, (size_t)cap * sizeof(int));
+    if (!stack)
+        return -1;
+    g_client_free = stack;
+
+    for (int i = old; i < cap; i++) {
+        memset(&g_clients[i], 0, sizeof(Client));
+        g_clients[i].fd             = -1;
+        g_clients[i].opponent_index = -1;
+        g_clients[i].player_index   = -1;
+        g_clients[i].game_index     = -1;
+        g_clients[i].observing      = -1;
+        g_clients[i].play_game      = -1;
+    }
+
+    push_range(g_client_free, &g_client_nfree, old, cap);
+    atomic_store_explicit(&g_client_cap, cap, memory_order_release);
+    return 0;
+}
+
+int client_alloc(void)
+{
+    int slot = -1;
+
+    pthread_mutex_lock(&g_client_lock);
+    if (g_client_nfree > 0 ||
+        clients_grow(next_cap(g_client_cap, g_client_max)) == 0)
+        slot = g_client_free[--g_client_nfree];
+    pthread_mutex_unlock(&g_client_lock);
+
+    return slot;
+}
+
+void client_release(int i)
+{
+    if (i < 0 || i >= g_client_cap)
+        return;
+
+    /* Les messages encore en route pour cette connexion seront jetés */
+    g_clients[i].fd = -1;
+    atomic_fetch_add_explicit(&g_clients[i].serial, 1, memory_order_relaxed);
+
+    pthread_mutex_lock(&g_client_lock);
+    g_client_free[g_client_nfree++] = i;
+    pthread_mutex_unlock(&g_client_lock);
+}
+
+/* =====================================================
+ *                       Parties
+ * ===================================================== */
+
+/*
+ * Comme les clients, les parties vivent dans une plage réservée pour
+ * max_games : l'exécuteur d'une partie la joue pendant que le hub
+ * agrandit la table.
+ */
+static int games_grow(int cap)
+{
+    if (cap <= g_game_cap)
+        return -1;
+
+    int *stack = realloc(g_game_free, (size_t)cap * sizeof(int));
+    if (!stack)
+        return -1;
+    g_game_free = stack;
+
+    memset(&g_games[g_game_cap], 0, (size_t)(cap - g_game_cap) * sizeof(Game));
+
+    push_range(g_game_free, &g_game_nfree, g_game_cap, cap);
+    g_game_cap = cap;
+    return 0;
+}
+
+int game_alloc(void)
+{
+    if (g_game_nfree == 0 &&
+        games_grow(next_cap(g_game_cap, g_game_max)) < 0)
+        return -1;
+
+    return g_game_free[--g_game_nfree];
+}
+
+/*
+ * Le slot peut être repris tout de suite : l'exécuteur traite ses
+ * événements dans l'ordre, et ceux de l'ancienne partie ne portent plus
+ * le bon gen. Un observateur garde un observing périmé, sans effet.
+ */
+void game_release(int g)
+{
+    if (g < 0 || g >= g_game_cap || !g_games[g].active)
+        return;
+
+    g_games[g].active = 0;
+    g_game_free[g_game_nfree++] = g;
+}
+
+/* =====================================================
+ *                       Comptes
+ * ===================================================== */
+
+int account_alloc(void)
+{
+    if (g_account_count == g_account_cap) {
+        int cap = next_cap(g_account_cap, g_account_max);
+        if (cap == g_account_cap)
+            return -1;
+
+        Account *acc = realloc(g_accounts, (size_t)cap * sizeof(Account));
+        if (!acc)
+            return -1;
+
+        g_accounts    = acc;
+        g_account_cap = cap;
+    }
+
+    Account *a = &g_accounts[g_account_count];
+    memset(a, 0, sizeof(*a));
+    return g_account_count++;
+}
+
+/* =====================================================
+ *                    Initialisation
+ * ===================================================== */
+int tables_init(const ServerConfig *cfg)
+{
+    g_client_max = cfg->max_clients;
+    g_game_max   = cfg->max_games;
+
+    void *map = mmap(NULL, (size_t)g_client_max * sizeof(Client),
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (map == MAP_FAILED)
+        return -1;
+    g_clients = map;
+
+    map = mmap(NULL, (size_t)g_game_max * sizeof(Game),
+               PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (map == MAP_FAILED)
+        return -1;
+    g_games = map;
+
+    if (clients_grow(cfg->clients) < 0 || games_grow(cfg->games) < 0)
+        return -1;
+
+    g_account_max = cfg->max_accounts;
+    g_account_cap = cfg->accounts;
+    g_accounts    = malloc((size_t)g_account_cap * sizeof(Account));
+    if (!g_accounts)
+        return -1;
+
+    return 0;
+}
@@ -0,0 +1,345 @@
+/*************************************************************************
+                           Awale -- Game (Server Timers)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Roue hiérarchique de minuteurs, une par
+                           réacteur : armer, annuler et déclencher en
+                           O(1) ; l'échéance la plus proche donne le
+                           délai d'attente de la boucle d'événements.
+                           Délais de connexion, d'inactivité, de READY
+                           et de partie abandonnée.
+*************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+
+#include "server.h"
+
+/*
+ * Quatre niveaux : le premier a une case par tick (256 ticks), chacun
+ * des suivants une case par tour complet du niveau d'en dessous. Un
+ * minuteur est rangé au niveau qui couvre son échéance, puis redescend
+ * d'un niveau (cascade) quand la roue atteint sa case : armer et
+ * annuler ne touchent qu'une liste, et chaque minuteur cascade au plus
+ * trois fois.
+ */
+#define WHEEL_BITS0    8
+#define WHEEL_BITS     6
+#define WHEEL_SLOTS0   (1 << WHEEL_BITS0)
+#define WHEEL_SLOTS    (1 << WHEEL_BITS)
+#define WHEEL_LEVELS   3                  /* niveaux au-dessus du premier */
+#define WHEEL_RANGE    (1ull << (WHEEL_BITS0 + WHEEL_LEVELS * WHEEL_BITS))
+
+/*
+ * Roue d'un réacteur :
+ *  now_ns : heure monotone lue au dernier timers_run (ns)
+ *  now_ms : la même en ms
+ *  next   : prochain tick à traiter
+ *  count  : minuteurs armés
+ *  slot0  : premier niveau, case = échéance & (WHEEL_SLOTS0 - 1)
+ *  slots  : niveaux suivants
+ *  used0/used : cases non vides (bits), pour trouver la prochaine
+ *           échéance sans parcourir la roue
+ */
+typedef struct {
+    uint64_t now_ns;
+    uint64_t now_ms;
+    uint64_t next;
+    unsigned count;
+    Timer   *slot0[WHEEL_SLOTS0];
+    Timer   *slots[WHEEL_LEVELS][WHEEL_SLOTS];
+    uint64_t used0[WHEEL_SLOTS0 / 64];
+    uint64_t used[WHEEL_LEVELS];
+} Wheel;
+
+static _Thread_local Wheel t_wheel;
+
+/* Délais en ms (TIMEOUT_*), 0 = jamais ; fixés avant les réacteurs */
+static unsigned g_timeout_ms[TIMEOUT_COUNT];
+
+static uint64_t clock_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t clock_ms(void)
+{
+    return clock_ns() / 1000000u;
+}
+
+/* =====================================================
+ *                   Configuration
+ * ===================================================== */
+void timers_config(const ServerConfig *cfg)
+{
+    g_timeout_ms[TIMEOUT_LOGIN] = (unsigned)cfg->login_timeout * 1000u;
+    g_timeout_ms[TIMEOUT_IDLE]  = (unsigned)cfg->idle_timeout * 1000u;
+    g_timeout_ms[TIMEOUT_READY] = (unsigned)cfg->ready_timeout * 1000u;
+    g_timeout_ms[TIMEOUT_GAME]  = (unsigned)cfg->game_timeout * 1000u;
+}
+
+unsigned timeout_ms(int which)
+{
+    return g_timeout_ms[which];
+}
+
+void timers_init(void)
+{
+    Wheel *w = &t_wheel;
+
+    memset(w, 0, sizeof(*w));
+    w->now_ns = clock_ns();
+    w->now_ms = w->now_ns / 1000000u;
+    w->next   = w->now_ms / TIMER_TICK_MS;
+}
+
+uint64_t timers_now(void)
+{
+    return t_wheel.now_ms;
+}
+
+uint64_t timers_now_ns(void)
+{
+    return t_wheel.now_ns;
+}
+
+/* =====================================================
+ *                 Listes de la roue
+ * ===================================================== */
+
+/* Case numéro slot : 0..255 au premier niveau, puis 64 par niveau */
+static Timer **wheel_slot(Wheel *w, unsigned slot)
+{
+    if (slot < WHEEL_SLOTS0)
+        return &w->slot0[slot];
+
+    slot -= WHEEL_SLOTS0;
+    return &w->slots[slot / WHEEL_SLOTS][slot % WHEEL_SLOTS];
+}
+
+static void wheel_mark(Wheel *w, unsigned slot, int used)
+{
+    uint64_t *word;
+    unsigned  bit;
+
+    if (slot < WHEEL_SLOTS0) {
+        word = &w->used0[slot / 64];
+        bit  = slot % 64;
+    } else {
+        slot -= WHEEL_SLOTS0;
+        word = &w->used[slot / WHEEL_SLOTS];
+        bit  = slot % WHEEL_SLOTS;
+    }
+
+    if (used)
+        *word |= 1ull << bit;
+    else
+        *word &= ~(1ull << bit);
+}
+
+static void wheel_link(Wheel *w, Timer *t)
+{
+    uint64_t expires = t->expires;
+    uint64_t delta   = expires - w->next;
+    unsigned slot;
+
+    if ((int64_t)delta < 0) {
+        /* Échéance passée : au prochain tick traité */
+        slot = (unsigned)(w->next & (WHEEL_SLOTS0 - 1));
+    } else if (delta < WHEEL_SLOTS0) {
+        slot = (unsigned)(expires & (WHEEL_SLOTS0 - 1));
+    } else {
+        if (delta >= WHEEL_RANGE) {
+            /* Au-delà de la roue : repoussé à sa limite */
+            expires    = w->next + WHEEL_RANGE - 1;
+            t->expires = expires;
+            delta      = WHEEL_RANGE - 1;
+        }
+
+        int level = 1;
+        while (delta >= 1ull << (WHEEL_BITS0 + level * WHEEL_BITS))
+            level++;
+
+        unsigned shift = WHEEL_BITS0 + (unsigned)(level - 1) * WHEEL_BITS;
+        slot = WHEEL_SLOTS0 + (unsigned)(level - 1) * WHEEL_SLOTS +
+               (unsigned)((expires >> shift) & (WHEEL_SLOTS - 1));
+    }
+
+    Timer **head = wheel_slot(w, slot);
+
+    t->slot  = slot;
+    t->next  = *head;
+    t->pprev = head;
+    if (*head)
+        (*head)->pprev = &t->next;
+    *head = t;
+
+    wheel_mark(w, slot, 1);
+}
+
+static void wheel_unlink(Wheel *w, Timer *t)
+{
+    *t->pprev = t->next;
+    if (t->next)
+        t->next->pprev = t->pprev;
+
+    if (!*wheel_slot(w, t->slot))
+        wheel_mark(w, t->slot, 0);
+
+    t->next  = NULL;
+    t->pprev = NULL;
+}
+
+/* =====================================================
+ *                  Armer / annuler
+ * ===================================================== */
+void timer_arm(Timer *t, uint64_t when_ms, void (*fn)(Timer *t))
+{
+    Wheel *w = &t_wheel;
+
+    if (t->pprev)
+        wheel_unlink(w, t);
+    else
+        w->count++;
+
+    t->fn      = fn;
+    t->expires = (when_ms + TIMER_TICK_MS - 1) / TIMER_TICK_MS;
+    wheel_link(w, t);
+}
+
+void timer_cancel(Timer *t)
+{
+    if (!t->pprev)
+        return;
+
+    wheel_unlink(&t_wheel, t);
+    t_wheel.count--;
+}
+
+/* =====================================================
+ *                 Avancer la roue
+ * ===================================================== */
+
+/* Case index du niveau level redescendue : chaque minuteur est reclassé */
+static unsigned wheel_cascade(Wheel *w, int level, unsigned index)
+{
+    unsigned slot = WHEEL_SLOTS0 + (unsigned)(level - 1) * WHEEL_SLOTS + index;
+    Timer  **head = wheel_slot(w, slot);
+    Timer   *t    = *head;
+
+    *head = NULL;
+    wheel_mark(w, slot, 0);
+
+    while (t) {
+        Timer *next = t->next;
+        wheel_link(w, t);
+        t = next;
+    }
+    return index;
+}
+
+void timers_run(void)
+{
+    timers_run_at(clock_ns());
+}
+
+void timers_run_at(uint64_t now_ns)
+{
+    Wheel *w = &t_wheel;
+
+    w->now_ns = now_ns;
+    w->now_ms = w->now_ns / 1000000u;
+    uint64_t now = w->now_ms / TIMER_TICK_MS;
+
+    /* Roue vide : rien à parcourir, elle repart de maintenant */
+    if (w->count == 0) {
+        if ((int64_t)(now - w->next) >= 0)
+            w->next = now + 1;
+        return;
+    }
+
+    while ((int64_t)(now - w->next) >= 0) {
+        unsigned index = (unsigned)(w->next & (WHEEL_SLOTS0 - 1));
+
+        /* Tour complet d'un niveau : une case du niveau supérieur redescend */
+        for (int level = 1; index == 0 && level <= WHEEL_LEVELS; level++) {
+            unsigned shift = WHEEL_BITS0 + (unsigned)(level - 1) * WHEEL_BITS;
+            if (wheel_cascade(w, level, (unsigned)((w->next >> shift) & (WHEEL_SLOTS - 1))) != 0)
+                break;
+        }
+
+        /* Avancée avant les appels : un minuteur réarmé échu part au tick suivant */
+        w->next++;
+
+        Timer *t;
+        while ((t = w->slot0[index]) != NULL) {
+            wheel_unlink(w, t);
+            w->count--;
+            t->fn(t);
+        }
+
+        /* Plus rien d'armé : inutile de parcourir les ticks restants */
+        if (w->count == 0) {
+            w->next = now + 1;
+            break;
+        }
+    }
+}
+
+/* Ticks jusqu'à la première case non vide du premier niveau, -1 si aucune */
+static int wheel_first(const Wheel *w, unsigned start)
+{
+    /* Mot de start, puis les suivants, puis le début du mot de start */
+    for (unsigned k = 0; k <= WHEEL_SLOTS0 / 64; k++) {
+        unsigned word = (start / 64 + k) % (WHEEL_SLOTS0 / 64);
+        uint64_t bits = w->used0[word];
+
+        if (k == 0)
+            bits &= ~0ull << (start % 64);
+
+        if (bits) {
+            unsigned slot = word * 64 + (unsigned)__builtin_ctzll(bits);
+            return (int)((slot - start) & (WHEEL_SLOTS0 - 1));
+        }
+    }
+    return -1;
+}
+
+/*
+ * Délai jusqu'à la prochaine échéance, pour l'attente de la boucle :
+ * première case non vide du premier niveau, ou plus tôt la prochaine
+ * cascade s'il reste des minuteurs aux niveaux supérieurs.
+ */
+int timers_timeout(void)
+{
+    Wheel *w = &t_wheel;
+
+    if (w->count == 0)
+        return -1;
+
+    unsigned start = (unsigned)(w->next & (WHEEL_SLOTS0 - 1));
+    int      first = wheel_first(w, start);
+    uint64_t ticks = (first >= 0) ? (uint64_t)first : WHEEL_SLOTS0;
+
+    if (w->used[0] | w->used[1] | w->used[2]) {
+        uint64_t cascade = (WHEEL_SLOTS0 - start) & (WHEEL_SLOTS0 - 1);
+        if (cascade < ticks)
+            ticks = cascade;
+    }
+
+    uint64_t when = (w->next + ticks) * TIMER_TICK_MS;
+    uint64_t now  = clock_ms();
+
+    if (when <= now)
+        return 0;
+    if (when - now > INT_MAX)
+        return INT_MAX;
+    return (int)(when - now);
+}
@@ -0,0 +1,791 @@
+/*************************************************************************
+                           Awale -- Game (Server io_uring)
+                             -------------------
+    début                : 18/10/2026
+    auteurs              : Mohammed Iich et Dame Dieng
+    e-mails              : mohammed.iich@insa-lyon.fr et dame.dieng@insa-lyon.fr
+    description          : Backend io_uring de la boucle d'événements,
+                           sans liburing : accept et recv multishot dans
+                           un anneau de tampons fournis, envois d'un tour
+                           soumis ensemble, un io_uring_enter pour
+                           soumettre et attendre
+*************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+
+#include "server.h"
+
+#if SERVER_URING
+
+#include <linux/io_uring.h>
+
+/*
+ * user_data d'une soumission : opération dans les 8 bits bas ; pour une
+ * connexion, son slot (32 bits hauts) et les 24 bits bas de son serial,
+ * pour reconnaître les complétions d'une connexion déjà fermée ; pour un
+ * envoi, sa place dans la série du tour.
+ */
+enum {
+    URING_ACCEPT = 1,
+    URING_WAKE,
+    URING_RECV,
+    URING_POLLOUT,
+    URING_SEND,
+    URING_CANCEL
+};
+
+#define URING_OP(ud)     ((unsigned)((ud) & 0xff))
+#define URING_SERIAL     0xffffffu
+#define URING_BGID       0
+
+/* Attente de 6.1 : recv multishot, tampons fournis, DEFER_TASKRUN */
+#define URING_FLAGS  (IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | \
+                      IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN)
+
+/* Envoi préparé ; msg et iov restent en place jusqu'à sa complétion */
+typedef struct {
+    Client       *c;
+    ssize_t       res;
+    struct msghdr msg;
+    struct iovec  iov[OUTPUT_IOV];
+} UringSend;
+
+/*
+ * Anneau d'un réacteur, partagé avec le noyau par mmap :
+ *  sq_*    : soumissions ; sq_local entrées écrites, sq_pending pas
+ *            encore passées au noyau
+ *  cq_*    : complétions
+ *  br      : anneau des tampons de réception rendus au noyau
+ *  buf_*   : tampons reçus qu'un client n'a pas fini de lire (chaînés
+ *            par buf_next, buf_len octets chacun)
+ *  sends   : envois du tour
+ *  stash   : complétions arrivées pendant l'attente des envois, traitées
+ *            au tour suivant
+ */
+typedef struct {
+    int                       fd;
+    int                       listen_fd;
+    int                       wake_fd;
+
+    unsigned                  sq_entries;
+    unsigned                  sq_mask;
+    _Atomic unsigned         *sq_head;
+    _Atomic unsigned         *sq_tail;
+    struct io_uring_sqe      *sqes;
+    unsigned                  sq_local;
+    unsigned                  sq_pending;
+
+    unsigned                  cq_mask;
+    _Atomic unsigned         *cq_head;
+    _Atomic unsigned         *cq_tail;
+    struct io_uring_cqe      *cqes;
+
+    struct io_uring_buf_ring *br;
+    unsigned                  br_tail;
+    char                     *bufs;
+    int                       buf_next[URING_BUFS];
+    unsigned                  buf_len[URING_BUFS];
+
+    UringSend                *sends;
+    int                       send_count;
+
+    struct io_uring_cqe      *stash;
+    unsigned                  stash_len;
+    unsigned                  stash_cap;
+} Uring;
+
+static _Thread_local Uring *t_ring = NULL;
+
+/* =====================================================
+ *                   Appels système
+ * ===================================================== */
+static int sys_setup(unsigned entries, struct io_uring_params *p)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int sys_register(int fd, unsigned op, void *arg, unsigned n)
+{
+    return (int)syscall(__NR_io_uring_register, fd, op, arg, n);
+}
+
+/*
+ * Passe au noyau les soumissions en attente ; attend wait complétions,
+ * au plus ts s'il est donné (ETIME à l'échéance)
+ */
+static int ring_enter(Uring *u, unsigned wait, unsigned flags,
+                      struct __kernel_timespec *ts)
+{
+    struct io_uring_getevents_arg arg;
+    void  *argp = NULL;
+    size_t argsz = 0;
+
+    if (ts) {
+        memset(&arg, 0, sizeof(arg));
+        arg.ts = (uint64_t)(uintptr_t)ts;
+        argp   = &arg;
+        argsz  = sizeof(arg);
+        flags |= IORING_ENTER_EXT_ARG;
+    }
+
+    atomic_store_explicit(u->sq_tail, u->sq_local, memory_order_release);
+
+    reactor_syscall();
+    int n = (int)syscall(__NR_io_uring_enter, u->fd, u->sq_pending, wait, flags,
+                         argp, argsz);
+    if (n > 0)
+        u->sq_pending -= (unsigned)n;
+    return n;
+}
+
+/* =====================================================
+ *                    Mise en place
+ * ===================================================== */
+
+/* Anneau de tampons fournis, enregistré sous URING_BGID */
+static struct io_uring_buf_ring *ring_buffers(int fd)
+{
+    size_t len = URING_BUFS * sizeof(struct io_uring_buf);
+    void  *map = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr    = (uint64_t)(uintptr_t)map;
+    reg.ring_entries = URING_BUFS;
+    reg.bgid         = URING_BGID;
+
+    if (sys_register(fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        munmap(map, len);
+        return NULL;
+    }
+    return map;
+}
+
+int uring_probe(void)
+{
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    p.flags      = URING_FLAGS;
+    p.cq_entries = 8;
+
+    int fd = sys_setup(8, &p);
+    if (fd < 0)
+        return -1;
+
+    struct io_uring_buf_ring *br = ring_buffers(fd);
+    close(fd);
+    if (!br)
+        return -1;
+
+    munmap(br, URING_BUFS * sizeof(struct io_uring_buf));
+    return 0;
+}
+
+static int ring_map(Uring *u, const struct io_uring_params *p)
+{
+    if (!(p->features & IORING_FEAT_SINGLE_MMAP))
+        return -1;
+
+    size_t sq_len = p->sq_off.array + p->sq_entries * sizeof(unsigned);
+    size_t cq_len = p->cq_off.cqes + p->cq_entries * sizeof(struct io_uring_cqe);
+    size_t len    = (sq_len > cq_len) ? sq_len : cq_len;
+
+    char *ring = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQ_RING);
+    if (ring == MAP_FAILED)
+        return -1;
+
+    void *sqes = mmap(NULL, p->sq_entries * sizeof(struct io_uring_sqe),
+                      PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      u->fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+        return -1;
+
+    u->sq_entries = p->sq_entries;
+    u->sq_mask    = *(unsigned *)(ring + p->sq_off.ring_mask);
+    u->sq_head    = (_Atomic unsigned *)(ring + p->sq_off.head);
+    u->sq_tail    = (_Atomic unsigned *)(ring + p->sq_off.tail);
+    u->sqes       = sqes;
+    u->sq_local   = atomic_load_explicit(u->sq_tail, memory_order_relaxed);
+
+    /* Entrée k du tableau → soumission k, une fois pour toutes */
+    unsigned *array = (unsigned *)(ring + p->sq_off.array);
+    for (unsigned k = 0; k < p->sq_entries; k++)
+        array[k] = k;
+
+    u->cq_mask = *(unsigned *)(ring + p->cq_off.ring_mask);
+    u->cq_head = (_Atomic unsigned *)(ring + p->cq_off.head);
+    u->cq_tail = (_Atomic unsigned *)(ring + p->cq_off.tail);
+    u->cqes    = (struct io_uring_cqe *)(ring + p->cq_off.cqes);
+    return 0;
+}
+
+/* Soumission libre ; l'anneau plein est d'abord passé au noyau */
+static struct io_uring_sqe *sqe_get(Uring *u)
+{
+    unsigned head = atomic_load_explicit(u->sq_head, memory_order_acquire);
+
+    if (u->sq_local - head >= u->sq_entries) {
+        ring_enter(u, 0, 0, NULL);
+        head = atomic_load_explicit(u->sq_head, memory_order_acquire);
+        if (u->sq_local - head >= u->sq_entries)
+            return NULL;
+    }
+
+    struct io_uring_sqe *sqe = &u->sqes[u->sq_local & u->sq_mask];
+    memset(sqe, 0, sizeof(*sqe));
+    u->sq_local++;
+    u->sq_pending++;
+    return sqe;
+}
+
+/* Tampon rendu au noyau */
+static void buf_recycle(Uring *u, int bid)
+{
+    struct io_uring_buf *b = &u->br->bufs[u->br_tail & (URING_BUFS - 1)];
+
+    b->addr = (uint64_t)(uintptr_t)(u->bufs + (size_t)bid * URING_BUF_SIZE);
+    b->len  = URING_BUF_SIZE;
+    b->bid  = (uint16_t)bid;
+
+    u->br_tail++;
+    atomic_store_explicit((_Atomic uint16_t *)&u->br->tail, (uint16_t)u->br_tail,
+                          memory_order_release);
+}
+
+static void arm_accept(Uring *u)
+{
+    struct io_uring_sqe *sqe = sqe_get(u);
+    if (!sqe)
+        return;
+
+    sqe->opcode       = IORING_OP_ACCEPT;
+    sqe->fd           = u->listen_fd;
+    sqe->ioprio       = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_CLOEXEC | SOCK_NONBLOCK;
+    sqe->user_data    = URING_ACCEPT;
+}
+
+static void arm_wake(Uring *u)
+{
+    struct io_uring_sqe *sqe = sqe_get(u);
+    if (!sqe)
+        return;
+
+    sqe->opcode       = IORING_OP_POLL_ADD;
+    sqe->fd           = u->wake_fd;
+    sqe->len          = IORING_POLL_ADD_MULTI;
+    sqe->poll32_events = POLLIN;
+    sqe->user_data    = URING_WAKE;
+}
+
+int uring_init(int listen_fd, int wake_fd)
+{
+    Uring *u = calloc(1, sizeof(*u));
+    if (!u)
+        return -1;
+
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    p.flags      = URING_FLAGS;
+    p.cq_entries = URING_ENTRIES * 4;
+
+    u->fd        = sys_setup(URING_ENTRIES, &p);
+    u->listen_fd = listen_fd;
+    u->wake_fd   = wake_fd;
+    if (u->fd < 0 || ring_map(u, &p) < 0)
+        return -1;
+
+    u->br    = ring_buffers(u->fd);
+    u->bufs  = malloc((size_t)URING_BUFS * URING_BUF_SIZE);
+    u->sends = malloc(URING_SENDS * sizeof(UringSend));
+    if (!u->br || !u->bufs || !u->sends)
+        return -1;
+
+    for (int bid = 0; bid < URING_BUFS; bid++)
+        buf_recycle(u, bid);
+
+    t_ring = u;
+
+    arm_accept(u);
+    if (wake_fd >= 0)
+        arm_wake(u);
+    return 0;
+}
+
+/* =====================================================
+ *                      Connexions
+ * ===================================================== */
+static uint64_t client_ud(const Client *c, unsigned op)
+{
+    uint32_t serial = atomic_load_explicit(&c->serial, memory_order_relaxed);
+
+    return ((uint64_t)(c - g_clients) << 32) |
+           ((uint64_t)(serial & URING_SERIAL) << 8) | op;
+}
+
+/*
+ * Client d'une complétion, NULL si sa connexion est perdue ou fermée.
+ * Le slot n'est rendu (serial changé) que par ce réacteur : tant que le
+ * serial correspond, le slot n'a pas pu être repris par un autre.
+ */
+static Client *cqe_client(uint64_t ud)
+{
+    Client  *c      = &g_clients[ud >> 32];
+    uint32_t serial = atomic_load_explicit(&c->serial, memory_order_relaxed);
+
+    if ((serial & URING_SERIAL) != ((ud >> 8) & URING_SERIAL) || c->fd < 0 || c->lost)
+        return NULL;
+    return c;
+}
+
+static void rx_arm(Uring *u, Client *c)
+{
+    struct io_uring_sqe *sqe = sqe_get(u);
+    if (!sqe)
+        return;
+
+    sqe->opcode    = IORING_OP_RECV;
+    sqe->fd        = c->fd;
+    sqe->ioprio    = IORING_RECV_MULTISHOT;
+    sqe->flags     = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = URING_BGID;
+    sqe->user_data = client_ud(c, URING_RECV);
+
+    c->rx_armed  = 1;
+    c->rx_cancel = 0;
+}
+
+int uring_add(Client *c)
+{
+    c->rx_head   = -1;
+    c->rx_tail   = -1;
+    c->rx_off    = 0;
+    c->rx_held   = 0;
+    c->rx_armed  = 0;
+    c->rx_cancel = 0;
+    c->rx_eof    = 0;
+    c->rx_err    = 0;
+    c->tx_poll   = 0;
+
+    rx_arm(t_ring, c);
+    return c->rx_armed ? 0 : -1;
+}
+
+/*
+ * Réception et attente de POLLOUT annulées avant que la socket soit
+ * fermée (la requête en cours tient la socket ouverte) ; soumis tout de
+ * suite, tant que le descripteur désigne encore cette socket.
+ */
+void uring_del(Client *c)
+{
+    Uring *u = t_ring;
+
+    if (c->rx_armed || c->tx_poll) {
+        struct io_uring_sqe *sqe = sqe_get(u);
+        if (sqe) {
+            sqe->opcode       = IORING_OP_ASYNC_CANCEL;
+            sqe->fd           = c->fd;
+            sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+            sqe->user_data    = URING_CANCEL;
+            ring_enter(u, 0, 0, NULL);
+        }
+    }
+
+    while (c->rx_head >= 0) {
+        int bid = c->rx_head;
+        c->rx_head = u->buf_next[bid];
+        buf_recycle(u, bid);
+    }
+
+    c->rx_tail   = -1;
+    c->rx_off    = 0;
+    c->rx_held   = 0;
+    c->rx_armed  = 0;
+    c->rx_cancel = 0;
+    c->tx_poll   = 0;
+}
+
+void uring_update(Client *c)
+{
+    if (!c->out_stalled || c->tx_poll || c->fd < 0 || c->lost)
+        return;
+
+    struct io_uring_sqe *sqe = sqe_get(t_ring);
+    if (!sqe)
+        return;
+
+    sqe->opcode        = IORING_OP_POLL_ADD;
+    sqe->fd            = c->fd;
+    sqe->poll32_events = POLLOUT;
+    sqe->user_data     = client_ud(c, URING_POLLOUT);
+    c->tx_poll = 1;
+}
+
+/* =====================================================
+ *                      Réception
+ * ===================================================== */
+ssize_t uring_recv(Client *c, const struct iovec *iov, int cnt)
+{
+    Uring *u     = t_ring;
+    size_t total = 0;
+
+    for (int k = 0; k < cnt; k++) {
+        char  *dst  = iov[k].iov_base;
+        size_t room = iov[k].iov_len;
+
+        while (room > 0 && c->rx_head >= 0) {
+            int      bid = c->rx_head;
+            unsigned n   = u->buf_len[bid] - c->rx_off;
+            if (n > room)
+                n = (unsigned)room;
+
+            memcpy(dst, u->bufs + (size_t)bid * URING_BUF_SIZE + c->rx_off, n);
+            dst       += n;
+            room      -= n;
+            total     += n;
+            c->rx_off += n;
+
+            /* Tampon lu jusqu'au bout : rendu au noyau */
+            if (c->rx_off == u->buf_len[bid]) {
+                c->rx_head = u->buf_next[bid];
+                c->rx_off  = 0;
+                c->rx_held--;
+                if (c->rx_head < 0)
+                    c->rx_tail = -1;
+                buf_recycle(u, bid);
+            }
+        }
+    }
+
+    if (total > 0)
+        return (ssize_t)total;
+
+    if (c->rx_eof) {
+        if (!c->rx_err)
+            return 0;
+        errno = c->rx_err;
+        return -1;
+    }
+
+    /* Tout est lu : la réception reprend si elle s'était arrêtée */
+    if (!c->rx_armed)
+        rx_arm(u, c);
+
+    errno = EAGAIN;
+    return -1;
+}
+
+static void rx_complete(Uring *u, const struct io_uring_cqe *cqe)
+{
+    Client *c   = cqe_client(cqe->user_data);
+    int     bid = (cqe->flags & IORING_CQE_F_BUFFER)
+                ? (int)(cqe->flags >> IORING_CQE_BUFFER_SHIFT) : -1;
+
+    if (!c) {
+        if (bid >= 0)
+            buf_recycle(u, bid);
+        return;
+    }
+
+    if (!(cqe->flags & IORING_CQE_F_MORE)) {
+        c->rx_armed  = 0;
+        c->rx_cancel = 0;
+    }
+
+    if (cqe->res > 0 && bid >= 0) {
+        u->buf_len[bid]  = (unsigned)cqe->res;
+        u->buf_next[bid] = -1;
+        if (c->rx_tail >= 0)
+            u->buf_next[c->rx_tail] = bid;
+        else
+            c->rx_head = bid;
+        c->rx_tail = bid;
+        c->rx_held++;
+    } else {
+        if (bid >= 0)
+            buf_recycle(u, bid);
+
+        /* Plus de tampons libres, ou arrêt demandé : relancée à la lecture */
+        if (cqe->res == 0) {
+            c->rx_eof = 1;
+        } else if (cqe->res != -ENOBUFS && cqe->res != -ECANCELED) {
+            c->rx_eof = 1;
+            c->rx_err = -cqe->res;
+        }
+    }
+
+    server_handle_client_message(c);
+
+    /*
+     * Un client qui ne lit plus (commandes suspendues) garderait tous
+     * les tampons : sa réception s'arrête, les octets suivants attendent
+     * dans la socket comme avec epoll.
+     */
+    if (c->fd >= 0 && !c->lost && c->rx_armed && !c->rx_cancel &&
+        c->rx_held >= URING_HELD_MAX) {
+        struct io_uring_sqe *sqe = sqe_get(u);
+        if (sqe) {
+            sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+            sqe->addr      = client_ud(c, URING_RECV);
+            sqe->user_data = URING_CANCEL;
+            c->rx_cancel   = 1;
+        }
+    }
+}
+
+/* =====================================================
+ *                     Complétions
+ * ===================================================== */
+static void cqe_dispatch(Uring *u, const struct io_uring_cqe *cqe)
+{
+    switch (URING_OP(cqe->user_data)) {
+        case URING_ACCEPT:
+            if (cqe->res >= 0)
+                server_add_connection(cqe->res);
+            if (!(cqe->flags & IORING_CQE_F_MORE))
+                arm_accept(u);
+            break;
+
+        case URING_WAKE:
+            reactor_drain();
+            if (!(cqe->flags & IORING_CQE_F_MORE))
+                arm_wake(u);
+            break;
+
+        case URING_RECV:
+            rx_complete(u, cqe);
+            break;
+
+        case URING_POLLOUT: {
+            Client *c = cqe_client(cqe->user_data);
+            if (c) {
+                c->tx_poll = 0;
+                output_writable(c);
+            }
+            break;
+        }
+    }
+}
+
+static void stash_push(Uring *u, const struct io_uring_cqe *cqe)
+{
+    if (u->stash_len == u->stash_cap) {
+        unsigned cap = u->stash_cap ? u->stash_cap * 2 : 64;
+        struct io_uring_cqe *grown = realloc(u->stash, cap * sizeof(*grown));
+        if (!grown) {
+            perror("io_uring stash");
+            return;
+        }
+        u->stash     = grown;
+        u->stash_cap = cap;
+    }
+    u->stash[u->stash_len++] = *cqe;
+}
+
+/*
+ * Vide la file des complétions. Pendant les envois (sending), seules
+ * leurs complétions sont traitées, les autres mises de côté. Retourne
+ * le nombre d'envois terminés.
+ */
+static int ring_reap(Uring *u, int sending)
+{
+    unsigned head = atomic_load_explicit(u->cq_head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(u->cq_tail, memory_order_acquire);
+    int      sent = 0;
+
+    while (head != tail) {
+        struct io_uring_cqe cqe = u->cqes[head & u->cq_mask];
+
+        head++;
+        atomic_store_explicit(u->cq_head, head, memory_order_release);
+
+        if (URING_OP(cqe.user_data) == URING_SEND) {
+            u->sends[cqe.user_data >> 32].res = cqe.res;
+            sent++;
+        } else if (sending) {
+            stash_push(u, &cqe);
+        } else {
+            cqe_dispatch(u, &cqe);
+        }
+
+        /* Une complétion traitée peut en avoir produit d'autres */
+        if (head == tail)
+            tail = atomic_load_explicit(u->cq_tail, memory_order_acquire);
+    }
+    return sent;
+}
+
+int uring_wait(int timeout)
+{
+    Uring *u = t_ring;
+
+    /* Des complétions attendent déjà (mises de côté) : on ne fait que sonder */
+    if (u->stash_len > 0)
+        timeout = 0;
+
+    struct __kernel_timespec ts = { timeout / 1000, (timeout % 1000) * 1000000 };
+
+    if (ring_enter(u, timeout ? 1 : 0, IORING_ENTER_GETEVENTS,
+                   timeout > 0 ? &ts : NULL) < 0 &&
+        errno != EINTR && errno != EAGAIN && errno != EBUSY && errno != ETIME)
+        return -1;
+
+    timers_run();
+
+    /* Complétions mises de côté au tour précédent : les plus anciennes */
+    if (u->stash_len > 0) {
+        unsigned n = u->stash_len;
+        u->stash_len = 0;
+        for (unsigned k = 0; k < n; k++)
+            cqe_dispatch(u, &u->stash[k]);
+    }
+
+    ring_reap(u, 0);
+    return 0;
+}
+
+/* =====================================================
+ *                        Envois
+ * ===================================================== */
+int uring_send(Client *c, const struct iovec *iov, int cnt)
+{
+    Uring *u = t_ring;
+
+    if (u->send_count == URING_SENDS)
+        return -1;
+
+    struct io_uring_sqe *sqe = sqe_get(u);
+    if (!sqe)
+        return -1;
+
+    UringSend *s = &u->sends[u->send_count];
+    s->c   = c;
+    s->res = 0;
+    memcpy(s->iov, iov, (size_t)cnt * sizeof(struct iovec));
+    memset(&s->msg, 0, sizeof(s->msg));
+    s->msg.msg_iov    = s->iov;
+    s->msg.msg_iovlen = (size_t)cnt;
+
+    /* MSG_DONTWAIT : socket pleine → -EAGAIN tout de suite, comme writev */
+    sqe->opcode    = IORING_OP_SENDMSG;
+    sqe->fd        = c->fd;
+    sqe->addr      = (uint64_t)(uintptr_t)&s->msg;
+    sqe->len       = 1;
+    sqe->msg_flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+    sqe->user_data = ((uint64_t)u->send_count << 32) | URING_SEND;
+
+    u->send_count++;
+    return 0;
+}
+
+/*
+ * Un seul appel soumet tous les envois ; ils se terminent pendant cet
+ * appel (MSG_DONTWAIT). Les résultats sont appliqués une fois tous
+ * connus, dans l'ordre, et les clients perdus retirés ensuite : rien ne
+ * touche une file tant qu'un envoi la lit encore.
+ */
+void uring_send_flush(void)
+{
+    Uring *u     = t_ring;
+    int    count = u->send_count;
+
+    if (count == 0)
+        return;
+
+    int done = 0;
+    for (int pass = 0; done < count; pass++) {
+        if (ring_enter(u, pass ? 1 : 0, IORING_ENTER_GETEVENTS, NULL) < 0 &&
+            errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            perror("io_uring_enter");
+            break;
+        }
+        done += ring_reap(u, 1);
+    }
+
+    u->send_count = 0;
+
+    for (int k = 0; k < count; k++)
+        if (output_sent(u->sends[k].c, u->sends[k].res) < 0)
+            u->sends[k].c->closing = 1;
+
+    for (int k = 0; k < count; k++)
+        if (u->sends[k].c->closing)
+            reactor_lost(u->sends[k].c);
+}
+
+#else  /* !SERVER_URING */
+
+/* Compilé sans io_uring : uring_probe échoue et le serveur prend epoll */
+
+int uring_probe(void)
+{
+    return -1;
+}
+
+int uring_init(int listen_fd, int wake_fd)
+{
+    (void)listen_fd;
+    (void)wake_fd;
+    errno = ENOSYS;
+    return -1;
+}
+
+int uring_add(Client *c)
+{
+    (void)c;
+    return -1;
+}
+
+void uring_del(Client *c)
+{
+    (void)c;
+}
+
+void uring_update(Client *c)
+{
+    (void)c;
+}
+
+int uring_wait(int timeout)
+{
+    (void)timeout;
+    errno = ENOSYS;
+    return -1;
+}
+
+ssize_t uring_recv(Client *c, const struct iovec *iov, int cnt)
+{
+    (void)c;
+    (void)iov;
+    (void)cnt;
+    errno = ENOSYS;
+    return -1;
+}
+
+int uring_send(Client *c, const struct iovec *iov, int cnt)
+{
+    (void)c;
+    (void)iov;
+    (void)cnt;
+    return -1;
+}
+
+void uring_send_flush(void)
+{
+}
+
+#endif /* SERVER_URING */
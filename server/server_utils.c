@@ -60,39 +60,45 @@ size_t strlcpy_safe(char *dst, const char *src, size_t dstsz) {
 }
 
 /* ================================================================
- *  Broadcast un message à tous les clients
+ *  Envoi vers un client (file de sortie, jamais bloquant)
  * ================================================================ */
-void server_broadcast(const char *msg, int except_fd)
+void server_send(int fd, const char *msg, size_t len)
 {
-    size_t len = strlen(msg);
+    int ci = client_index_by_fd(fd);
+    if (ci >= 0)
+        reactor_send(reactor_ref(&g_clients[ci]), msg, len, 0);
+}
 
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (g_clients[i].fd != -1 &&
-            g_clients[i].logged_in &&
-            g_clients[i].fd != except_fd)
-        {
-            send(g_clients[i].fd, msg, len, 0);
-        }
-    }
+void server_send_lossy(int fd, const char *msg, size_t len)
+{
+    int ci = client_index_by_fd(fd);
+    if (ci >= 0)
+        reactor_send(reactor_ref(&g_clients[ci]), msg, len, SEND_LOSSY);
 }
 
 /* ================================================================
- *  Rechercher un client par son pseudo
+ *  Broadcast un message à tous les clients
  * ================================================================ */
-int client_index_by_name(const char *name)
+void server_broadcast(const char *msg, int except_fd)
 {
-    if (!name || !*name)
-        return -1;
+    int cap = atomic_load_explicit(&g_client_cap, memory_order_acquire);
 
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (g_clients[i].fd != -1 &&
-            g_clients[i].logged_in &&
-            ci_equal(g_clients[i].name, name))
+    /*
+     * Le message est écrit une fois par forme ; chaque réacteur reçoit
+     * un lot de pointeurs, un par client connecté.
+     */
+    Fanout out;
+    fanout_init(&out, msg, strlen(msg), NULL, 0);
+
+    for (int i = 0; i < cap; i++) {
+        if (g_clients[i].logged_in &&
+            g_clients[i].fd != except_fd)
         {
-            return i;
+            fanout_send(&out, reactor_ref(&g_clients[i]), 0);
         }
     }
-    return -1;
+
+    fanout_done(&out);
 }
 
 /* ================================================================
@@ -100,19 +106,7 @@ int client_index_by_name(const char *name)
  * ================================================================ */
 int username_logged_in(const char *username)
 {
-    if (!username || !*username)
-        return 0;
-
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-
-        if (g_clients[i].fd != -1 &&
-            g_clients[i].logged_in &&
-            ci_equal(g_clients[i].name, username))
-        {
-            return 1;
-        }
-    }
-    return 0;
+    return client_index_by_name(username) >= 0;
 }
 
 /* ================================================================